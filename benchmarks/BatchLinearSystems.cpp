@@ -0,0 +1,78 @@
+#include "benchmark/benchmark.h"
+#include "BenchmarkSupport.h"
+#include "3dmath/BatchLinearSystems.h"
+#include "3dmath/LinearSystem.h"
+#include <memory>
+#include <vector>
+using namespace math3d;
+using namespace math3d::benchmarks;
+
+namespace {
+    // Diagonally dominant systems, as in the other linear system benchmarks
+    template<unsigned N>
+    std::vector<Matrix<float, N, N>> randomMatrices(size_t const count, std::mt19937& generator) {
+        std::vector<Matrix<float, N, N>> matrices;
+        matrices.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            matrices.push_back(BenchmarkSupport::randomInvertibleMatrix<float, N>(generator));
+        }
+        return matrices;
+    }
+
+    // The argument is the number of systems
+    template<unsigned N>
+    void solveLinearSystemsOneByOne(benchmark::State& state) {
+        std::mt19937 generator(1);
+        auto const count = static_cast<size_t>(state.range(0));
+        auto const matrices = randomMatrices<N>(count, generator);
+        auto const rightHandSide = BenchmarkSupport::randomVector<float, N>(generator);
+        for (auto _ : state) {
+            for (auto const& matrix : matrices) {
+                benchmark::DoNotOptimize(LinearSystem<float, N>::solveLinearSystem(matrix, rightHandSide));
+            }
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+    }
+
+    // Arguments are the number of systems and the execution policy
+    template<unsigned N, unsigned lanes>
+    void solveLinearSystemsInBatch(benchmark::State& state) {
+        std::mt19937 generator(1);
+        auto const count = static_cast<size_t>(state.range(0));
+        auto const execution = static_cast<Execution>(state.range(1));
+        auto const matrices = randomMatrices<N>(count, generator);
+        auto const rightHandSide = BenchmarkSupport::randomVector<float, N>(generator);
+
+        std::vector<std::vector<float>> coefficients(N * N, std::vector<float>(count));
+        std::vector<std::vector<float>> rightHandSides(N, std::vector<float>(count, 0));
+        std::vector<std::vector<float>> solutions(N, std::vector<float>(count));
+        auto const singular = std::make_unique<bool[]>(count);
+        LinearSystemSpans<float const, N> systems;
+        std::array<std::span<float>, N> solutionSpans;
+        for (unsigned i = 0; i < N * N; ++i) {
+            for (size_t system = 0; system < count; ++system) {
+                coefficients[i][system] = matrices[system].getData()[i];
+            }
+            systems.coefficients[i] = coefficients[i];
+        }
+        for (unsigned row = 0; row < N; ++row) {
+            std::fill(rightHandSides[row].begin(), rightHandSides[row].end(), rightHandSide[row]);
+            systems.rightHandSides[row] = rightHandSides[row];
+            solutionSpans[row] = solutions[row];
+        }
+
+        for (auto _ : state) {
+            batch::solveLinearSystems<N, lanes>(systems, solutionSpans, {singular.get(), count}, execution);
+            benchmark::DoNotOptimize(solutions);
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+    }
+}
+
+BENCHMARK(solveLinearSystemsOneByOne<3>)->Arg(100'000);
+BENCHMARK(solveLinearSystemsOneByOne<4>)->Arg(100'000);
+BENCHMARK(solveLinearSystemsInBatch<3, 4>)->Args({100'000, static_cast<int>(Execution::Sequential)});
+BENCHMARK(solveLinearSystemsInBatch<3, 8>)->Args({100'000, static_cast<int>(Execution::Sequential)});
+BENCHMARK(solveLinearSystemsInBatch<3, 16>)->Args({100'000, static_cast<int>(Execution::Sequential)});
+BENCHMARK(solveLinearSystemsInBatch<4, 8>)->Args({100'000, static_cast<int>(Execution::Sequential)});
+BENCHMARK(solveLinearSystemsInBatch<4, 8>)->Args({100'000, static_cast<int>(Execution::Parallel)})->UseRealTime();
@@ -0,0 +1,30 @@
+#pragma once
+#include "3dmath/Matrix.h"
+#include "3dmath/Vector.h"
+#include "../tests/TestSupport.h"
+#include <random>
+
+namespace math3d::benchmarks {
+
+    // Inputs are generated from a fixed seed so that every run, and the stored baseline, measure the same work. Values
+    // come from the same helpers as the tests' random inputs
+    class BenchmarkSupport {
+    public:
+        template<typename T, unsigned size>
+        static Vector<T, size> randomVector(std::mt19937& generator) {
+            return test::TestSupport::randomVector<T, size>(generator);
+        }
+
+        // Random matrices are invertible with overwhelming probability. The diagonal is made dominant to remove any
+        // doubt, which also keeps elimination based algorithms from pivoting differently from run to run
+        template<typename T, unsigned size>
+        static Matrix<T, size, size> randomInvertibleMatrix(std::mt19937& generator) {
+            auto matrix = test::TestSupport::randomMatrix<T, size>(generator);
+            for (unsigned i = 0; i < size; ++i) {
+                matrix(i, i) += static_cast<T>(10 * size);
+            }
+            return matrix;
+        }
+    };
+
+}
@@ -0,0 +1,56 @@
+#include "benchmark/benchmark.h"
+#include "3dmath/BoundingVolumeHierarchy.h"
+#include "3dmath/primitives/Sphere.h"
+#include <random>
+using namespace math3d;
+
+namespace {
+    // A tessellated sphere with about 2 * resolution^2 triangles
+    Sphere makeSphere(unsigned const resolution) {
+        Sphere sphere({0, 0, 0}, 10, resolution);
+        sphere.generateGeometry();
+        return sphere;
+    }
+
+    // Arguments are the sphere resolution and the execution policy
+    void buildHierarchy(benchmark::State& state) {
+        auto sphere = makeSphere(static_cast<unsigned>(state.range(0)));
+        auto const execution = static_cast<Execution>(state.range(1));
+        for (auto _ : state) {
+            BoundingVolumeHierarchy hierarchy(sphere.getVertices(), sphere.getTris(), execution);
+            benchmark::DoNotOptimize(hierarchy.getNumberOfNodes());
+        }
+        state.counters["triangles"] = static_cast<double>(sphere.getTris().size());
+    }
+
+    // Rays from random points inside the sphere in random directions, so every ray hits
+    template<bool closest>
+    void traceRays(benchmark::State& state) {
+        auto sphere = makeSphere(static_cast<unsigned>(state.range(0)));
+        BoundingVolumeHierarchy const hierarchy(sphere.getVertices(), sphere.getTris());
+        std::mt19937 generator(1);
+        std::uniform_real_distribution<float> coordinate(-1, 1);
+        std::vector<std::pair<Vector3<float>, Vector3<float>>> rays(1024);
+        for (auto& [origin, direction] : rays) {
+            origin = {5 * coordinate(generator), 5 * coordinate(generator), 5 * coordinate(generator)};
+            direction = {coordinate(generator), coordinate(generator), coordinate(generator)};
+            direction.normalize();
+        }
+        for (auto _ : state) {
+            for (auto const& [origin, direction] : rays) {
+                benchmark::DoNotOptimize(closest ? hierarchy.closestHit(origin, direction) :
+                                                   hierarchy.anyHit(origin, direction));
+            }
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * rays.size()));
+    }
+}
+
+BENCHMARK(buildHierarchy)
+    ->Args({64, static_cast<int64_t>(Execution::Sequential)})
+    ->Args({1024, static_cast<int64_t>(Execution::Sequential)})
+    ->Args({1024, static_cast<int64_t>(Execution::Parallel)})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(traceRays<true>)->Arg(64)->Arg(1024);
+BENCHMARK(traceRays<false>)->Arg(64)->Arg(1024);
@@ -0,0 +1,32 @@
+#include "benchmark/benchmark.h"
+#include "BenchmarkSupport.h"
+#include "3dmath/BoundsKernels.h"
+#include <vector>
+using namespace math3d;
+using namespace math3d::benchmarks;
+
+namespace {
+    // Arguments are the number of points and the execution policy
+    template<typename T>
+    void boundsFromPoints(benchmark::State& state) {
+        auto const execution = static_cast<Execution>(state.range(1));
+        std::mt19937 generator(1);
+        std::vector<Vector3<T>> points(state.range(0));
+        for (auto& point : points) {
+            point = BenchmarkSupport::randomVector<T, 3>(generator);
+        }
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(Bounds3D<T>::fromPoints(points, execution));
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * points.size()));
+    }
+}
+
+BENCHMARK(boundsFromPoints<float>)
+    ->Args({1 << 10, static_cast<int64_t>(Execution::Sequential)})
+    ->Args({1 << 20, static_cast<int64_t>(Execution::Sequential)})
+    ->Args({1 << 20, static_cast<int64_t>(Execution::Parallel)})
+    ->UseRealTime();
+BENCHMARK(boundsFromPoints<double>)
+    ->Args({1 << 10, static_cast<int64_t>(Execution::Sequential)})
+    ->Args({1 << 20, static_cast<int64_t>(Execution::Sequential)});
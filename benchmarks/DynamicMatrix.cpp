@@ -0,0 +1,63 @@
+#include "benchmark/benchmark.h"
+#include "3dmath/DynamicMatrix.h"
+#include <random>
+using namespace math3d;
+
+namespace {
+    template<typename T>
+    DynamicMatrix<T> randomMatrix(unsigned const size, std::mt19937& generator) {
+        std::uniform_real_distribution<T> distribution(-10, 10);
+        DynamicMatrix<T> matrix(size, size);
+        for (unsigned col = 0; col < size; ++col) {
+            for (auto& element : matrix.getColumn(col)) {
+                element = distribution(generator);
+            }
+        }
+        return matrix;
+    }
+
+    // Each column of the product is a linear combination of the columns of a, like fixed-size matrix products. This
+    // is the reference the blocked product is measured against
+    template<typename T>
+    void columnCombinationMultiply(benchmark::State& state) {
+        std::mt19937 generator(1);
+        auto const size = static_cast<unsigned>(state.range(0));
+        auto const a = randomMatrix<T>(size, generator);
+        auto const b = randomMatrix<T>(size, generator);
+        for (auto _ : state) {
+            DynamicMatrix<T> result(size, size);
+            for (unsigned col = 0; col < size; ++col) {
+                auto const resultColumn = result.getColumn(col);
+                for (unsigned k = 0; k < size; ++k) {
+                    auto const column = a.getColumn(k);
+                    T const scale = b(k, col);
+                    for (unsigned row = 0; row < size; ++row) {
+                        resultColumn[row] += column[row] * scale;
+                    }
+                }
+            }
+            benchmark::DoNotOptimize(result);
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * size * size * size);
+    }
+
+    // Arguments are the matrix size and the execution policy. Items are multiply-adds
+    template<typename T>
+    void dynamicMatrixMultiply(benchmark::State& state) {
+        std::mt19937 generator(1);
+        auto const size = static_cast<unsigned>(state.range(0));
+        auto const execution = static_cast<Execution>(state.range(1));
+        auto const a = randomMatrix<T>(size, generator);
+        auto const b = randomMatrix<T>(size, generator);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(a.multiply(b, execution));
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * size * size * size);
+    }
+}
+
+BENCHMARK(columnCombinationMultiply<float>)->Arg(512);
+BENCHMARK(columnCombinationMultiply<double>)->Arg(512);
+BENCHMARK(dynamicMatrixMultiply<float>)->Args({512, static_cast<int>(Execution::Sequential)});
+BENCHMARK(dynamicMatrixMultiply<double>)->Args({512, static_cast<int>(Execution::Sequential)});
+BENCHMARK(dynamicMatrixMultiply<double>)->Args({1024, static_cast<int>(Execution::Parallel)})->UseRealTime();
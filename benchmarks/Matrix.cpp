@@ -0,0 +1,186 @@
+#include "benchmark/benchmark.h"
+#include "BenchmarkSupport.h"
+#include "3dmath/Matrix.h"
+#include "3dmath/MatrixOperations.h"
+#include "3dmath/LinearSystem.h"
+#include "3dmath/LUDecomposition.h"
+#include "3dmath/CholeskyDecomposition.h"
+#include "3dmath/QRDecomposition.h"
+#include "3dmath/SingularValueDecomposition.h"
+#include "3dmath/MatrixUtil.h"
+#include <filesystem>
+#include <fstream>
+using namespace math3d;
+using namespace math3d::benchmarks;
+
+namespace {
+    template<typename T, unsigned size>
+    void matrixMultiply(benchmark::State& state) {
+        std::mt19937 generator(1);
+        auto a = BenchmarkSupport::randomInvertibleMatrix<T, size>(generator);
+        auto b = BenchmarkSupport::randomInvertibleMatrix<T, size>(generator);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(a);
+            benchmark::DoNotOptimize(a * b);
+        }
+    }
+
+    template<typename T, unsigned size>
+    void matrixVectorMultiply(benchmark::State& state) {
+        std::mt19937 generator(1);
+        auto a = BenchmarkSupport::randomInvertibleMatrix<T, size>(generator);
+        auto v = BenchmarkSupport::randomVector<T, size>(generator);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(a);
+            benchmark::DoNotOptimize(a * v);
+        }
+    }
+
+    template<typename T, unsigned size>
+    void matrixInverse(benchmark::State& state) {
+        std::mt19937 generator(1);
+        auto a = BenchmarkSupport::randomInvertibleMatrix<T, size>(generator);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(a);
+            benchmark::DoNotOptimize(a.inverse());
+        }
+    }
+
+    template<typename T, unsigned size>
+    void matrixDeterminant(benchmark::State& state) {
+        std::mt19937 generator(1);
+        auto a = BenchmarkSupport::randomInvertibleMatrix<T, size>(generator);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(a);
+            benchmark::DoNotOptimize(a.determinant());
+        }
+    }
+
+    template<typename T, unsigned size>
+    void solveLinearSystem(benchmark::State& state) {
+        std::mt19937 generator(1);
+        auto a = BenchmarkSupport::randomInvertibleMatrix<T, size>(generator);
+        auto b = BenchmarkSupport::randomVector<T, size>(generator);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(a);
+            benchmark::DoNotOptimize(LinearSystem<T, size>::solveLinearSystem(a, b));
+        }
+    }
+
+    template<typename T, unsigned size>
+    void factorLU(benchmark::State& state) {
+        std::mt19937 generator(1);
+        auto a = BenchmarkSupport::randomInvertibleMatrix<T, size>(generator);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(a);
+            benchmark::DoNotOptimize(LUDecomposition<T, size>(a));
+        }
+    }
+
+    // Solve with a matrix that was factored once, as when solving for many right-hand sides
+    template<typename T, unsigned size>
+    void solveWithLUDecomposition(benchmark::State& state) {
+        std::mt19937 generator(1);
+        LUDecomposition<T, size> const lu(BenchmarkSupport::randomInvertibleMatrix<T, size>(generator));
+        auto b = BenchmarkSupport::randomVector<T, size>(generator);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(b);
+            benchmark::DoNotOptimize(lu.solve(b));
+        }
+    }
+
+    // A + A^T of a diagonally dominant matrix is symmetric positive definite
+    template<typename T, unsigned size>
+    void factorCholesky(benchmark::State& state) {
+        std::mt19937 generator(1);
+        auto const random = BenchmarkSupport::randomInvertibleMatrix<T, size>(generator);
+        Matrix<T, size, size> a = random + random.transpose();
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(a);
+            benchmark::DoNotOptimize(CholeskyDecomposition<T, size>(a));
+        }
+    }
+
+    template<typename T, unsigned numRows, unsigned numCols>
+    void factorQR(benchmark::State& state) {
+        std::mt19937 generator(1);
+        auto const square = BenchmarkSupport::randomInvertibleMatrix<T, numRows>(generator);
+        Matrix<T, numRows, numCols> a;
+        for (unsigned row = 0; row < numRows; ++row) {
+            for (unsigned col = 0; col < numCols; ++col) {
+                a(row, col) = square(row, col);
+            }
+        }
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(a);
+            benchmark::DoNotOptimize(QRDecomposition<T, numRows, numCols>(a));
+        }
+    }
+
+    template<typename T, unsigned size>
+    void singularValueDecomposition(benchmark::State& state) {
+        std::mt19937 generator(1);
+        auto a = BenchmarkSupport::randomInvertibleMatrix<T, size>(generator);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(a);
+            benchmark::DoNotOptimize(SingularValueDecomposition<T, size, size>(a));
+        }
+    }
+
+    // The argument is the number of matrices in the file
+    template<typename T, unsigned size>
+    void readMatricesFromFile(benchmark::State& state) {
+        std::mt19937 generator(1);
+        auto const file = std::filesystem::temp_directory_path() / "3dmathMatrixBenchmark.csv";
+        {
+            std::ofstream ofs(file);
+            ofs.precision(9);
+            for (int64_t i = 0; i < state.range(0); ++i) {
+                auto const a = BenchmarkSupport::randomInvertibleMatrix<T, size>(generator);
+                for (unsigned row = 0; row < size; ++row) {
+                    for (unsigned col = 0; col < size; ++col) {
+                        ofs << (col == 0 ? "" : ",") << a(row, col);
+                    }
+                    ofs << '\n';
+                }
+            }
+        }
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(Matrix<T, size, size>::readAllFromFile(file));
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * std::filesystem::file_size(file)));
+        std::filesystem::remove(file);
+    }
+}
+
+BENCHMARK(matrixMultiply<float, 3>);
+BENCHMARK(matrixMultiply<float, 4>);
+BENCHMARK(matrixMultiply<double, 4>);
+BENCHMARK(matrixMultiply<double, 8>);
+BENCHMARK(matrixVectorMultiply<float, 4>);
+BENCHMARK(matrixVectorMultiply<double, 4>);
+BENCHMARK(matrixInverse<float, 3>);
+BENCHMARK(matrixInverse<float, 4>);
+BENCHMARK(matrixInverse<double, 4>);
+BENCHMARK(matrixInverse<double, 8>);
+BENCHMARK(matrixDeterminant<float, 4>);
+BENCHMARK(matrixDeterminant<double, 4>);
+BENCHMARK(matrixDeterminant<double, 8>);
+BENCHMARK(solveLinearSystem<float, 3>);
+BENCHMARK(solveLinearSystem<double, 4>);
+BENCHMARK(solveLinearSystem<double, 8>);
+BENCHMARK(solveLinearSystem<double, 32>);
+BENCHMARK(factorLU<double, 8>);
+BENCHMARK(factorLU<double, 32>);
+BENCHMARK(solveWithLUDecomposition<float, 3>);
+BENCHMARK(solveWithLUDecomposition<double, 4>);
+BENCHMARK(solveWithLUDecomposition<double, 8>);
+BENCHMARK(solveWithLUDecomposition<double, 32>);
+BENCHMARK(factorCholesky<float, 3>);
+BENCHMARK(factorCholesky<double, 8>);
+BENCHMARK(factorQR<float, 3, 3>);
+BENCHMARK(factorQR<double, 8, 4>);
+BENCHMARK(singularValueDecomposition<float, 3>);
+BENCHMARK(singularValueDecomposition<double, 3>);
+BENCHMARK(singularValueDecomposition<double, 4>);
+BENCHMARK(readMatricesFromFile<float, 4>)->Arg(10000);
@@ -0,0 +1,42 @@
+#include "benchmark/benchmark.h"
+#include "3dmath/OBJReader.h"
+#include "3dmath/STLReader.h"
+#include "3dmath/primitives/Sphere.h"
+#include <filesystem>
+using namespace math3d;
+
+namespace {
+    // A file with a tessellated sphere of about 2 * resolution^2 triangles
+    std::filesystem::path writeSphere(unsigned const resolution, std::string const& extension) {
+        auto const file = std::filesystem::temp_directory_path() / ("3dmathReaderBenchmark" + extension);
+        Sphere sphere({1, 2, 3}, 5, resolution);
+        sphere.writeToFile(file);
+        return file;
+    }
+
+    // The argument is the sphere resolution
+    void readSTLFile(benchmark::State& state, VertexWelding const welding) {
+        auto const file = writeSphere(static_cast<unsigned>(state.range(0)), ".stl");
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(readSTL(file, welding));
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * std::filesystem::file_size(file)));
+        std::filesystem::remove(file);
+    }
+
+    // Arguments are the sphere resolution and the execution policy
+    void readOBJFile(benchmark::State& state) {
+        auto const file = writeSphere(static_cast<unsigned>(state.range(0)), ".obj");
+        auto const execution = static_cast<Execution>(state.range(1));
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(readOBJ(file, execution));
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * std::filesystem::file_size(file)));
+        std::filesystem::remove(file);
+    }
+}
+
+BENCHMARK_CAPTURE(readSTLFile, unwelded, VertexWelding::None)->Arg(256);
+BENCHMARK_CAPTURE(readSTLFile, welded, VertexWelding::Exact)->Arg(256);
+BENCHMARK(readOBJFile)->Args({256, static_cast<int>(Execution::Sequential)})
+                      ->Args({256, static_cast<int>(Execution::Parallel)})->UseRealTime();
@@ -0,0 +1,46 @@
+#include "benchmark/benchmark.h"
+#include "3dmath/primitives/Plane.h"
+#include "3dmath/primitives/Ray.h"
+#include "3dmath/primitives/Sphere.h"
+#include "3dmath/primitives/Triangle.h"
+#include <filesystem>
+using namespace math3d;
+
+namespace {
+    void sphereGenerateGeometry(benchmark::State& state) {
+        auto const resolution = static_cast<unsigned>(state.range(0));
+        for (auto _ : state) {
+            Sphere sphere({1, 2, 3}, 5, resolution);
+            sphere.generateGeometry();
+            benchmark::DoNotOptimize(sphere.getVertices().data());
+        }
+    }
+
+    // Rays aimed at the primitive so that the full intersection computation is measured
+    template<typename PrimitiveType>
+    void intersectWithRay(benchmark::State& state, PrimitiveType primitive) {
+        Ray const ray({-10, -10, -10}, {1, 1, 1});
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(primitive.intersectWithRay(ray));
+        }
+    }
+
+    void writeToFile(benchmark::State& state, std::string const& extension) {
+        Sphere sphere({1, 2, 3}, 5, static_cast<unsigned>(state.range(0)));
+        sphere.generateGeometry();
+        auto const outputFile = std::filesystem::temp_directory_path() / ("3dmathBenchmark" + extension);
+        for (auto _ : state) {
+            sphere.writeToFile(outputFile);
+        }
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * std::filesystem::file_size(outputFile)));
+        std::filesystem::remove(outputFile);
+    }
+}
+
+BENCHMARK(sphereGenerateGeometry)->Arg(16)->Arg(64)->Arg(256);
+BENCHMARK_CAPTURE(intersectWithRay, sphere, Sphere({0, 0, 0}, 2));
+BENCHMARK_CAPTURE(intersectWithRay, plane, Plane({0, 0, 0}, {0, 0, 1}));
+BENCHMARK_CAPTURE(intersectWithRay, triangle, Triangle({-5, 0, 0}, {5, 0, 0}, {0, 5, 0}));
+BENCHMARK_CAPTURE(intersectWithRay, ray, Ray({0, 0, 10}, {0, 0, -1}));
+BENCHMARK_CAPTURE(writeToFile, stl, ".stl")->Arg(64)->Arg(256);
+BENCHMARK_CAPTURE(writeToFile, obj, ".obj")->Arg(64)->Arg(256);
@@ -0,0 +1,74 @@
+#include "benchmark/benchmark.h"
+#include "BenchmarkSupport.h"
+#include "3dmath/primitives/RayPacket.h"
+#include "3dmath/primitives/Sphere.h"
+#include "3dmath/primitives/Triangle.h"
+#include <vector>
+using namespace math3d;
+using namespace math3d::benchmarks;
+
+namespace {
+    constexpr unsigned numberOfRays = 1024;
+
+    // Rays from random points towards the origin, as the same rays and as packets of N of them
+    std::vector<Ray> makeRays() {
+        std::mt19937 generator(1);
+        std::vector<Ray> rays;
+        rays.reserve(numberOfRays);
+        for (unsigned i = 0; i < numberOfRays; ++i) {
+            auto const origin = BenchmarkSupport::randomVector<double, 3>(generator);
+            rays.emplace_back(origin, -origin);
+        }
+        return rays;
+    }
+
+    template<unsigned N>
+    std::vector<RayPacket<N>> makePackets() {
+        auto const rays = makeRays();
+        std::vector<RayPacket<N>> packets;
+        for (size_t first = 0; first < rays.size(); first += N) {
+            packets.emplace_back(std::span<Ray const>(rays).subspan(first, N));
+        }
+        return packets;
+    }
+
+    template<typename PrimitiveType>
+    void intersectRays(benchmark::State& state, PrimitiveType primitive) {
+        auto const rays = makeRays();
+        for (auto _ : state) {
+            for (auto const& ray : rays) {
+                benchmark::DoNotOptimize(primitive.intersectWithRay(ray));
+            }
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * numberOfRays));
+    }
+
+    template<unsigned N, typename PrimitiveType>
+    void intersectPackets(benchmark::State& state, PrimitiveType const& primitive) {
+        auto const packets = makePackets<N>();
+        for (auto _ : state) {
+            for (auto const& packet : packets) {
+                benchmark::DoNotOptimize(primitive.intersectWithRays(packet));
+            }
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * numberOfRays));
+    }
+
+    // The argument is the number of rays per packet
+    template<typename PrimitiveType>
+    void intersectPackets(benchmark::State& state, PrimitiveType primitive) {
+        if (state.range(0) == 4) {
+            intersectPackets<4>(state, primitive);
+        } else {
+            intersectPackets<8>(state, primitive);
+        }
+    }
+}
+
+BENCHMARK_CAPTURE(intersectRays, sphere, Sphere({0, 0, 0}, 2));
+BENCHMARK_CAPTURE(intersectPackets, sphere, Sphere({0, 0, 0}, 2))->Arg(4)->Arg(8);
+BENCHMARK_CAPTURE(intersectRays, plane, Plane({0, 0, 0}, {0, 0, 1}));
+BENCHMARK_CAPTURE(intersectPackets, plane, Plane({0, 0, 0}, {0, 0, 1}))->Arg(4)->Arg(8);
+BENCHMARK_CAPTURE(intersectRays, triangle, Triangle({-5, 0, 0}, {5, 0, 0}, {0, 5, 0}));
+BENCHMARK_CAPTURE(intersectPackets, triangle, Triangle({-5, 0, 0}, {5, 0, 0}, {0, 5, 0}))->Arg(4)->Arg(8);
+BENCHMARK_CAPTURE(intersectPackets, bounds, Bounds3D<float>{{-1, -1, -1}, {1, 1, 1}})->Arg(4)->Arg(8);
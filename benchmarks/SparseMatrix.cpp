@@ -0,0 +1,70 @@
+#include "benchmark/benchmark.h"
+#include "3dmath/IterativeSolvers.h"
+#include "3dmath/SparseMatrix.h"
+#include <random>
+#include <vector>
+using namespace math3d;
+
+namespace {
+    // I + L of a triangulated grid of size x size vertices, the system of an implicit smoothing step on a mesh
+    SparseMatrix<double> gridSmoothingSystem(unsigned const size) {
+        types::Tris tris;
+        for (unsigned row = 0; row + 1 < size; ++row) {
+            for (unsigned col = 0; col + 1 < size; ++col) {
+                auto const vertex = row * size + col;
+                tris.emplace_back(vertex, vertex + 1, vertex + size + 1);
+                tris.emplace_back(vertex, vertex + size + 1, vertex + size);
+            }
+        }
+        auto const laplacian = buildGraphLaplacian<double>(size * size, tris);
+        std::vector<SparseMatrix<double>::Element> elements;
+        for (unsigned row = 0; row < laplacian.getNumberOfRows(); ++row) {
+            elements.push_back({row, row, 1});
+            for (auto i = laplacian.getRowOffsets()[row]; i < laplacian.getRowOffsets()[row + 1]; ++i) {
+                elements.push_back({row, laplacian.getColumnIndices()[i], laplacian.getValues()[i]});
+            }
+        }
+        return {size * size, size * size, elements};
+    }
+
+    std::vector<double> randomVector(size_t const size) {
+        std::mt19937 generator(1);
+        std::uniform_real_distribution<double> distribution(-10, 10);
+        std::vector<double> vector(size);
+        for (auto& element : vector) {
+            element = distribution(generator);
+        }
+        return vector;
+    }
+
+    // Arguments are the grid size and the execution policy. Items are non-zeros
+    void sparseMatrixVectorMultiply(benchmark::State& state) {
+        auto const a = gridSmoothingSystem(static_cast<unsigned>(state.range(0)));
+        auto const execution = static_cast<Execution>(state.range(1));
+        auto const x = randomVector(a.getNumberOfColumns());
+        std::vector<double> result(a.getNumberOfRows());
+        for (auto _ : state) {
+            a.multiply(x, result, execution);
+            benchmark::DoNotOptimize(result.data());
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * a.getNumberOfNonZeros()));
+    }
+
+    // Arguments are the grid size and the preconditioner. Items are unknowns
+    void solveWithConjugateGradient(benchmark::State& state) {
+        auto const a = gridSmoothingSystem(static_cast<unsigned>(state.range(0)));
+        auto const preconditioner = static_cast<Preconditioner>(state.range(1));
+        auto const b = randomVector(a.getNumberOfRows());
+        std::vector<double> x(b.size());
+        for (auto _ : state) {
+            std::fill(x.begin(), x.end(), 0.);
+            benchmark::DoNotOptimize(solveConjugateGradient(a, b, x, {.preconditioner = preconditioner}));
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * b.size()));
+    }
+}
+
+BENCHMARK(sparseMatrixVectorMultiply)->Args({512, static_cast<int>(Execution::Sequential)});
+BENCHMARK(sparseMatrixVectorMultiply)->Args({512, static_cast<int>(Execution::Parallel)})->UseRealTime();
+BENCHMARK(solveWithConjugateGradient)->Args({256, static_cast<int>(Preconditioner::Jacobi)});
+BENCHMARK(solveWithConjugateGradient)->Args({256, static_cast<int>(Preconditioner::IncompleteCholesky)});
@@ -0,0 +1,85 @@
+#include "benchmark/benchmark.h"
+#include "BenchmarkSupport.h"
+#include "3dmath/primitives/SphereSet.h"
+#include <vector>
+using namespace math3d;
+using namespace math3d::benchmarks;
+
+namespace {
+    // Small spheres scattered in a 20x20x20 box, as individual spheres and as a set
+    std::vector<Sphere> makeSpheres(size_t const count) {
+        std::mt19937 generator(1);
+        std::uniform_real_distribution<float> radius(0.01f, 0.1f);
+        std::vector<Sphere> spheres;
+        spheres.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            spheres.emplace_back(BenchmarkSupport::randomVector<double, 3>(generator), radius(generator));
+        }
+        return spheres;
+    }
+
+    std::vector<Ray> makeRays(unsigned const count) {
+        std::mt19937 generator(2);
+        std::vector<Ray> rays;
+        for (unsigned i = 0; i < count; ++i) {
+            auto const origin = BenchmarkSupport::randomVector<double, 3>(generator);
+            rays.emplace_back(origin, BenchmarkSupport::randomVector<double, 3>(generator) - origin);
+        }
+        return rays;
+    }
+
+    // The argument is the number of spheres
+    void closestHitOfSpheres(benchmark::State& state) {
+        auto spheres = makeSpheres(static_cast<size_t>(state.range(0)));
+        auto const rays = makeRays(16);
+        for (auto _ : state) {
+            for (auto const& ray : rays) {
+                double closestDistance = std::numeric_limits<double>::infinity();
+                for (auto& sphere : spheres) {
+                    auto const result = sphere.intersectWithRay(ray);
+                    if (result.status == IntersectionStatus::Intersects) {
+                        auto const distance = (result.intersectionPoint - ray.getOrigin()).length();
+                        closestDistance = std::min(closestDistance, distance);
+                    }
+                }
+                benchmark::DoNotOptimize(closestDistance);
+            }
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * rays.size() * spheres.size()));
+    }
+
+    void closestHitOfSphereSet(benchmark::State& state) {
+        SphereSet const set(makeSpheres(static_cast<size_t>(state.range(0))));
+        auto const rays = makeRays(16);
+        for (auto _ : state) {
+            for (auto const& ray : rays) {
+                benchmark::DoNotOptimize(set.getClosestHit(ray));
+            }
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * rays.size() * set.size()));
+    }
+
+    void spheresContainingPoint(benchmark::State& state) {
+        SphereSet const set(makeSpheres(static_cast<size_t>(state.range(0))));
+        std::mt19937 generator(3);
+        auto const point = BenchmarkSupport::randomVector<float, 3>(generator);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(set.getSpheresContainingPoint(point));
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * set.size()));
+    }
+
+    void spheresOverlappingBounds(benchmark::State& state) {
+        SphereSet const set(makeSpheres(static_cast<size_t>(state.range(0))));
+        Bounds3D<float> const bounds{{-1, -1, -1}, {1, 1, 1}};
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(set.getSpheresOverlappingBounds(bounds));
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * set.size()));
+    }
+}
+
+BENCHMARK(closestHitOfSpheres)->Arg(100'000);
+BENCHMARK(closestHitOfSphereSet)->Arg(100'000);
+BENCHMARK(spheresContainingPoint)->Arg(100'000);
+BENCHMARK(spheresOverlappingBounds)->Arg(100'000);
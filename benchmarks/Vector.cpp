@@ -0,0 +1,63 @@
+#include "benchmark/benchmark.h"
+#include "BenchmarkSupport.h"
+#include "3dmath/Vector.h"
+using namespace math3d;
+using namespace math3d::benchmarks;
+
+namespace {
+    template<typename T>
+    void vectorDot(benchmark::State& state) {
+        std::mt19937 generator(1);
+        auto a = BenchmarkSupport::randomVector<T, 3>(generator);
+        auto b = BenchmarkSupport::randomVector<T, 3>(generator);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(a);
+            benchmark::DoNotOptimize(a.dot(b));
+        }
+    }
+
+    template<typename T>
+    void vectorCross(benchmark::State& state) {
+        std::mt19937 generator(1);
+        auto a = BenchmarkSupport::randomVector<T, 3>(generator);
+        auto b = BenchmarkSupport::randomVector<T, 3>(generator);
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(a);
+            benchmark::DoNotOptimize(a * b);
+        }
+    }
+
+    template<typename T>
+    void vectorNormalize(benchmark::State& state) {
+        std::mt19937 generator(1);
+        auto const a = BenchmarkSupport::randomVector<T, 3>(generator);
+        for (auto _ : state) {
+            auto normalized = a;
+            benchmark::DoNotOptimize(normalized.normalize());
+        }
+    }
+
+    // A compound expression that evaluates into a single result without temporaries
+    template<typename T>
+    void vectorExpression(benchmark::State& state) {
+        std::mt19937 generator(1);
+        auto a = BenchmarkSupport::randomVector<T, 4>(generator);
+        auto b = BenchmarkSupport::randomVector<T, 4>(generator);
+        auto c = BenchmarkSupport::randomVector<T, 4>(generator);
+        Vector<T, 4> result;
+        for (auto _ : state) {
+            benchmark::DoNotOptimize(a);
+            result = a + b * T{2} - c / T{3};
+            benchmark::DoNotOptimize(result);
+        }
+    }
+}
+
+BENCHMARK(vectorDot<float>);
+BENCHMARK(vectorDot<double>);
+BENCHMARK(vectorCross<float>);
+BENCHMARK(vectorCross<double>);
+BENCHMARK(vectorNormalize<float>);
+BENCHMARK(vectorNormalize<double>);
+BENCHMARK(vectorExpression<float>);
+BENCHMARK(vectorExpression<double>);
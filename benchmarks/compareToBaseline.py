@@ -0,0 +1,106 @@
+#!/usr/bin/env python3
+"""Compare google benchmark JSON results against a stored baseline.
+
+Benchmarks are matched by name. A benchmark whose time per iteration exceeds its baseline by more than the threshold
+is reported as a regression, and the script exits with a non-zero status if there are any. When results include
+aggregates from repeated runs, the medians are compared since they are the least sensitive to outliers.
+
+Benchmarks that take only a few nanoseconds vary more between runs than longer ones, so those with a baseline below
+the short limit are held to the separate, looser short threshold. Results whose coefficient of variation across
+repetitions is more than half the threshold are marked as noisy, since their change can't be told apart from noise.
+"""
+
+import argparse
+import json
+import sys
+
+NANOSECONDS_PER_UNIT = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def load(results_file):
+    with open(results_file) as f:
+        return json.load(f)
+
+
+def load_times(results):
+    benchmarks = results["benchmarks"]
+
+    def nanoseconds(b):
+        return b["cpu_time"] * NANOSECONDS_PER_UNIT[b.get("time_unit", "ns")]
+
+    medians = {b["run_name"]: b for b in benchmarks if b.get("aggregate_name") == "median"}
+    if medians:
+        return {name: nanoseconds(b) for name, b in medians.items()}
+    return {b["name"]: nanoseconds(b) for b in benchmarks if b.get("run_type", "iteration") == "iteration"}
+
+
+def load_variations(results):
+    return {b["run_name"]: b["cpu_time"] for b in results["benchmarks"] if b.get("aggregate_name") == "cv"}
+
+
+def context_warnings(baseline, results):
+    # Timings are only comparable when both were recorded the same way. Parallel benchmarks measure sequential
+    # behaviour on a single CPU, and a debug benchmark library adds its own overhead to every iteration
+    warnings = []
+    for name, context in (("baseline was", baseline["context"]), ("results were", results["context"])):
+        if context.get("library_build_type") == "debug":
+            warnings.append(f"The {name} recorded with a debug build of google benchmark")
+        if context.get("num_cpus", 0) == 1:
+            warnings.append(f"The {name} recorded on a single CPU, parallel benchmarks ran sequentially")
+    if baseline["context"].get("num_cpus") != results["context"].get("num_cpus"):
+        warnings.append(f"The baseline was recorded on {baseline['context'].get('num_cpus')} CPUs, "
+                        f"the results on {results['context'].get('num_cpus')}")
+    return warnings
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("baseline", help="Baseline results in google benchmark JSON format")
+    parser.add_argument("results", help="Current results in google benchmark JSON format")
+    parser.add_argument("--threshold", type=float, default=0.15,
+                        help="Allowed slowdown as a fraction of the baseline time (default: %(default)s)")
+    parser.add_argument("--short-threshold", type=float, default=0.3,
+                        help="Allowed slowdown for benchmarks whose baseline is below the short limit "
+                             "(default: %(default)s)")
+    parser.add_argument("--short-limit", type=float, default=100,
+                        help="Baseline time in nanoseconds below which the short threshold applies "
+                             "(default: %(default)s)")
+    args = parser.parse_args()
+
+    baseline_results = load(args.baseline)
+    current_results = load(args.results)
+    baseline = load_times(baseline_results)
+    results = load_times(current_results)
+    variations = load_variations(current_results)
+
+    regressions = []
+    print(f"{'Benchmark':<50} {'Baseline':>12} {'Current':>12} {'Change':>8}")
+    for name, time in results.items():
+        if name not in baseline:
+            print(f"{name:<50} {'-':>12} {time:>12.1f} {'new':>8}")
+            continue
+        threshold = args.short_threshold if baseline[name] < args.short_limit else args.threshold
+        change = (time - baseline[name]) / baseline[name]
+        flag = ""
+        if change > threshold:
+            regressions.append(name)
+            flag = "  REGRESSION"
+        if variations.get(name, 0) > threshold / 2:
+            flag += f"  NOISY (cv {variations[name]:.0%})"
+        print(f"{name:<50} {baseline[name]:>12.1f} {time:>12.1f} {change:>+8.1%}{flag}")
+
+    for name in baseline.keys() - results.keys():
+        print(f"{name:<50} missing from current results")
+
+    for warning in context_warnings(baseline_results, current_results):
+        print(f"Warning: {warning}")
+
+    if regressions:
+        print(f"\n{len(regressions)} benchmark(s) regressed by more than {args.threshold:.0%} "
+              f"({args.short_threshold:.0%} below {args.short_limit:g} ns)")
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,75 @@
+#!/usr/bin/env python3
+"""Add google benchmark JSON results to the stored baseline.
+
+Only benchmarks that are not in the baseline yet are added, so that recording a new benchmark doesn't silently move
+the entries that existing benchmarks are compared against. Existing entries are replaced only when they match one of
+the --replace patterns, which should accompany a change that is expected to affect their performance.
+
+Results recorded with a debug build of google benchmark or on a single CPU are refused unless --force is given, since
+such timings are not representative of the release build and parallel benchmarks run sequentially on a single CPU.
+"""
+
+import argparse
+import json
+import re
+import sys
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("baseline", help="Baseline results in google benchmark JSON format")
+    parser.add_argument("results", help="Current results in google benchmark JSON format")
+    parser.add_argument("--replace", action="append", default=[], metavar="REGEX",
+                        help="Replace existing baseline entries whose name matches the pattern. Can be repeated")
+    parser.add_argument("--force", action="store_true",
+                        help="Accept results recorded with a debug benchmark library or on a single CPU")
+    args = parser.parse_args()
+
+    with open(args.results) as f:
+        results = json.load(f)
+    try:
+        with open(args.baseline) as f:
+            baseline = json.load(f)
+    except FileNotFoundError:
+        baseline = {"context": results["context"], "benchmarks": []}
+
+    context = results["context"]
+    if not args.force and (context.get("library_build_type") == "debug" or context.get("num_cpus", 0) == 1):
+        print(f"Refusing results recorded with a {context.get('library_build_type')} benchmark library on "
+              f"{context.get('num_cpus')} CPU(s). Record them on an idle multi-core machine or pass --force")
+        return 1
+
+    def run_name(benchmark):
+        return benchmark.get("run_name", benchmark["name"])
+
+    patterns = [re.compile(pattern) for pattern in args.replace]
+    existing = {run_name(b) for b in baseline["benchmarks"]}
+    recorded = {run_name(b) for b in results["benchmarks"]}
+    matched = {name for name in existing if any(pattern.search(name) for pattern in patterns)}
+    replaced = matched & recorded
+    added = recorded - existing
+
+    # Keep the baseline's order and append new benchmarks in the order they were run
+    kept = [b for b in baseline["benchmarks"] if run_name(b) not in replaced]
+    updates = {}
+    for benchmark in results["benchmarks"]:
+        name = run_name(benchmark)
+        if name in added or name in replaced:
+            updates.setdefault(name, []).append(benchmark)
+    baseline["benchmarks"] = kept + [b for benchmarks in updates.values() for b in benchmarks]
+    if updates:
+        baseline["context"] = context
+
+    with open(args.baseline, "w") as f:
+        json.dump(baseline, f, indent=2)
+        f.write("\n")
+
+    for name in sorted(updates):
+        print(f"{name:<50} {'replaced' if name in replaced else 'added'}")
+    for name in sorted(matched - recorded):
+        print(f"{name:<50} not in results, kept")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
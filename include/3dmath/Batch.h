@@ -0,0 +1,61 @@
+#pragma once
+
+#include "BatchTypes.h"
+#include "Vector.h"
+#include <span>
+#include <thread>
+#include <vector>
+#include <mutex>
+#include <algorithm>
+#include <type_traits>
+
+// Helpers shared by operations over large arrays of points, such as batch transforms and bounds computation. Such
+// operations accept arrays of Vector3 (AoS) or separate arrays of x, y and z coordinates (SoA), which are described in
+// BatchTypes.h, and can split their work across threads when asked to
+
+namespace math3d {
+
+    namespace batch {
+
+        // Inputs smaller than this are not worth the cost of starting threads
+        constexpr size_t minimumElementsPerThread = 1 << 16;
+
+        // Run kernel(begin, end) over [0, count) in sequence or in chunks on separate threads. Chunk boundaries are
+        // multiples of four so that vectorized kernels process whole groups in every chunk but the last. Elements
+        // that are expensive to process, such as matrix columns, can be given a smaller minimum count per thread
+        template<typename Kernel>
+        void forEachRange(size_t const count, Execution const execution, Kernel&& kernel,
+                          size_t const minimumCountPerThread = minimumElementsPerThread) {
+            size_t numThreads = 1;
+            if (execution == Execution::Parallel) {
+                numThreads = std::clamp<size_t>(count / std::max<size_t>(minimumCountPerThread, 1), 1,
+                                                std::max(1u, std::thread::hardware_concurrency()));
+            }
+            if (numThreads == 1) {
+                kernel(size_t{0}, count);
+                return;
+            }
+            size_t const chunkSize = ((count / numThreads) + 3) & ~size_t{3};
+            std::vector<std::jthread> threads;
+            threads.reserve(numThreads - 1);
+            for (size_t begin = chunkSize; begin < count; begin += chunkSize) {
+                threads.emplace_back(kernel, begin, std::min(begin + chunkSize, count));
+            }
+            kernel(size_t{0}, std::min(chunkSize, count));
+        }
+
+        // Reduce [0, count) by computing kernel(begin, end) for each range and combining the partial results with
+        // combine(result, partialResult)
+        template<typename Result, typename Kernel, typename Combine>
+        Result reduceRanges(size_t const count, Execution const execution, Result result,
+                            Kernel&& kernel, Combine&& combine) {
+            std::mutex resultMutex;
+            forEachRange(count, execution, [&](size_t const begin, size_t const end) {
+                auto const partialResult = kernel(begin, end);
+                std::scoped_lock lock(resultMutex);
+                combine(result, partialResult);
+            });
+            return result;
+        }
+    }
+}
@@ -0,0 +1,181 @@
+#pragma once
+
+#include "Batch.h"
+#include "PacketRegister.h"
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+// Solve many independent small linear systems, such as per-vertex quadric minimizers or per-pixel fits
+//
+// Systems are passed as structures of arrays: one array per coefficient and one per right-hand side element, with an
+// element per system in each. Packets of 4, 8 or 16 systems are solved at once, a system per lane of a PacketRegister,
+// by Gaussian elimination with partial pivoting. Every lane picks its own pivots, by swapping rows only in the lanes
+// where a row below has a larger candidate. Nothing is allocated and nothing is thrown for singular systems. Instead,
+// their solutions are NaN and their singular flags are set.
+//
+// Large batches can be split across threads by passing Execution::Parallel.
+
+namespace math3d {
+
+    // Coefficients and right-hand sides of a set of single precision N x N systems. Element (row, col) of the
+    // coefficient matrix of system i is coefficients[col * N + row][i], and element row of its right-hand side is
+    // rightHandSides[row][i]
+    template<typename T, unsigned N>
+    struct LinearSystemSpans {
+        std::array<std::span<T>, N * N> coefficients;
+        std::array<std::span<T>, N> rightHandSides;
+
+        [[nodiscard]] size_t size() const { return rightHandSides[0].size(); }
+
+        operator LinearSystemSpans<T const, N>() const requires (!std::is_const_v<T>) { // NOLINT: Implicit conversion is intended
+            LinearSystemSpans<T const, N> result;
+            std::copy(coefficients.begin(), coefficients.end(), result.coefficients.begin());
+            std::copy(rightHandSides.begin(), rightHandSides.end(), result.rightHandSides.begin());
+            return result;
+        }
+    };
+
+    namespace batch {
+
+        // Solve a packet of systems in place. Coefficients are indexed by row and column. The right-hand sides are
+        // replaced by the solutions. Returns the lanes whose systems are singular, i.e. have a pivot that is
+        // negligible relative to the magnitude of their coefficients
+        template<unsigned N, unsigned lanes>
+        typename PacketRegister<lanes>::Mask solveLinearSystemPacket(typename PacketRegister<lanes>::Type (&a)[N][N],
+                                                                     typename PacketRegister<lanes>::Type (&b)[N]) {
+            using Register = PacketRegister<lanes>;
+            auto const zero = Register::broadcast(0);
+            auto const one = Register::broadcast(1);
+
+            auto largestCoefficient = zero;
+            for (unsigned row = 0; row < N; ++row) {
+                for (unsigned col = 0; col < N; ++col) {
+                    largestCoefficient = Register::max(largestCoefficient, Register::abs(a[row][col]));
+                }
+            }
+            auto const negligible = Register::multiply(largestCoefficient,
+                                                       Register::broadcast(std::numeric_limits<float>::epsilon() * N));
+
+            auto singular = Register::lessThan(zero, zero);
+            typename Register::Type inversePivots[N];
+            for (unsigned k = 0; k < N; ++k) {
+                // Swap rows in the lanes where a row below has a larger element in the pivot column. Columns to the
+                // left of the pivot have been eliminated and aren't read again
+                for (unsigned row = k + 1; row < N; ++row) {
+                    auto const swap = Register::lessThan(Register::abs(a[k][k]), Register::abs(a[row][k]));
+                    for (unsigned col = k; col < N; ++col) {
+                        auto const pivotRowElement = a[k][col];
+                        a[k][col] = Register::select(swap, a[row][col], pivotRowElement);
+                        a[row][col] = Register::select(swap, pivotRowElement, a[row][col]);
+                    }
+                    auto const pivotRowElement = b[k];
+                    b[k] = Register::select(swap, b[row], pivotRowElement);
+                    b[row] = Register::select(swap, pivotRowElement, b[row]);
+                }
+
+                // Singular lanes divide by one instead of a negligible pivot, so that they don't produce infinities
+                auto const isNegligible = Register::lessThanOrEqual(Register::abs(a[k][k]), negligible);
+                singular = Register::logicalOr(singular, isNegligible);
+                inversePivots[k] = Register::divide(one, Register::select(isNegligible, one, a[k][k]));
+
+                for (unsigned row = k + 1; row < N; ++row) {
+                    auto const factor = Register::multiply(a[row][k], inversePivots[k]);
+                    for (unsigned col = k + 1; col < N; ++col) {
+                        a[row][col] = Register::subtract(a[row][col], Register::multiply(factor, a[k][col]));
+                    }
+                    b[row] = Register::subtract(b[row], Register::multiply(factor, b[k]));
+                }
+            }
+
+            // Back substitution
+            for (unsigned k = N; k-- > 0;) {
+                auto sum = b[k];
+                for (unsigned col = k + 1; col < N; ++col) {
+                    sum = Register::subtract(sum, Register::multiply(a[k][col], b[col]));
+                }
+                b[k] = Register::multiply(sum, inversePivots[k]);
+            }
+
+            auto const notANumber = Register::broadcast(std::numeric_limits<float>::quiet_NaN());
+            for (unsigned k = 0; k < N; ++k) {
+                b[k] = Register::select(singular, notANumber, b[k]);
+            }
+            return singular;
+        }
+
+        // Solve every system. solutions and singular must have an element per system. solutions[row][i] is element
+        // row of the solution of system i, and singular[i] is set if system i is singular, in which case its solution
+        // is NaN. lanes is the number of systems solved at once
+        template<unsigned N, unsigned lanes = 8>
+        void solveLinearSystems(std::type_identity_t<LinearSystemSpans<float const, N>> const& systems,
+                                std::array<std::span<float>, N> const& solutions, std::span<bool> const singular,
+                                Execution const execution = Execution::Sequential) {
+            static_assert(lanes == 4 || lanes == 8 || lanes == 16, "Systems are solved in packets of 4, 8 or 16");
+            using Register = PacketRegister<lanes>;
+
+            auto const count = systems.size();
+            auto const validateSize = [count](size_t const size, char const* name) {
+                if (size != count) {
+                    throw std::invalid_argument("Number of systems and " + std::string(name) + " are different. " +
+                                                "There are " + std::to_string(count) + " systems and " +
+                                                std::to_string(size) + ' ' + name);
+                }
+            };
+            for (auto const& coefficient : systems.coefficients) validateSize(coefficient.size(), "coefficients");
+            for (auto const& rightHandSide : systems.rightHandSides) validateSize(rightHandSide.size(), "right-hand sides");
+            for (auto const& solution : solutions) validateSize(solution.size(), "solutions");
+            validateSize(singular.size(), "singular flags");
+
+            auto const solvePackets = [&](size_t const firstPacket, size_t const lastPacket) {
+                for (auto packet = firstPacket; packet < lastPacket; ++packet) {
+                    auto const first = packet * lanes;
+                    auto const numSystems = std::min<size_t>(lanes, count - first);
+
+                    // The systems of the last packet are padded with identity systems, which aren't singular
+                    auto const load = [first, numSystems](std::span<float const> const values, float const padding) {
+                        if (numSystems == lanes) {
+                            return Register::load(values.data() + first);
+                        }
+                        std::array<float, lanes> padded;
+                        padded.fill(padding);
+                        std::copy_n(values.data() + first, numSystems, padded.data());
+                        return Register::load(padded.data());
+                    };
+                    typename Register::Type a[N][N];
+                    typename Register::Type b[N];
+                    for (unsigned row = 0; row < N; ++row) {
+                        for (unsigned col = 0; col < N; ++col) {
+                            a[row][col] = load(systems.coefficients[col * N + row], row == col ? 1.f : 0.f);
+                        }
+                        b[row] = load(systems.rightHandSides[row], 0);
+                    }
+
+                    auto const singularLanes = Register::bits(solveLinearSystemPacket<N, lanes>(a, b));
+
+                    for (unsigned row = 0; row < N; ++row) {
+                        if (numSystems == lanes) {
+                            Register::store(solutions[row].data() + first, b[row]);
+                        } else {
+                            std::array<float, lanes> solution;
+                            Register::store(solution.data(), b[row]);
+                            std::copy_n(solution.data(), numSystems, solutions[row].data() + first);
+                        }
+                    }
+                    for (unsigned lane = 0; lane < numSystems; ++lane) {
+                        singular[first + lane] = (singularLanes >> lane) & 1u;
+                    }
+                }
+            };
+
+            // A packet takes about N^3 / 3 operations per lane
+            auto const numPackets = (count + lanes - 1) / lanes;
+            batch::forEachRange(numPackets, execution, solvePackets,
+                                std::max<size_t>(minimumElementsPerThread / (lanes * N * N), 1));
+        }
+    }
+}
@@ -0,0 +1,207 @@
+#pragma once
+
+#include "Batch.h"
+#include "Matrix.h"
+#include "MatrixKernels.h"
+#include "SupportingTypes.h"
+#include "TypeAliases.h"
+#include <stdexcept>
+
+// Transform many points or directions with the same 4x4 matrix
+//
+// Points are transformed as [x y z 1] and directions as [x y z 0]. Matrices are assumed to be affine, i.e. their
+// last row is [0 0 0 1], so no perspective division is performed. Inputs can be arrays of Vector3 (AoS) or separate
+// arrays of x, y and z coordinates (SoA). Input and output may be the same array, which makes the in-place variants
+// a convenience over the out-of-place ones.
+//
+// Single precision AoS and SoA inputs are transformed four at a time with SSE where it's available. Large inputs can
+// be split across threads by passing Execution::Parallel.
+
+namespace math3d {
+
+    namespace batch {
+
+        // Transform x, y and z arrays. translationScale is 1 for points and 0 for directions
+        template<typename T>
+        void transformCoordinates(T const* m, T const translationScale,
+                                  T const* x, T const* y, T const* z, T* outX, T* outY, T* outZ,
+                                  size_t begin, size_t const end) {
+#ifdef MATH3D_SSE
+            if constexpr (std::is_same_v<T, float>) {
+                __m128 const m00 = _mm_set1_ps(m[0]), m10 = _mm_set1_ps(m[1]), m20 = _mm_set1_ps(m[2]);
+                __m128 const m01 = _mm_set1_ps(m[4]), m11 = _mm_set1_ps(m[5]), m21 = _mm_set1_ps(m[6]);
+                __m128 const m02 = _mm_set1_ps(m[8]), m12 = _mm_set1_ps(m[9]), m22 = _mm_set1_ps(m[10]);
+                __m128 const tx = _mm_set1_ps(m[12] * translationScale);
+                __m128 const ty = _mm_set1_ps(m[13] * translationScale);
+                __m128 const tz = _mm_set1_ps(m[14] * translationScale);
+                for (; begin + 4 <= end; begin += 4) {
+                    __m128 const px = _mm_loadu_ps(x + begin);
+                    __m128 const py = _mm_loadu_ps(y + begin);
+                    __m128 const pz = _mm_loadu_ps(z + begin);
+                    _mm_storeu_ps(outX + begin, _mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, px), _mm_mul_ps(m01, py)),
+                                                           _mm_add_ps(_mm_mul_ps(m02, pz), tx)));
+                    _mm_storeu_ps(outY + begin, _mm_add_ps(_mm_add_ps(_mm_mul_ps(m10, px), _mm_mul_ps(m11, py)),
+                                                           _mm_add_ps(_mm_mul_ps(m12, pz), ty)));
+                    _mm_storeu_ps(outZ + begin, _mm_add_ps(_mm_add_ps(_mm_mul_ps(m20, px), _mm_mul_ps(m21, py)),
+                                                           _mm_add_ps(_mm_mul_ps(m22, pz), tz)));
+                }
+            }
+#endif
+            T const tx = m[12] * translationScale;
+            T const ty = m[13] * translationScale;
+            T const tz = m[14] * translationScale;
+            for (; begin < end; ++begin) {
+                T const px = x[begin], py = y[begin], pz = z[begin];
+                outX[begin] = m[0] * px + m[4] * py + m[8] * pz + tx;
+                outY[begin] = m[1] * px + m[5] * py + m[9] * pz + ty;
+                outZ[begin] = m[2] * px + m[6] * py + m[10] * pz + tz;
+            }
+        }
+
+        // Transform interleaved [x y z] triples
+        template<typename T>
+        void transformTriples(T const* m, T const translationScale, T const* in, T* out, size_t begin, size_t const end) {
+#ifdef MATH3D_SSE
+            if constexpr (std::is_same_v<T, float>) {
+                __m128 const m00 = _mm_set1_ps(m[0]), m10 = _mm_set1_ps(m[1]), m20 = _mm_set1_ps(m[2]);
+                __m128 const m01 = _mm_set1_ps(m[4]), m11 = _mm_set1_ps(m[5]), m21 = _mm_set1_ps(m[6]);
+                __m128 const m02 = _mm_set1_ps(m[8]), m12 = _mm_set1_ps(m[9]), m22 = _mm_set1_ps(m[10]);
+                __m128 const tx = _mm_set1_ps(m[12] * translationScale);
+                __m128 const ty = _mm_set1_ps(m[13] * translationScale);
+                __m128 const tz = _mm_set1_ps(m[14] * translationScale);
+                for (; begin + 4 <= end; begin += 4) {
+                    // Four points span three registers [x0 y0 z0 x1] [y1 z1 x2 y2] [z2 x3 y3 z3]. Transpose them
+                    // to [x0 x1 x2 x3] [y0 y1 y2 y3] [z0 z1 z2 z3]
+                    float const* source = in + begin * 3;
+                    __m128 const a = _mm_loadu_ps(source);
+                    __m128 const b = _mm_loadu_ps(source + 4);
+                    __m128 const c = _mm_loadu_ps(source + 8);
+                    __m128 const t = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 1, 3, 2));
+                    __m128 const px = _mm_shuffle_ps(a, t, _MM_SHUFFLE(2, 0, 3, 0));
+                    __m128 const py = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1)), t,
+                                                     _MM_SHUFFLE(3, 1, 2, 0));
+                    __m128 const pz = _mm_shuffle_ps(_mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2)), c,
+                                                     _MM_SHUFFLE(3, 0, 2, 0));
+
+                    __m128 const rx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m00, px), _mm_mul_ps(m01, py)),
+                                                 _mm_add_ps(_mm_mul_ps(m02, pz), tx));
+                    __m128 const ry = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m10, px), _mm_mul_ps(m11, py)),
+                                                 _mm_add_ps(_mm_mul_ps(m12, pz), ty));
+                    __m128 const rz = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m20, px), _mm_mul_ps(m21, py)),
+                                                 _mm_add_ps(_mm_mul_ps(m22, pz), tz));
+
+                    // Interleave the results back into triples
+                    float* destination = out + begin * 3;
+                    _mm_storeu_ps(destination, _mm_shuffle_ps(_mm_shuffle_ps(rx, ry, _MM_SHUFFLE(0, 0, 0, 0)),
+                                                              _mm_shuffle_ps(rz, rx, _MM_SHUFFLE(1, 1, 0, 0)),
+                                                              _MM_SHUFFLE(2, 0, 2, 0)));
+                    _mm_storeu_ps(destination + 4, _mm_shuffle_ps(_mm_shuffle_ps(ry, rz, _MM_SHUFFLE(1, 1, 1, 1)),
+                                                                  _mm_shuffle_ps(rx, ry, _MM_SHUFFLE(2, 2, 2, 2)),
+                                                                  _MM_SHUFFLE(2, 0, 2, 0)));
+                    _mm_storeu_ps(destination + 8, _mm_shuffle_ps(_mm_shuffle_ps(rz, rx, _MM_SHUFFLE(3, 3, 2, 2)),
+                                                                  _mm_shuffle_ps(ry, rz, _MM_SHUFFLE(3, 3, 3, 3)),
+                                                                  _MM_SHUFFLE(2, 0, 2, 0)));
+                }
+            }
+#endif
+            T const tx = m[12] * translationScale;
+            T const ty = m[13] * translationScale;
+            T const tz = m[14] * translationScale;
+            for (; begin < end; ++begin) {
+                T const px = in[begin * 3], py = in[begin * 3 + 1], pz = in[begin * 3 + 2];
+                out[begin * 3] = m[0] * px + m[4] * py + m[8] * pz + tx;
+                out[begin * 3 + 1] = m[1] * px + m[5] * py + m[9] * pz + ty;
+                out[begin * 3 + 2] = m[2] * px + m[6] * py + m[10] * pz + tz;
+            }
+        }
+
+        template<typename T>
+        void transform(Matrix<T, 4, 4> const& matrix, T const translationScale,
+                       Points<T const> in, Points<T> out, Execution const execution) {
+            if (in.size() != out.size()) {
+                throw std::invalid_argument("Input and output sizes are different. Input size is " +
+                                            std::to_string(in.size()) + " Output size is " + std::to_string(out.size()));
+            }
+            if (in.empty()) return;
+            // Vector3 is laid out as three contiguous elements, so arrays of vectors are arrays of triples
+            T const* inData = in.front().getData();
+            T* outData = out.front().getData();
+            forEachRange(in.size(), execution, [&](size_t begin, size_t end) {
+                transformTriples(matrix.getData(), translationScale, inData, outData, begin, end);
+            });
+        }
+
+        template<typename T>
+        void transform(Matrix<T, 4, 4> const& matrix, T const translationScale,
+                       Coordinates<T const> in, Coordinates<T> out, Execution const execution) {
+            auto const size = in.size();
+            if (in.y.size() != size || in.z.size() != size ||
+                out.x.size() != size || out.y.size() != size || out.z.size() != size) {
+                throw std::invalid_argument("Coordinate arrays should all be of the same size");
+            }
+            forEachRange(size, execution, [&](size_t begin, size_t end) {
+                transformCoordinates(matrix.getData(), translationScale, in.x.data(), in.y.data(), in.z.data(),
+                                     out.x.data(), out.y.data(), out.z.data(), begin, end);
+            });
+        }
+    }
+
+    // Transform points [x y z 1] by an affine transform
+    template<typename T>
+    void transformPoints(Matrix<T, 4, 4> const& matrix, Points<T const> in, Points<T> out,
+                         Execution const execution = Execution::Sequential) {
+        batch::transform(matrix, T{1}, in, out, execution);
+    }
+
+    template<typename T>
+    void transformPoints(Matrix<T, 4, 4> const& matrix, Points<T> points,
+                         Execution const execution = Execution::Sequential) {
+        batch::transform(matrix, T{1}, points, points, execution);
+    }
+
+    template<typename T>
+    void transformPoints(Matrix<T, 4, 4> const& matrix, Coordinates<T const> in, Coordinates<T> out,
+                         Execution const execution = Execution::Sequential) {
+        batch::transform(matrix, T{1}, in, out, execution);
+    }
+
+    template<typename T>
+    void transformPoints(Matrix<T, 4, 4> const& matrix, Coordinates<T> points,
+                         Execution const execution = Execution::Sequential) {
+        batch::transform(matrix, T{1}, points, points, execution);
+    }
+
+    // Transform directions [x y z 0], which are unaffected by the translation part of the transform
+    template<typename T>
+    void transformDirections(Matrix<T, 4, 4> const& matrix, Points<T const> in, Points<T> out,
+                             Execution const execution = Execution::Sequential) {
+        batch::transform(matrix, T{0}, in, out, execution);
+    }
+
+    template<typename T>
+    void transformDirections(Matrix<T, 4, 4> const& matrix, Points<T> directions,
+                             Execution const execution = Execution::Sequential) {
+        batch::transform(matrix, T{0}, directions, directions, execution);
+    }
+
+    template<typename T>
+    void transformDirections(Matrix<T, 4, 4> const& matrix, Coordinates<T const> in, Coordinates<T> out,
+                             Execution const execution = Execution::Sequential) {
+        batch::transform(matrix, T{0}, in, out, execution);
+    }
+
+    template<typename T>
+    void transformDirections(Matrix<T, 4, 4> const& matrix, Coordinates<T> directions,
+                             Execution const execution = Execution::Sequential) {
+        batch::transform(matrix, T{0}, directions, directions, execution);
+    }
+
+    template<typename T>
+    void Remapper<T>::operator()(std::span<Vector3<T> const> sourcePoints, std::span<Vector3<T>> remappedPoints,
+                                 Execution const execution) const {
+        if (!remapTransform) {
+            computeRemapTransform();
+        }
+        transformPoints(*remapTransform, sourcePoints, remappedPoints, execution);
+    }
+}
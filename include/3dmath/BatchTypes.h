@@ -0,0 +1,40 @@
+#pragma once
+
+#include "Vector.h"
+#include <span>
+#include <type_traits>
+
+// Execution policy and parameter types of operations over large arrays of points. They are kept apart from the
+// threading helpers in Batch.h, so that headers which only declare such operations, e.g. SupportingTypes.h, stay light
+
+namespace math3d {
+
+    enum class Execution {
+        Sequential,
+        Parallel
+    };
+
+    // x, y and z coordinates of a set of points or directions stored in separate arrays
+    template<typename T>
+    struct CoordinateSpans {
+        std::span<T> x;
+        std::span<T> y;
+        std::span<T> z;
+
+        [[nodiscard]] size_t size() const { return x.size(); }
+
+        operator CoordinateSpans<T const>() const requires (!std::is_const_v<T>) { // NOLINT: Implicit conversion is intended
+            return {x, y, z};
+        }
+    };
+
+    // Parameter types of batch functions. Function arguments don't participate in deducing T, so containers such as
+    // types::Vertices convert to spans implicitly and T is deduced from the other arguments, e.g. a transform matrix
+    template<typename T>
+    using Points = std::type_identity_t<std::span<std::conditional_t<std::is_const_v<T>,
+                                                                     Vector3<std::remove_const_t<T>> const,
+                                                                     Vector3<T>>>>;
+
+    template<typename T>
+    using Coordinates = std::type_identity_t<CoordinateSpans<T>>;
+}
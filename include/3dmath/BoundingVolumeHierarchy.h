@@ -0,0 +1,458 @@
+#pragma once
+
+#include "Batch.h"
+#include "SupportingTypes.h"
+#include "TriangleKernels.h"
+#include "TypeAliases.h"
+#include "Vector.h"
+#include "primitives/Ray.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <iterator>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace math3d {
+
+    // Bounding volume hierarchy over the triangles of a mesh, for ray queries such as picking and visibility tests
+    //
+    // The hierarchy is built top-down. Each node is split where the surface area heuristic (SAH) is lowest, with the
+    // heuristic evaluated at a fixed number of bins along each axis. Nodes are stored in a flat array in which the two
+    // children of a node are adjacent. Triangles are stored in leaf order together with their precomputed edges, so
+    // traversal reads contiguous memory and needs no access to the original vertices
+    class BoundingVolumeHierarchy {
+    public:
+        struct Hit {
+            // Index of the hit triangle in the tris the hierarchy was built from
+            unsigned triangleIndex;
+            // Ray parameter at the hit point. This is the distance from the ray origin when the direction is normalized
+            float distance;
+            // Weights of the triangle's three vertices at the hit point
+            Vector3<float> barycentricCoordinates;
+        };
+
+        // Large meshes can be built on several threads by passing Execution::Parallel. The hierarchy is the same
+        // either way
+        BoundingVolumeHierarchy(std::span<types::Vertex const> vertices, std::span<types::Tri const> tris,
+                                Execution const execution = Execution::Sequential) {
+            build(vertices, tris, execution);
+        }
+
+        // Nearest triangle hit by the ray within maxDistance
+        [[nodiscard]]
+        std::optional<Hit> closestHit(Vector3<float> const& origin, Vector3<float> const& direction,
+                                      float const maxDistance = std::numeric_limits<float>::infinity()) const {
+            return traverse<false>(origin, direction, maxDistance);
+        }
+
+        [[nodiscard]]
+        std::optional<Hit> closestHit(Ray const& ray,
+                                      float const maxDistance = std::numeric_limits<float>::infinity()) const {
+            return closestHit(Utilities::asFloat(ray.getOrigin()), Utilities::asFloat(ray.getDirection()), maxDistance);
+        }
+
+        // Any triangle hit by the ray within maxDistance. This is cheaper than closestHit since traversal stops at
+        // the first hit, which makes it the better choice for occlusion tests
+        [[nodiscard]]
+        std::optional<Hit> anyHit(Vector3<float> const& origin, Vector3<float> const& direction,
+                                  float const maxDistance = std::numeric_limits<float>::infinity()) const {
+            return traverse<true>(origin, direction, maxDistance);
+        }
+
+        [[nodiscard]]
+        std::optional<Hit> anyHit(Ray const& ray,
+                                  float const maxDistance = std::numeric_limits<float>::infinity()) const {
+            return anyHit(Utilities::asFloat(ray.getOrigin()), Utilities::asFloat(ray.getDirection()), maxDistance);
+        }
+
+        // Bounds of all triangles. Bounds of an empty hierarchy are invalid
+        [[nodiscard]]
+        Bounds3D<float> getBounds() const {
+            return nodes.empty() ? Bounds3D<float>{} : nodes.front().bounds;
+        }
+
+        [[nodiscard]]
+        size_t getNumberOfNodes() const {
+            return nodes.size();
+        }
+
+        [[nodiscard]]
+        size_t getNumberOfTriangles() const {
+            return triangles.size();
+        }
+
+    private:
+        // Interior nodes have no triangles and their children are at firstChildOrTriangle and firstChildOrTriangle + 1.
+        // Leaf nodes refer to numberOfTriangles triangles starting at firstChildOrTriangle
+        struct Node {
+            Bounds3D<float> bounds;
+            unsigned firstChildOrTriangle;
+            unsigned numberOfTriangles;
+        };
+
+        struct Triangle {
+            Vector3<float> vertex;
+            Vector3<float> edge1;
+            Vector3<float> edge2;
+        };
+
+        static constexpr unsigned numberOfBins = 16;
+        static constexpr unsigned maxTrianglesPerLeaf = 16;
+        // Cost of visiting a node relative to the cost of intersecting a triangle
+        static constexpr float traversalCost = 1.f;
+        // Nodes at this depth are made leaves, which bounds the size of the traversal stack
+        static constexpr unsigned maxDepth = 64;
+
+        static float surfaceArea(Bounds3D<float> const& bounds) {
+            auto const dx = bounds.x.length(), dy = bounds.y.length(), dz = bounds.z.length();
+            return 2.f * (dx * dy + dy * dz + dz * dx);
+        }
+
+        // A triangle during the build
+        struct Reference {
+            Bounds3D<float> bounds;
+            unsigned triangle;
+
+            // Centroids are recomputed rather than stored, since the size of references bounds the speed of the
+            // passes over them
+            [[nodiscard]] Vector3<float> centroid() const {
+                return bounds.center();
+            }
+        };
+
+        struct Split {
+            unsigned axis;
+            unsigned bin;
+            float cost;
+            unsigned numberOfBins;
+            float centroidMin;
+            float binsPerUnitLength;
+            // Bounds of the triangles on either side of the split
+            Bounds3D<float> bounds[2];
+
+            [[nodiscard]] unsigned binOf(Vector3<float> const& centroid) const {
+                return std::min(numberOfBins - 1,
+                                static_cast<unsigned>((centroid[axis] - centroidMin) * binsPerUnitLength));
+            }
+        };
+
+        struct Bin {
+            Bounds3D<float> bounds;
+            unsigned numberOfTriangles;
+        };
+        using Bins = std::array<std::array<Bin, numberOfBins>, 3>;
+
+        // A node whose triangles are yet to be split
+        struct Task {
+            unsigned node;
+            unsigned begin;
+            unsigned end;
+            unsigned depth;
+            Bounds3D<float> centroidBounds;
+        };
+
+        void build(std::span<types::Vertex const> vertices, std::span<types::Tri const> tris,
+                   Execution const execution) {
+            if (tris.empty()) return;
+
+            // Triangles are partitioned by value rather than through an index array, which keeps every pass over
+            // a node's triangles sequential in memory
+            std::vector<Reference> references(tris.size());
+            Bounds3D<float> bounds, centroidBounds;
+            for (size_t i = 0; i < tris.size(); ++i) {
+                auto& reference = references[i];
+                for (auto const vertexIndex : tris[i]) {
+                    if (vertexIndex >= vertices.size()) {
+                        throw std::invalid_argument("Triangle " + std::to_string(i) + " refers to vertex " +
+                                                    std::to_string(vertexIndex) + " which does not exist");
+                    }
+                    reference.bounds.merge(vertices[vertexIndex]);
+                }
+                reference.triangle = static_cast<unsigned>(i);
+                bounds.merge(reference.bounds);
+                centroidBounds.merge(reference.centroid());
+            }
+
+            nodes.reserve(2 * tris.size() - 1);
+            nodes.push_back({bounds, 0, 0});
+            Task const root{0, 0, static_cast<unsigned>(tris.size()), 0, centroidBounds};
+            if (execution == Execution::Sequential || tris.size() < batch::minimumElementsPerThread) {
+                buildNodes(references, nodes, root, 0, nullptr);
+            } else {
+                buildInParallel(references, root);
+            }
+            triangles.reserve(tris.size());
+            triangleIndices.reserve(tris.size());
+            for (auto const& reference : references) {
+                auto const& tri = tris[reference.triangle];
+                auto const& a = vertices[tri[0]];
+                triangles.push_back({a, vertices[tri[1]] - a, vertices[tri[2]] - a});
+                triangleIndices.push_back(reference.triangle);
+            }
+        }
+
+        // Split the node of the root task and its descendants until they become leaves. If subtrees is given, nodes
+        // with at most subtreeSize triangles are not split but added to subtrees to be built separately
+        static void buildNodes(std::vector<Reference>& references, std::vector<Node>& nodes, Task const& root,
+                               unsigned const subtreeSize, std::vector<Task>* subtrees) {
+            std::vector<Task> tasks{root};
+            Bins bins;
+            while (!tasks.empty()) {
+                auto const task = tasks.back();
+                tasks.pop_back();
+
+                auto const numberOfTriangles = task.end - task.begin;
+                if (subtrees && numberOfTriangles <= subtreeSize) {
+                    subtrees->push_back(task);
+                    continue;
+                }
+                auto const split = task.depth + 1 < maxDepth ?
+                    findSplit(references, bins, task.begin, task.end, nodes[task.node].bounds, task.centroidBounds) :
+                    std::nullopt;
+                if (!split || (split->cost >= static_cast<float>(numberOfTriangles) &&
+                               numberOfTriangles <= maxTrianglesPerLeaf)) {
+                    nodes[task.node].firstChildOrTriangle = task.begin;
+                    nodes[task.node].numberOfTriangles = numberOfTriangles;
+                    continue;
+                }
+
+                // Partition the triangles about the split and compute the centroid bounds of either side on the way
+                Bounds3D<float> centroidBounds[2];
+                auto middle = task.begin;
+                for (auto end = task.end; middle < end;) {
+                    auto const centroid = references[middle].centroid();
+                    if (split->binOf(centroid) <= split->bin) {
+                        centroidBounds[0].merge(centroid);
+                        ++middle;
+                    } else {
+                        centroidBounds[1].merge(centroid);
+                        std::swap(references[middle], references[--end]);
+                    }
+                }
+
+                auto const firstChild = static_cast<unsigned>(nodes.size());
+                nodes[task.node].firstChildOrTriangle = firstChild;
+                nodes[task.node].numberOfTriangles = 0;
+                nodes.push_back({split->bounds[0], 0, 0});
+                nodes.push_back({split->bounds[1], 0, 0});
+                tasks.push_back({firstChild, task.begin, middle, task.depth + 1, centroidBounds[0]});
+                tasks.push_back({firstChild + 1, middle, task.end, task.depth + 1, centroidBounds[1]});
+            }
+        }
+
+        // Split the top of the hierarchy on this thread until there are enough subtrees to keep all threads busy,
+        // then build the subtrees on separate threads and append their nodes to the hierarchy. Subtrees cover
+        // disjoint ranges of references, so threads partition them without synchronization
+        void buildInParallel(std::vector<Reference>& references, Task const& root) {
+            auto const numberOfThreads = std::max(1u, std::thread::hardware_concurrency());
+            auto const subtreeSize = std::max(static_cast<unsigned>(batch::minimumElementsPerThread / 4),
+                                              (root.end - root.begin) / (numberOfThreads * 8));
+            std::vector<Task> subtrees;
+            buildNodes(references, nodes, root, subtreeSize, &subtrees);
+
+            // Threads take the next subtree to build until none are left, which balances subtrees of unequal sizes
+            std::vector<std::vector<Node>> subtreeNodes(subtrees.size());
+            std::atomic<size_t> nextSubtree = 0;
+            auto const buildSubtrees = [&]() {
+                for (auto i = nextSubtree++; i < subtrees.size(); i = nextSubtree++) {
+                    auto const& subtree = subtrees[i];
+                    subtreeNodes[i].push_back(nodes[subtree.node]);
+                    buildNodes(references, subtreeNodes[i],
+                               {0, subtree.begin, subtree.end, subtree.depth, subtree.centroidBounds}, 0, nullptr);
+                }
+            };
+            {
+                std::vector<std::jthread> threads;
+                threads.reserve(numberOfThreads - 1);
+                for (unsigned thread = 1; thread < numberOfThreads; ++thread) {
+                    threads.emplace_back(buildSubtrees);
+                }
+                buildSubtrees();
+            }
+
+            // The root of a subtree replaces the node it was built for and the rest of its nodes are appended.
+            // Child indices of interior nodes are offset by where the nodes end up
+            for (size_t i = 0; i < subtrees.size(); ++i) {
+                auto const offset = static_cast<unsigned>(nodes.size()) - 1;
+                auto const relocate = [offset](Node node) {
+                    if (node.numberOfTriangles == 0) node.firstChildOrTriangle += offset;
+                    return node;
+                };
+                nodes[subtrees[i].node] = relocate(subtreeNodes[i].front());
+                std::transform(subtreeNodes[i].begin() + 1, subtreeNodes[i].end(), std::back_inserter(nodes), relocate);
+            }
+        }
+
+        // Find the bin boundary with the lowest SAH cost across all three axes. Costs are in units of the cost of
+        // intersecting a triangle, so they are directly comparable to the cost of making the node a leaf
+        static std::optional<Split> findSplit(std::vector<Reference> const& references, Bins& binsPerAxis,
+                                              unsigned const begin, unsigned const end,
+                                              Bounds3D<float> const& bounds, Bounds3D<float> const& centroidBounds) {
+            if (end - begin < 2) return std::nullopt;
+
+            // Most nodes are near the bottom of the hierarchy and hold a handful of triangles. They are binned into
+            // as many bins as they have triangles, which keeps the fixed cost of evaluating a node proportional to
+            // its size
+            auto const binsPerSplit = std::min(numberOfBins, end - begin);
+
+            // Splits along all three axes are binned in one pass over the triangles, since at the top of the
+            // hierarchy the passes are limited by memory bandwidth
+            std::array<Split, 3> splits;
+            for (unsigned axis = 0; axis < 3; ++axis) {
+                auto const extent = centroidBounds.extent(static_cast<Bounds3D<float>::Direction>(axis));
+                auto const length = extent.length();
+                splits[axis] = {axis, 0, 0, binsPerSplit, extent.min,
+                                length > 0 ? static_cast<float>(binsPerSplit) / length : 0.f, {}};
+                for (unsigned bin = 0; bin < binsPerSplit; ++bin) {
+                    binsPerAxis[axis][bin] = {{}, 0};
+                }
+            }
+            for (auto i = begin; i < end; ++i) {
+                auto const& reference = references[i];
+                for (unsigned axis = 0; axis < 3; ++axis) {
+                    auto& bin = binsPerAxis[axis][splits[axis].binOf(reference.centroid())];
+                    bin.bounds.merge(reference.bounds);
+                    ++bin.numberOfTriangles;
+                }
+            }
+
+            std::optional<Split> best;
+            auto const parentArea = surfaceArea(bounds);
+            for (unsigned axis = 0; axis < 3; ++axis) {
+                // Triangles whose centroids coincide along an axis can't be split along it
+                if (splits[axis].binsPerUnitLength == 0) continue;
+                auto& bins = binsPerAxis[axis];
+
+                // Sweep from the right to accumulate area-weighted counts of the right side of every boundary and
+                // then from the left to evaluate each boundary
+                std::array<float, numberOfBins> rightCosts;
+                Bounds3D<float> rightBounds;
+                unsigned rightCount = 0;
+                for (auto bin = binsPerSplit - 1; bin > 0; --bin) {
+                    rightBounds.merge(bins[bin].bounds);
+                    rightCount += bins[bin].numberOfTriangles;
+                    rightCosts[bin - 1] = rightCount ? surfaceArea(rightBounds) * static_cast<float>(rightCount) : 0;
+                }
+                Bounds3D<float> leftBounds;
+                unsigned leftCount = 0;
+                for (unsigned bin = 0; bin < binsPerSplit - 1; ++bin) {
+                    leftBounds.merge(bins[bin].bounds);
+                    leftCount += bins[bin].numberOfTriangles;
+                    if (leftCount == 0 || leftCount == end - begin) continue;
+                    auto const cost = traversalCost +
+                        (surfaceArea(leftBounds) * static_cast<float>(leftCount) + rightCosts[bin]) / parentArea;
+                    if (!best || cost < best->cost) {
+                        best = splits[axis];
+                        best->bin = bin;
+                        best->cost = cost;
+                    }
+                }
+            }
+
+            if (best) {
+                for (unsigned bin = 0; bin < binsPerSplit; ++bin) {
+                    best->bounds[bin <= best->bin ? 0 : 1].merge(binsPerAxis[best->axis][bin].bounds);
+                }
+            }
+            return best;
+        }
+
+        // Distance along the ray to the box, or infinity if the ray misses the box within [0, maxDistance]. Triangles
+        // at exactly the distance of the current hit can't improve it, so boxes are only visited if they are closer.
+        // The slab tests are branchless min/max operations. A ray parallel to a slab that starts exactly on the slab's
+        // boundary produces a NaN, and may be reported as missing the box
+        static float distanceToBox(Bounds3D<float> const& box, Vector3<float> const& origin,
+                                   Vector3<float> const& inverseDirection, float const maxDistance) {
+            float nearest = 0.f, farthest = maxDistance;
+            auto clip = [&nearest, &farthest](Extent<float> const& extent, float const origin,
+                                              float const inverseDirection) {
+                auto const t0 = (extent.min - origin) * inverseDirection;
+                auto const t1 = (extent.max - origin) * inverseDirection;
+                nearest = std::max(nearest, std::min(t0, t1));
+                farthest = std::min(farthest, std::max(t0, t1));
+            };
+            clip(box.x, origin.x, inverseDirection.x);
+            clip(box.y, origin.y, inverseDirection.y);
+            clip(box.z, origin.z, inverseDirection.z);
+            return nearest <= farthest ? nearest : std::numeric_limits<float>::infinity();
+        }
+
+        // Updates hit and returns true if the triangle is hit closer than hit.distance
+        static bool intersect(Triangle const& triangle, Vector3<float> const& origin, Vector3<float> const& direction,
+                              Hit& hit) {
+            kernels::RayTriangleHit<float> triangleHit{hit.distance, 0.f, 0.f};
+            if (!kernels::intersectRayTriangle(origin, direction, triangle.vertex, triangle.edge1, triangle.edge2,
+                                               triangleHit)) {
+                return false;
+            }
+            hit.distance = triangleHit.distance;
+            hit.barycentricCoordinates = triangleHit.getBarycentricCoordinates();
+            return true;
+        }
+
+        template<bool stopAtFirstHit>
+        std::optional<Hit> traverse(Vector3<float> const& origin, Vector3<float> const& direction,
+                                    float const maxDistance) const {
+            if (nodes.empty()) return std::nullopt;
+
+            Vector3<float> const inverseDirection{1.f / direction.x, 1.f / direction.y, 1.f / direction.z};
+            Hit hit{0, maxDistance, {}};
+            bool hasHit = false;
+
+            if (!(distanceToBox(nodes.front().bounds, origin, inverseDirection, maxDistance) < maxDistance)) {
+                return std::nullopt;
+            }
+
+            // Traversal descends into the nearer child of every node it visits and defers the farther one. Deferred
+            // nodes are stacked with their distance so that they can be skipped if a closer hit is found meanwhile
+            struct Entry {
+                unsigned node;
+                float distance;
+            };
+            std::array<Entry, maxDepth + 1> stack;
+            unsigned stackSize = 0;
+            unsigned nodeIndex = 0;
+            while (true) {
+                auto const& node = nodes[nodeIndex];
+                if (node.numberOfTriangles) {
+                    for (auto i = node.firstChildOrTriangle; i < node.firstChildOrTriangle + node.numberOfTriangles; ++i) {
+                        if (intersect(triangles[i], origin, direction, hit)) {
+                            hit.triangleIndex = triangleIndices[i];
+                            hasHit = true;
+                            if constexpr (stopAtFirstHit) return hit;
+                        }
+                    }
+                } else {
+                    auto nearChild = node.firstChildOrTriangle;
+                    auto farChild = nearChild + 1;
+                    auto nearDistance = distanceToBox(nodes[nearChild].bounds, origin, inverseDirection, hit.distance);
+                    auto farDistance = distanceToBox(nodes[farChild].bounds, origin, inverseDirection, hit.distance);
+                    if (farDistance < nearDistance) {
+                        std::swap(nearChild, farChild);
+                        std::swap(nearDistance, farDistance);
+                    }
+                    if (nearDistance < hit.distance) {
+                        if (farDistance < hit.distance) stack[stackSize++] = {farChild, farDistance};
+                        nodeIndex = nearChild;
+                        continue;
+                    }
+                }
+                // Resume at the most recently deferred node that is still closer than the nearest hit
+                while (stackSize && stack[stackSize - 1].distance >= hit.distance) --stackSize;
+                if (!stackSize) break;
+                nodeIndex = stack[--stackSize].node;
+            }
+            return hasHit ? std::optional{hit} : std::nullopt;
+        }
+
+        std::vector<Node> nodes;
+        std::vector<Triangle> triangles;
+        std::vector<unsigned> triangleIndices;
+    };
+
+}
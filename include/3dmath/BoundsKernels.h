@@ -0,0 +1,165 @@
+#pragma once
+
+#include "Batch.h"
+#include "MatrixKernels.h"
+#include "SupportingTypes.h"
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+// Minimum and maximum reductions over arrays of coordinates, and the bounds computations built on them. They use
+// vector registers and threads, so they live apart from Bounds3D. Include this header to call Bounds3D::fromPoints
+// or to add blocks of points to a BoundsAccumulator
+
+namespace math3d {
+
+    namespace batch {
+#ifdef MATH3D_SSE
+        // Vector registers used by the minimum/maximum kernels
+        template<typename T>
+        struct MinMaxRegister;
+
+        template<>
+        struct MinMaxRegister<float> {
+            using Type = __m128;
+            static constexpr size_t width = 4;
+            static Type broadcast(float const value) { return _mm_set1_ps(value); }
+            static Type load(float const* data) { return _mm_loadu_ps(data); }
+            static void store(float* data, Type const value) { _mm_storeu_ps(data, value); }
+            static Type min(Type const a, Type const b) { return _mm_min_ps(a, b); }
+            static Type max(Type const a, Type const b) { return _mm_max_ps(a, b); }
+        };
+
+        template<>
+        struct MinMaxRegister<double> {
+#ifdef MATH3D_AVX
+            using Type = __m256d;
+            static constexpr size_t width = 4;
+            static Type broadcast(double const value) { return _mm256_set1_pd(value); }
+            static Type load(double const* data) { return _mm256_loadu_pd(data); }
+            static void store(double* data, Type const value) { _mm256_storeu_pd(data, value); }
+            static Type min(Type const a, Type const b) { return _mm256_min_pd(a, b); }
+            static Type max(Type const a, Type const b) { return _mm256_max_pd(a, b); }
+#else
+            using Type = __m128d;
+            static constexpr size_t width = 2;
+            static Type broadcast(double const value) { return _mm_set1_pd(value); }
+            static Type load(double const* data) { return _mm_loadu_pd(data); }
+            static void store(double* data, Type const value) { _mm_storeu_pd(data, value); }
+            static Type min(Type const a, Type const b) { return _mm_min_pd(a, b); }
+            static Type max(Type const a, Type const b) { return _mm_max_pd(a, b); }
+#endif
+        };
+
+        template<typename T>
+        constexpr bool hasMinMaxRegister = std::is_same_v<T, float> || std::is_same_v<T, double>;
+#endif
+
+        // Update min and max with the values [begin, end) of an array
+        template<typename T>
+        void minMaxValues(T const* values, size_t begin, size_t const end, T& min, T& max) {
+#ifdef MATH3D_SSE
+            if constexpr (hasMinMaxRegister<T>) {
+                using Register = MinMaxRegister<T>;
+                constexpr size_t width = Register::width;
+                auto minimum = Register::broadcast(min);
+                auto maximum = Register::broadcast(max);
+                for (; begin + width <= end; begin += width) {
+                    auto const group = Register::load(values + begin);
+                    minimum = Register::min(minimum, group);
+                    maximum = Register::max(maximum, group);
+                }
+                T minimumLanes[width], maximumLanes[width];
+                Register::store(minimumLanes, minimum);
+                Register::store(maximumLanes, maximum);
+                for (size_t lane = 0; lane < width; ++lane) {
+                    min = std::min(min, minimumLanes[lane]);
+                    max = std::max(max, maximumLanes[lane]);
+                }
+            }
+#endif
+            for (; begin < end; ++begin) {
+                min = std::min(min, values[begin]);
+                max = std::max(max, values[begin]);
+            }
+        }
+
+        // Update min and max with the points [begin, end) of an array of interleaved [x y z] triples
+        template<typename T>
+        void minMaxTriples(T const* points, size_t begin, size_t const end,
+                           std::array<T, 3>& min, std::array<T, 3>& max) {
+#ifdef MATH3D_SSE
+            if constexpr (hasMinMaxRegister<T>) {
+                // A group of width points fills three registers, and lane i of the group always holds coordinate
+                // i % 3. Lane-wise minimums and maximums can therefore be reduced to coordinate-wise ones at the end
+                using Register = MinMaxRegister<T>;
+                constexpr size_t width = Register::width;
+                typename Register::Type minimum[3], maximum[3];
+                for (size_t i = 0; i < 3; ++i) {
+                    minimum[i] = Register::broadcast(std::numeric_limits<T>::max());
+                    maximum[i] = Register::broadcast(std::numeric_limits<T>::lowest());
+                }
+                for (; begin + width <= end; begin += width) {
+                    for (size_t i = 0; i < 3; ++i) {
+                        auto const group = Register::load(points + begin * 3 + i * width);
+                        minimum[i] = Register::min(minimum[i], group);
+                        maximum[i] = Register::max(maximum[i], group);
+                    }
+                }
+                T minimumLanes[3 * width], maximumLanes[3 * width];
+                for (size_t i = 0; i < 3; ++i) {
+                    Register::store(minimumLanes + i * width, minimum[i]);
+                    Register::store(maximumLanes + i * width, maximum[i]);
+                }
+                for (size_t lane = 0; lane < 3 * width; ++lane) {
+                    min[lane % 3] = std::min(min[lane % 3], minimumLanes[lane]);
+                    max[lane % 3] = std::max(max[lane % 3], maximumLanes[lane]);
+                }
+            }
+#endif
+            for (; begin < end; ++begin) {
+                for (size_t i = 0; i < 3; ++i) {
+                    min[i] = std::min(min[i], points[begin * 3 + i]);
+                    max[i] = std::max(max[i], points[begin * 3 + i]);
+                }
+            }
+        }
+    }
+
+    template<typename T>
+    Bounds3D<T> Bounds3D<T>::fromPoints(Points<T const> points, Execution const execution) {
+        if (points.empty()) return {};
+        // Vector3 is laid out as three contiguous elements, so arrays of vectors are arrays of triples
+        T const* data = points.front().getData();
+        return batch::reduceRanges(points.size(), execution, Bounds3D{},
+            [data](size_t const begin, size_t const end) {
+                std::array<T, 3> min, max;
+                min.fill(std::numeric_limits<T>::max());
+                max.fill(std::numeric_limits<T>::lowest());
+                batch::minMaxTriples(data, begin, end, min, max);
+                return Bounds3D(Extent<T>{min[0], max[0]}, Extent<T>{min[1], max[1]}, Extent<T>{min[2], max[2]});
+            },
+            [](Bounds3D& result, Bounds3D const& partialResult) { result.merge(partialResult); });
+    }
+
+    template<typename T>
+    Bounds3D<T> Bounds3D<T>::fromPoints(Coordinates<T const> points, Execution const execution) {
+        if (points.y.size() != points.size() || points.z.size() != points.size()) {
+            throw std::invalid_argument("Coordinate arrays should all be of the same size");
+        }
+        if (points.size() == 0) return {};
+        return batch::reduceRanges(points.size(), execution, Bounds3D{},
+            [points](size_t const begin, size_t const end) {
+                Bounds3D bounds;
+                bounds.x = {std::numeric_limits<T>::max(), std::numeric_limits<T>::lowest()};
+                bounds.y = bounds.z = bounds.x;
+                batch::minMaxValues(points.x.data(), begin, end, bounds.x.min, bounds.x.max);
+                batch::minMaxValues(points.y.data(), begin, end, bounds.y.min, bounds.y.max);
+                batch::minMaxValues(points.z.data(), begin, end, bounds.z.min, bounds.z.max);
+                return bounds;
+            },
+            [](Bounds3D& result, Bounds3D const& partialResult) { result.merge(partialResult); });
+    }
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "Matrix.h"
+#include "Vector.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+namespace math3d {
+
+    // Cholesky decomposition of a symmetric positive definite matrix, A = L L^T, where L is lower triangular with a
+    // positive diagonal
+    //
+    // Factoring takes about N^3 / 6 multiply-adds, half as many as an LU decomposition, and needs no pivoting, so it is
+    // the decomposition of choice for the normal equations of least squares fits, covariance and stiffness matrices.
+    // Only the lower triangle of the matrix is read. A matrix that isn't positive definite is reported by
+    // isPositiveDefinite() rather than by an exception, since checking definiteness is a use of its own.
+    //
+    // L is stored in the lower triangle of a column-major matrix, in MatrixStorage, so nothing is allocated unless the
+    // matrix is too large to be stored inline.
+    template<typename DataType, unsigned N>
+    class CholeskyDecomposition {
+        static_assert(std::is_floating_point_v<DataType>, "Data type must be floating point");
+
+    public:
+        explicit CholeskyDecomposition(Matrix<DataType, N, N> const& matrix) {
+            std::copy_n(matrix.getData(), N * N, factor.get());
+            decompose();
+        }
+
+        // A matrix is positive definite if every pivot is positive and not negligible relative to the diagonal of
+        // the matrix. Solving with a matrix that isn't positive definite throws
+        [[nodiscard]]
+        bool isPositiveDefinite() const {
+            return positiveDefinite;
+        }
+
+        [[nodiscard]]
+        Vector<DataType, N> solve(Vector<DataType, N> const& rightHandSide) const {
+            validateSolvable();
+            Vector<DataType, N> solution = rightHandSide;
+            substitute(solution.getData());
+            return solution;
+        }
+
+        // Solve for every column of the right-hand side matrix
+        template<unsigned numRightHandSides>
+        [[nodiscard]]
+        Matrix<DataType, N, numRightHandSides>
+        solve(Matrix<DataType, N, numRightHandSides> const& rightHandSides) const {
+            validateSolvable();
+            Matrix<DataType, N, numRightHandSides> solutions = rightHandSides;
+            auto* solutionData = const_cast<DataType*>(solutions.getData());
+            for (unsigned col = 0; col < numRightHandSides; ++col) {
+                substitute(solutionData + col * N);
+            }
+            return solutions;
+        }
+
+        // Product of the squared diagonal of L. Throws if the matrix isn't positive definite, since L is then only
+        // partially computed
+        [[nodiscard]]
+        DataType determinant() const {
+            validateSolvable();
+            DataType result = 1;
+            for (unsigned i = 0; i < N; ++i) {
+                result *= factor[i * N + i] * factor[i * N + i];
+            }
+            return result;
+        }
+
+        // Throws if the matrix isn't positive definite
+        [[nodiscard]]
+        Matrix<DataType, N, N> getLower() const {
+            validateSolvable();
+            Matrix<DataType, N, N> lower;
+            for (unsigned col = 0; col < N; ++col) {
+                for (unsigned row = col; row < N; ++row) {
+                    lower(row, col) = factor[col * N + row];
+                }
+            }
+            return lower;
+        }
+
+    private:
+        // Left-looking factorization: column k of L is column k of A minus the contributions of the columns to its
+        // left, divided by the square root of its diagonal element
+        void decompose() {
+            DataType* l = factor.get();
+            DataType largestDiagonal {};
+            for (unsigned i = 0; i < N; ++i) {
+                largestDiagonal = std::max(largestDiagonal, std::fabs(l[i * N + i]));
+            }
+            auto const negligible = std::numeric_limits<DataType>::epsilon() * N * largestDiagonal;
+
+            for (unsigned k = 0; k < N; ++k) {
+                DataType* column = l + k * N;
+                for (unsigned j = 0; j < k; ++j) {
+                    DataType const* previousColumn = l + j * N;
+                    DataType const scale = previousColumn[k];
+                    for (unsigned row = k; row < N; ++row) {
+                        column[row] -= previousColumn[row] * scale;
+                    }
+                }
+                if (!(column[k] > negligible)) {
+                    positiveDefinite = false;
+                    return;
+                }
+                DataType const diagonal = std::sqrt(column[k]);
+                DataType const inverseDiagonal = 1 / diagonal;
+                column[k] = diagonal;
+                for (unsigned row = k + 1; row < N; ++row) {
+                    column[row] *= inverseDiagonal;
+                }
+            }
+            // Clear the upper triangle, which held A, so that L can be read off directly
+            for (unsigned col = 1; col < N; ++col) {
+                std::fill_n(l + col * N, col, DataType{});
+            }
+        }
+
+        void validateSolvable() const {
+            if (!positiveDefinite) {
+                throw std::runtime_error("Matrix is not positive definite");
+            }
+        }
+
+        // Solve Ly = x and then L^T x = y in place
+        void substitute(DataType* x) const {
+            DataType const* l = factor.get();
+            for (unsigned col = 0; col < N; ++col) {
+                DataType const* column = l + col * N;
+                x[col] /= column[col];
+                for (unsigned row = col + 1; row < N; ++row) {
+                    x[row] -= column[row] * x[col];
+                }
+            }
+            // Row k of L^T is column k of L, so the backward substitution reads contiguous elements too
+            for (unsigned k = N; k-- > 0;) {
+                DataType const* column = l + k * N;
+                DataType sum = x[k];
+                for (unsigned row = k + 1; row < N; ++row) {
+                    sum -= column[row] * x[row];
+                }
+                x[k] = sum / column[k];
+            }
+        }
+
+        MatrixStorage<DataType, N * N> factor;
+        bool positiveDefinite = true;
+    };
+}
@@ -0,0 +1,321 @@
+#pragma once
+
+#include "Batch.h"
+#include "Matrix.h"
+#include "MatrixProductKernels.h"
+#include <algorithm>
+#include <cmath>
+#include <initializer_list>
+#include <iomanip>
+#include <ostream>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Dense matrices whose dimensions are only known at run time, for problems such as least squares fits with hundreds or
+// thousands of unknowns, for which a Matrix instantiation per size isn't practical.
+//
+// Elements are stored contiguously in column-major order, like the elements of Matrix, so fixed-size blocks can be
+// copied in and out column by column. Products use the cache-blocked kernels in MatrixProductKernels.h and can be split
+// across threads.
+
+namespace math3d {
+
+template<typename DataType>
+class DynamicMatrix {
+
+    static_assert(std::is_integral_v<DataType> ||
+        std::is_floating_point_v<DataType>, "Matrix elements should be of fundamental type");
+
+    public:
+        using ValueType = DataType;
+
+        // An empty matrix
+        DynamicMatrix() = default;
+
+        // Zero-initialized matrix
+        DynamicMatrix(unsigned const numRows, unsigned const numCols)
+        : numRows(numRows)
+        , numCols(numCols)
+        , data(size_t{numRows} * numCols) {
+        }
+
+        // Construction via an initializer list of rows, or of columns if the order is column major. See Matrix
+        DynamicMatrix(std::initializer_list<std::initializer_list<DataType>> const& initList,
+                      Order const& order = Order::RowMajor) {
+            auto const numLists = static_cast<unsigned>(initList.size());
+            auto const listSize = numLists == 0 ? 0u : static_cast<unsigned>(initList.begin()->size());
+            for (unsigned list = 0; list < numLists; ++list) {
+                if (std::data(initList)[list].size() != listSize) {
+                    throw std::invalid_argument(
+                        "Incompatible dimensions: " + std::string(order == Order::RowMajor ? "Row " : "Column ") +
+                        std::to_string(list + 1) + " has " + std::to_string(std::data(initList)[list].size()) +
+                        " elements instead of " + std::to_string(listSize));
+                }
+            }
+            *this = order == Order::RowMajor ? DynamicMatrix(numLists, listSize) : DynamicMatrix(listSize, numLists);
+            for (unsigned list = 0; list < numLists; ++list) {
+                for (unsigned i = 0; i < listSize; ++i) {
+                    auto const value = std::data(std::data(initList)[list])[i];
+                    if (order == Order::RowMajor) {
+                        (*this)(list, i) = value;
+                    } else {
+                        (*this)(i, list) = value;
+                    }
+                }
+            }
+        }
+
+        // Copy of a fixed-size matrix
+        template<unsigned numMatrixRows, unsigned numMatrixCols>
+        explicit DynamicMatrix(Matrix<DataType, numMatrixRows, numMatrixCols> const& matrix)
+        : DynamicMatrix(numMatrixRows, numMatrixCols) {
+            std::copy_n(matrix.getData(), data.size(), data.data());
+        }
+
+        static DynamicMatrix identity(unsigned const size) {
+            DynamicMatrix result(size, size);
+            for (unsigned i = 0; i < size; ++i) {
+                result(i, i) = 1;
+            }
+            return result;
+        }
+
+        [[nodiscard]]
+        unsigned getNumberOfRows() const {
+            return numRows;
+        }
+
+        [[nodiscard]]
+        unsigned getNumberOfColumns() const {
+            return numCols;
+        }
+
+        [[nodiscard]]
+        DataType const* getData() const {
+            return data.data();
+        }
+
+        [[nodiscard]]
+        DataType* getData() {
+            return data.data();
+        }
+
+        // Element access operators do not validate indices unless the library is built with MATH3D_BOUNDS_CHECKS. Use
+        // at() for element access that is always validated
+        DataType& operator()(unsigned const rowIndex, unsigned const columnIndex) {
+#ifdef MATH3D_BOUNDS_CHECKS
+            validateElementAccess(rowIndex, columnIndex);
+#endif
+            return data[size_t{columnIndex} * numRows + rowIndex];
+        }
+
+        DataType const& operator()(unsigned const rowIndex, unsigned const columnIndex) const {
+#ifdef MATH3D_BOUNDS_CHECKS
+            validateElementAccess(rowIndex, columnIndex);
+#endif
+            return data[size_t{columnIndex} * numRows + rowIndex];
+        }
+
+        // Element access that throws std::runtime_error if the row or the column index is out of bounds
+        DataType& at(unsigned const rowIndex, unsigned const columnIndex) {
+            validateElementAccess(rowIndex, columnIndex);
+            return data[size_t{columnIndex} * numRows + rowIndex];
+        }
+
+        DataType const& at(unsigned const rowIndex, unsigned const columnIndex) const {
+            validateElementAccess(rowIndex, columnIndex);
+            return data[size_t{columnIndex} * numRows + rowIndex];
+        }
+
+        // Elements of a column, which are contiguous
+        std::span<DataType> getColumn(unsigned const columnIndex) {
+            validateElementAccess(0, columnIndex);
+            return {data.data() + size_t{columnIndex} * numRows, numRows};
+        }
+
+        std::span<DataType const> getColumn(unsigned const columnIndex) const {
+            validateElementAccess(0, columnIndex);
+            return {data.data() + size_t{columnIndex} * numRows, numRows};
+        }
+
+        // Copy the block of blockRows x blockCols elements whose top-left element is at the given row and column
+        // into a fixed-size matrix
+        template<unsigned blockRows, unsigned blockCols>
+        [[nodiscard]]
+        Matrix<DataType, blockRows, blockCols> getBlock(unsigned const startingRow = 0,
+                                                        unsigned const startingColumn = 0) const {
+            validateBlock(startingRow, startingColumn, blockRows, blockCols);
+            Matrix<DataType, blockRows, blockCols> block;
+            auto* blockData = const_cast<DataType*>(block.getData());
+            for (unsigned col = 0; col < blockCols; ++col) {
+                std::copy_n(data.data() + size_t{startingColumn + col} * numRows + startingRow, blockRows,
+                            blockData + col * blockRows);
+            }
+            return block;
+        }
+
+        // Overwrite the block whose top-left element is at the given row and column with a fixed-size matrix
+        template<unsigned blockRows, unsigned blockCols>
+        void setBlock(unsigned const startingRow, unsigned const startingColumn,
+                      Matrix<DataType, blockRows, blockCols> const& block) {
+            validateBlock(startingRow, startingColumn, blockRows, blockCols);
+            for (unsigned col = 0; col < blockCols; ++col) {
+                std::copy_n(block.getData() + col * blockRows, blockRows,
+                            data.data() + size_t{startingColumn + col} * numRows + startingRow);
+            }
+        }
+
+        // Transposition copies square tiles so that both the reads and the writes of a tile stay in the cache
+        [[nodiscard]]
+        DynamicMatrix transpose() const {
+            constexpr unsigned tileSize = 32;
+            DynamicMatrix result(numCols, numRows);
+            for (unsigned colTile = 0; colTile < numCols; colTile += tileSize) {
+                for (unsigned rowTile = 0; rowTile < numRows; rowTile += tileSize) {
+                    for (unsigned col = colTile; col < std::min(colTile + tileSize, numCols); ++col) {
+                        for (unsigned row = rowTile; row < std::min(rowTile + tileSize, numRows); ++row) {
+                            result.data[size_t{row} * numCols + col] = data[size_t{col} * numRows + row];
+                        }
+                    }
+                }
+            }
+            return result;
+        }
+
+        // Matrix multiplication. Large products are computed faster on several threads with multiply()
+        [[nodiscard]]
+        DynamicMatrix operator*(DynamicMatrix const& another) const {
+            return multiply(another, Execution::Sequential);
+        }
+
+        [[nodiscard]]
+        DynamicMatrix multiply(DynamicMatrix const& another, Execution const execution) const {
+            if (numCols != another.numRows) {
+                throw std::invalid_argument("Incompatible dimensions: A " + dimensions() + " matrix can't be " +
+                                            "multiplied by a " + another.dimensions() + " matrix");
+            }
+            DynamicMatrix result(numRows, another.numCols);
+            kernels::multiplyBlocked(data.data(), numRows, another.data.data(), another.numRows, result.data.data(),
+                                     result.numRows, numRows, numCols, another.numCols, execution);
+            return result;
+        }
+
+        // Vector multiplication. The result is a linear combination of the columns of this matrix
+        [[nodiscard]]
+        std::vector<DataType> operator*(std::span<DataType const> const inputVector) const {
+            if (inputVector.size() != numCols) {
+                throw std::invalid_argument("Incompatible dimensions: A " + dimensions() + " matrix can't be " +
+                                            "multiplied by a vector of size " + std::to_string(inputVector.size()));
+            }
+            std::vector<DataType> outputVector(numRows);
+            for (unsigned col = 0; col < numCols; ++col) {
+                DataType const* column = data.data() + size_t{col} * numRows;
+                DataType const scale = inputVector[col];
+                for (unsigned row = 0; row < numRows; ++row) {
+                    outputVector[row] += column[row] * scale;
+                }
+            }
+            return outputVector;
+        }
+
+        // Element-wise arithmetic
+        DynamicMatrix& operator+=(DynamicMatrix const& another) {
+            validateSameDimensions(another);
+            for (size_t i = 0; i < data.size(); ++i) data[i] += another.data[i];
+            return *this;
+        }
+
+        DynamicMatrix& operator-=(DynamicMatrix const& another) {
+            validateSameDimensions(another);
+            for (size_t i = 0; i < data.size(); ++i) data[i] -= another.data[i];
+            return *this;
+        }
+
+        DynamicMatrix& operator*=(DataType const scalar) {
+            for (auto& element : data) element *= scalar;
+            return *this;
+        }
+
+        [[nodiscard]]
+        DynamicMatrix operator+(DynamicMatrix const& another) const {
+            return DynamicMatrix(*this) += another;
+        }
+
+        [[nodiscard]]
+        DynamicMatrix operator-(DynamicMatrix const& another) const {
+            return DynamicMatrix(*this) -= another;
+        }
+
+        [[nodiscard]]
+        DynamicMatrix operator*(DataType const scalar) const {
+            return DynamicMatrix(*this) *= scalar;
+        }
+
+        [[nodiscard]]
+        friend DynamicMatrix operator*(DataType const scalar, DynamicMatrix const& matrix) {
+            return matrix * scalar;
+        }
+
+        // Print column major matrix data in row order format
+        void print(std::ostream& os, float zero = 1e-3) const {
+            for (unsigned row = 0; row < numRows; ++row) {
+                for (unsigned col = 0; col < numCols; ++col) {
+                    auto val = (*this)(row, col);
+                    if (std::fabs(val) <= zero) {
+                        val = 0;
+                    }
+                    os << std::setw(10) << std::setprecision(6) << val;
+                    if (col != numCols - 1) os << ' ';
+                }
+                os << std::endl;
+            }
+        }
+
+        [[nodiscard]]
+        std::string asString() const {
+            std::stringstream stringStream;
+            print(stringStream);
+            return stringStream.str();
+        }
+
+    private:
+        [[nodiscard]]
+        std::string dimensions() const {
+            return std::to_string(numRows) + 'x' + std::to_string(numCols);
+        }
+
+        void validateElementAccess(unsigned const rowIndex, unsigned const columnIndex) const {
+            if (rowIndex >= numRows || columnIndex >= numCols) [[unlikely]] {
+                throw std::runtime_error("Invalid access: [" + std::to_string(rowIndex) + ',' +
+                                         std::to_string(columnIndex) + "] is not a valid element of a " +
+                                         dimensions() + " matrix");
+            }
+        }
+
+        void validateBlock(unsigned const startingRow, unsigned const startingColumn,
+                           unsigned const blockRows, unsigned const blockCols) const {
+            if (size_t{startingRow} + blockRows > numRows || size_t{startingColumn} + blockCols > numCols) {
+                throw std::runtime_error("Invalid block: A " + std::to_string(blockRows) + 'x' +
+                                         std::to_string(blockCols) + " block at [" + std::to_string(startingRow) +
+                                         ',' + std::to_string(startingColumn) + "] doesn't fit in a " +
+                                         dimensions() + " matrix");
+            }
+        }
+
+        void validateSameDimensions(DynamicMatrix const& another) const {
+            if (numRows != another.numRows || numCols != another.numCols) {
+                throw std::invalid_argument("Incompatible dimensions: " + dimensions() + " and " +
+                                            another.dimensions() + " matrices can't be combined element-wise");
+            }
+        }
+
+        unsigned numRows = 0;
+        unsigned numCols = 0;
+        std::vector<DataType> data;
+};
+
+}
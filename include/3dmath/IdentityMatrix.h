@@ -8,7 +8,7 @@ class IdentityMatrix : public Matrix<DataType, numRows, numCols> {
 protected:
     using Matrix<DataType, numRows, numCols>::data;
 public:
-    IdentityMatrix() {
+    constexpr IdentityMatrix() {
         for (size_t col = 0; col < numCols; ++col) {
             for (size_t row = 0; row < numRows; ++row) {
                 if (row == col) {
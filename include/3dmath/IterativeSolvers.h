@@ -0,0 +1,369 @@
+#pragma once
+
+#include "Batch.h"
+#include "SparseMatrix.h"
+#include "Vector.h"
+#include <algorithm>
+#include <cmath>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Iterative solvers for large sparse systems Ax = b, such as mesh smoothing and finite element systems with tens of
+// thousands of unknowns, which are too large for Gaussian elimination on a dense matrix
+//
+// Conjugate gradients solves symmetric positive definite systems and BiCGSTAB solves general systems. Both start from
+// the initial guess in x and iterate until the residual ||b - Ax|| is small relative to ||b||. An iteration costs a
+// product with the matrix and a few vector operations, so memory and time per iteration scale with the number of
+// non-zeros. Preconditioning reduces the number of iterations:
+//
+// Jacobi divides by the diagonal of A. It is cheap and parallelizes like the vector operations.
+// Incomplete Cholesky (IC0) factors A ~ L L^T, where L has the sparsity pattern of the lower triangle of A. It takes
+// far fewer iterations than Jacobi on Laplacian-like systems, but its triangular solves are sequential.
+//
+// With Execution::Parallel, products and vector operations of large systems are split across threads. Dot products sum
+// the partial sums of the threads in a fixed order, so results don't depend on thread timing.
+
+namespace math3d {
+
+    enum class Preconditioner {
+        None,
+        Jacobi,
+        IncompleteCholesky
+    };
+
+    struct IterativeSolverSettings {
+        // Iteration stops when ||b - Ax|| <= tolerance * ||b||
+        double tolerance = 1e-8;
+        unsigned maximumIterations = 1000;
+        Preconditioner preconditioner = Preconditioner::Jacobi;
+        Execution execution = Execution::Sequential;
+    };
+
+    struct IterativeSolverResult {
+        bool converged;
+        unsigned iterations;
+        // ||b - Ax|| / ||b|| of the last iterate
+        double relativeResidual;
+    };
+
+    namespace iterative {
+
+        // Sums are accumulated in at least double precision
+        template<typename DataType>
+        using Accumulator = std::common_type_t<DataType, double>;
+
+        template<typename DataType>
+        Accumulator<DataType> dot(std::span<DataType const> const a, std::span<DataType const> const b,
+                                  Execution const execution) {
+            using Sum = Accumulator<DataType>;
+            using PartialSums = std::vector<std::pair<size_t, Sum>>;
+            auto partialSums = batch::reduceRanges(a.size(), execution, PartialSums{},
+                [&](size_t const begin, size_t const end) {
+                    Sum sum {};
+                    for (auto i = begin; i < end; ++i) {
+                        sum += static_cast<Sum>(a[i]) * b[i];
+                    }
+                    return std::pair{begin, sum};
+                },
+                [](PartialSums& sums, std::pair<size_t, Sum> const& partialSum) { sums.push_back(partialSum); });
+            std::sort(partialSums.begin(), partialSums.end());
+            Sum sum {};
+            for (auto const& partialSum : partialSums) {
+                sum += partialSum.second;
+            }
+            return sum;
+        }
+
+        template<typename DataType>
+        Accumulator<DataType> norm(std::span<DataType const> const a, Execution const execution) {
+            return std::sqrt(dot(a, a, execution));
+        }
+
+        // result[i] = kernel(i) for every element
+        template<typename DataType, typename Kernel>
+        void forEachElement(std::span<DataType> const result, Execution const execution, Kernel&& kernel) {
+            batch::forEachRange(result.size(), execution, [&](size_t const begin, size_t const end) {
+                for (auto i = begin; i < end; ++i) {
+                    result[i] = kernel(i);
+                }
+            });
+        }
+
+        // z = inverse(M) r, where M approximates A
+        template<typename DataType>
+        class PreconditionerOperator {
+        public:
+            PreconditionerOperator(SparseMatrix<DataType> const& matrix, Preconditioner const preconditioner)
+            : preconditioner(preconditioner) {
+                if (preconditioner == Preconditioner::Jacobi) {
+                    inverseDiagonal = matrix.getDiagonal();
+                    for (unsigned row = 0; row < inverseDiagonal.size(); ++row) {
+                        if (inverseDiagonal[row] == 0) {
+                            throw std::runtime_error("Jacobi preconditioning needs a non-zero diagonal. Element [" +
+                                                     std::to_string(row) + ',' + std::to_string(row) + "] is zero");
+                        }
+                        inverseDiagonal[row] = 1 / inverseDiagonal[row];
+                    }
+                } else if (preconditioner == Preconditioner::IncompleteCholesky) {
+                    factorIncompleteCholesky(matrix);
+                }
+            }
+
+            void apply(std::span<DataType const> const r, std::span<DataType> const z,
+                       Execution const execution) const {
+                switch (preconditioner) {
+                    case Preconditioner::None:
+                        std::copy(r.begin(), r.end(), z.begin());
+                        break;
+                    case Preconditioner::Jacobi:
+                        forEachElement(z, execution, [&](size_t const i) { return inverseDiagonal[i] * r[i]; });
+                        break;
+                    case Preconditioner::IncompleteCholesky:
+                        substitute(r, z);
+                        break;
+                }
+            }
+
+        private:
+            // Rows of L are the lower triangles of the rows of A, with the diagonal last. Element (i, k) of L is
+            // (A(i, k) - sum_j<k L(i, j) L(k, j)) / L(k, k), where the sum runs over the columns that rows i and k of L
+            // have in common, and L(i, i) = sqrt(A(i, i) - sum_j<i L(i, j)^2)
+            void factorIncompleteCholesky(SparseMatrix<DataType> const& matrix) {
+                auto const numRows = matrix.getNumberOfRows();
+                auto const matrixOffsets = matrix.getRowOffsets();
+                auto const matrixColumns = matrix.getColumnIndices();
+                auto const matrixValues = matrix.getValues();
+                lowerOffsets.assign(size_t{numRows} + 1, 0);
+                for (unsigned row = 0; row < numRows; ++row) {
+                    auto const* const rowBegin = matrixColumns.data() + matrixOffsets[row];
+                    auto const* const rowEnd = matrixColumns.data() + matrixOffsets[row + 1];
+                    auto const lowerEnd = std::upper_bound(rowBegin, rowEnd, row);
+                    if (lowerEnd == rowBegin || *(lowerEnd - 1) != row) {
+                        throw std::runtime_error("Incomplete Cholesky factorization needs a diagonal element in " +
+                                                 std::string("every row. Row ") + std::to_string(row) + " has none");
+                    }
+                    lowerColumns.insert(lowerColumns.end(), rowBegin, lowerEnd);
+                    lowerValues.insert(lowerValues.end(), matrixValues.begin() + (rowBegin - matrixColumns.data()),
+                                       matrixValues.begin() + (lowerEnd - matrixColumns.data()));
+                    lowerOffsets[row + 1] = lowerColumns.size();
+                }
+
+                for (unsigned row = 0; row < numRows; ++row) {
+                    auto const rowBegin = lowerOffsets[row];
+                    auto const diagonal = lowerOffsets[row + 1] - 1;
+                    for (auto i = rowBegin; i < diagonal; ++i) {
+                        auto const k = lowerColumns[i];
+                        // Sparse dot product of rows row and k of L, over the columns left of k
+                        Accumulator<DataType> sum {};
+                        auto a = rowBegin;
+                        auto b = lowerOffsets[k];
+                        while (a < i && b < lowerOffsets[k + 1] - 1) {
+                            if (lowerColumns[a] < lowerColumns[b]) {
+                                ++a;
+                            } else if (lowerColumns[b] < lowerColumns[a]) {
+                                ++b;
+                            } else {
+                                sum += static_cast<Accumulator<DataType>>(lowerValues[a++]) * lowerValues[b++];
+                            }
+                        }
+                        lowerValues[i] = static_cast<DataType>((lowerValues[i] - sum) /
+                                                               lowerValues[lowerOffsets[k + 1] - 1]);
+                    }
+                    Accumulator<DataType> pivot = lowerValues[diagonal];
+                    for (auto i = rowBegin; i < diagonal; ++i) {
+                        pivot -= static_cast<Accumulator<DataType>>(lowerValues[i]) * lowerValues[i];
+                    }
+                    if (!(pivot > 0)) {
+                        throw std::runtime_error("Incomplete Cholesky factorization broke down at row " +
+                                                 std::to_string(row) + ". The matrix may not be positive definite");
+                    }
+                    lowerValues[diagonal] = static_cast<DataType>(std::sqrt(pivot));
+                }
+            }
+
+            // Solve L y = r by forward substitution, then L^T z = y by backward substitution. L^T isn't stored, so
+            // the backward substitution subtracts multiples of the rows of L, i.e. of the columns of L^T
+            void substitute(std::span<DataType const> const r, std::span<DataType> const z) const {
+                auto const numRows = lowerOffsets.size() - 1;
+                for (size_t row = 0; row < numRows; ++row) {
+                    auto const diagonal = lowerOffsets[row + 1] - 1;
+                    Accumulator<DataType> sum = r[row];
+                    for (auto i = lowerOffsets[row]; i < diagonal; ++i) {
+                        sum -= static_cast<Accumulator<DataType>>(lowerValues[i]) * z[lowerColumns[i]];
+                    }
+                    z[row] = static_cast<DataType>(sum / lowerValues[diagonal]);
+                }
+                for (auto row = numRows; row-- > 0;) {
+                    auto const diagonal = lowerOffsets[row + 1] - 1;
+                    z[row] /= lowerValues[diagonal];
+                    for (auto i = lowerOffsets[row]; i < diagonal; ++i) {
+                        z[lowerColumns[i]] -= lowerValues[i] * z[row];
+                    }
+                }
+            }
+
+            Preconditioner preconditioner;
+            std::vector<DataType> inverseDiagonal;
+            std::vector<size_t> lowerOffsets;
+            std::vector<unsigned> lowerColumns;
+            std::vector<DataType> lowerValues;
+        };
+
+        template<typename DataType>
+        void validateSystem(SparseMatrix<DataType> const& matrix, size_t const rightHandSideSize,
+                            size_t const solutionSize) {
+            if (matrix.getNumberOfRows() != matrix.getNumberOfColumns() ||
+                rightHandSideSize != matrix.getNumberOfRows() || solutionSize != matrix.getNumberOfRows()) {
+                throw std::invalid_argument("Incompatible dimensions: A system needs a square matrix and as many " +
+                                            std::string("right-hand side and solution elements as matrix rows. ") +
+                                            "The matrix is " + std::to_string(matrix.getNumberOfRows()) + 'x' +
+                                            std::to_string(matrix.getNumberOfColumns()) + ", the right-hand side " +
+                                            "has " + std::to_string(rightHandSideSize) + " elements and the " +
+                                            "solution has " + std::to_string(solutionSize));
+            }
+        }
+    }
+
+    // Solve a symmetric positive definite system by preconditioned conjugate gradients. x holds the initial guess,
+    // which may be zero, and is overwritten with the solution. Throws std::invalid_argument if the dimensions don't
+    // match and std::runtime_error if the preconditioner can't be built from the matrix
+    template<typename DataType>
+    IterativeSolverResult solveConjugateGradient(SparseMatrix<DataType> const& matrix,
+                                                 std::type_identity_t<std::span<DataType const>> const b,
+                                                 std::type_identity_t<std::span<DataType>> const x,
+                                                 IterativeSolverSettings const& settings = {}) {
+        using namespace iterative;
+        validateSystem(matrix, b.size(), x.size());
+        auto const execution = settings.execution;
+        auto const normB = norm(b, execution);
+        if (normB == 0) {
+            std::fill(x.begin(), x.end(), DataType{});
+            return {true, 0, 0};
+        }
+        PreconditionerOperator<DataType> const preconditioner(matrix, settings.preconditioner);
+
+        auto const size = b.size();
+        std::vector<DataType> r(size), z(size), p(size), q(size);
+        matrix.multiply(x, q, execution);
+        forEachElement<DataType>(r, execution, [&](size_t const i) { return b[i] - q[i]; });
+        preconditioner.apply(r, z, execution);
+        std::copy(z.begin(), z.end(), p.begin());
+        auto rz = dot<DataType>(r, z, execution);
+
+        IterativeSolverResult result {false, 0, norm<DataType>(r, execution) / normB};
+        while (result.relativeResidual > settings.tolerance && result.iterations < settings.maximumIterations) {
+            matrix.multiply(p, q, execution);
+            auto const pq = dot<DataType>(p, q, execution);
+            if (!(pq > 0)) {
+                // The matrix isn't positive definite, or the residual is already as small as rounding allows
+                return result;
+            }
+            auto const alpha = static_cast<DataType>(rz / pq);
+            forEachElement(x, execution, [&](size_t const i) { return x[i] + alpha * p[i]; });
+            forEachElement<DataType>(r, execution, [&](size_t const i) { return r[i] - alpha * q[i]; });
+            ++result.iterations;
+            result.relativeResidual = norm<DataType>(r, execution) / normB;
+
+            preconditioner.apply(r, z, execution);
+            auto const rzNext = dot<DataType>(r, z, execution);
+            auto const beta = static_cast<DataType>(rzNext / rz);
+            forEachElement<DataType>(p, execution, [&](size_t const i) { return z[i] + beta * p[i]; });
+            rz = rzNext;
+        }
+        result.converged = result.relativeResidual <= settings.tolerance;
+        return result;
+    }
+
+    // Solve a general square system by preconditioned BiCGSTAB (stabilized biconjugate gradients). x holds the initial
+    // guess and is overwritten with the solution. Incomplete Cholesky preconditioning needs a symmetric matrix, so only
+    // Jacobi preconditioning or none is accepted. Throws like solveConjugateGradient
+    template<typename DataType>
+    IterativeSolverResult solveBiconjugateGradientStabilized(SparseMatrix<DataType> const& matrix,
+                                                             std::type_identity_t<std::span<DataType const>> const b,
+                                                             std::type_identity_t<std::span<DataType>> const x,
+                                                             IterativeSolverSettings const& settings = {}) {
+        using namespace iterative;
+        if (settings.preconditioner == Preconditioner::IncompleteCholesky) {
+            throw std::invalid_argument("BiCGSTAB supports Jacobi preconditioning or none");
+        }
+        validateSystem(matrix, b.size(), x.size());
+        auto const execution = settings.execution;
+        auto const normB = norm(b, execution);
+        if (normB == 0) {
+            std::fill(x.begin(), x.end(), DataType{});
+            return {true, 0, 0};
+        }
+        PreconditionerOperator<DataType> const preconditioner(matrix, settings.preconditioner);
+
+        // The preconditioner is applied on the right, so r is the residual of the original system
+        auto const size = b.size();
+        std::vector<DataType> r(size), shadowResidual(size), p(size), v(size), preconditioned(size), t(size);
+        matrix.multiply(x, v, execution);
+        forEachElement<DataType>(r, execution, [&](size_t const i) { return b[i] - v[i]; });
+        std::copy(r.begin(), r.end(), shadowResidual.begin());
+        std::fill(v.begin(), v.end(), DataType{});
+
+        Accumulator<DataType> rho = 1, alpha = 1, omega = 1;
+        IterativeSolverResult result {false, 0, norm<DataType>(r, execution) / normB};
+        while (result.relativeResidual > settings.tolerance && result.iterations < settings.maximumIterations) {
+            auto const rhoNext = dot<DataType>(shadowResidual, r, execution);
+            if (rhoNext == 0 || omega == 0) {
+                // Breakdown. Restarting with a new shadow residual may get further
+                return result;
+            }
+            auto const beta = static_cast<DataType>((rhoNext / rho) * (alpha / omega));
+            auto const omegaStep = static_cast<DataType>(omega);
+            forEachElement<DataType>(p, execution, [&](size_t const i) {
+                return r[i] + beta * (p[i] - omegaStep * v[i]);
+            });
+            rho = rhoNext;
+
+            preconditioner.apply(p, preconditioned, execution);
+            matrix.multiply(preconditioned, v, execution);
+            auto const shadowV = dot<DataType>(shadowResidual, v, execution);
+            if (shadowV == 0) {
+                return result;
+            }
+            alpha = rho / shadowV;
+            auto const alphaStep = static_cast<DataType>(alpha);
+            forEachElement(x, execution, [&](size_t const i) { return x[i] + alphaStep * preconditioned[i]; });
+            // r becomes the intermediate residual s = r - alpha v
+            forEachElement<DataType>(r, execution, [&](size_t const i) { return r[i] - alphaStep * v[i]; });
+            ++result.iterations;
+            result.relativeResidual = norm<DataType>(r, execution) / normB;
+            if (result.relativeResidual <= settings.tolerance) {
+                break;
+            }
+
+            preconditioner.apply(r, preconditioned, execution);
+            matrix.multiply(preconditioned, t, execution);
+            auto const tt = dot<DataType>(t, t, execution);
+            omega = tt == 0 ? 0 : dot<DataType>(t, r, execution) / tt;
+            auto const omegaNext = static_cast<DataType>(omega);
+            forEachElement(x, execution, [&](size_t const i) { return x[i] + omegaNext * preconditioned[i]; });
+            forEachElement<DataType>(r, execution, [&](size_t const i) { return r[i] - omegaNext * t[i]; });
+            result.relativeResidual = norm<DataType>(r, execution) / normB;
+        }
+        result.converged = result.relativeResidual <= settings.tolerance;
+        return result;
+    }
+
+    // Overloads for systems whose right-hand side and solution are fixed-size vectors
+    template<typename DataType, unsigned N>
+    IterativeSolverResult solveConjugateGradient(SparseMatrix<DataType> const& matrix, Vector<DataType, N> const& b,
+                                                 Vector<DataType, N>& x, IterativeSolverSettings const& settings = {}) {
+        return solveConjugateGradient(matrix, std::span<DataType const>(b.getData(), N),
+                                      std::span<DataType>(x.getData(), N), settings);
+    }
+
+    template<typename DataType, unsigned N>
+    IterativeSolverResult solveBiconjugateGradientStabilized(SparseMatrix<DataType> const& matrix,
+                                                             Vector<DataType, N> const& b, Vector<DataType, N>& x,
+                                                             IterativeSolverSettings const& settings = {}) {
+        return solveBiconjugateGradientStabilized(matrix, std::span<DataType const>(b.getData(), N),
+                                                  std::span<DataType>(x.getData(), N), settings);
+    }
+}
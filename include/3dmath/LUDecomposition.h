@@ -0,0 +1,236 @@
+#pragma once
+
+#include "Batch.h"
+#include "Matrix.h"
+#include "Vector.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace math3d {
+
+    // LU decomposition with partial pivoting, PA = LU, where P is a row permutation, L is unit lower triangular and U is
+    // upper triangular
+    //
+    // Factoring costs O(N^3) and is done once. Every solve after that costs O(N^2), so a decomposition should be
+    // reused to solve many systems with the same coefficient matrix, where LinearSystem::solveLinearSystem would
+    // eliminate the whole matrix again for every right-hand side. The determinant is the signed product of the diagonal
+    // of U, and the inverse is solved for column by column.
+    //
+    // L and U share the storage of a single column-major matrix. L's unit diagonal isn't stored. Elimination updates
+    // the trailing matrix a column at a time, so the inner loops run over contiguous elements.
+    template<typename DataType, unsigned N>
+    class LUDecomposition {
+        static_assert(std::is_floating_point_v<DataType>, "Data type must be floating point");
+
+    public:
+        explicit LUDecomposition(Matrix<DataType, N, N> const& matrix) {
+            std::copy_n(matrix.getData(), N * N, factors.get());
+            for (unsigned row = 0; row < N; ++row) {
+                permutation[row] = row;
+            }
+            factor();
+        }
+
+        // A matrix is singular if a pivot is negligible relative to the magnitude of the matrix elements. Solving
+        // with a singular matrix throws
+        [[nodiscard]]
+        bool isSingular() const {
+            return singular;
+        }
+
+        [[nodiscard]]
+        Vector<DataType, N> solve(Vector<DataType, N> const& rightHandSide) const {
+            validateSolvable();
+            Vector<DataType, N> solution;
+            solve(rightHandSide.getData(), solution.getData());
+            return solution;
+        }
+
+        // Solve for every column of the right-hand side matrix
+        template<unsigned numRightHandSides>
+        [[nodiscard]]
+        Matrix<DataType, N, numRightHandSides> solve(Matrix<DataType, N, numRightHandSides> const& rightHandSides) const {
+            validateSolvable();
+            Matrix<DataType, N, numRightHandSides> solutions;
+            for (unsigned col = 0; col < numRightHandSides; ++col) {
+                Vector<DataType, N> solution;
+                solve(rightHandSides.getData() + col * N, solution.getData());
+                solutions[col] = solution;
+            }
+            return solutions;
+        }
+
+        // Solve for every right-hand side in turn or on separate threads. solutions must have as many elements as
+        // rightHandSides and may be the same array
+        void solve(std::span<Vector<DataType, N> const> rightHandSides, std::span<Vector<DataType, N>> solutions,
+                   Execution const execution = Execution::Sequential) const {
+            if (rightHandSides.size() != solutions.size()) {
+                throw std::invalid_argument("Number of right-hand sides and solutions are different. There are " +
+                                            std::to_string(rightHandSides.size()) + " right-hand sides and " +
+                                            std::to_string(solutions.size()) + " solutions");
+            }
+            validateSolvable();
+            // A solve takes about N^2 multiply-adds
+            batch::forEachRange(rightHandSides.size(), execution, [&](size_t const begin, size_t const end) {
+                for (auto i = begin; i < end; ++i) {
+                    std::array<DataType, N> permuted;
+                    for (unsigned row = 0; row < N; ++row) {
+                        permuted[row] = rightHandSides[i][permutation[row]];
+                    }
+                    substitute(permuted.data());
+                    std::copy_n(permuted.data(), N, solutions[i].getData());
+                }
+            }, std::max(batch::minimumElementsPerThread / (N * N), size_t{1}));
+        }
+
+        [[nodiscard]]
+        DataType determinant() const {
+            DataType result = numRowSwaps % 2 == 0 ? 1 : -1;
+            for (unsigned i = 0; i < N; ++i) {
+                result *= factors[i * N + i];
+            }
+            return result;
+        }
+
+        [[nodiscard]]
+        Matrix<DataType, N, N> inverse() const {
+            if (singular) {
+                throw std::runtime_error("Matrix is not invertible");
+            }
+            Matrix<DataType, N, N> result;
+            for (unsigned col = 0; col < N; ++col) {
+                // Column col of the inverse solves Ax = e_col, and P e_col has its one in the row that was swapped
+                // into row col's place
+                Vector<DataType, N> column;
+                for (unsigned row = 0; row < N; ++row) {
+                    column[row] = permutation[row] == col ? 1 : 0;
+                }
+                substitute(column.getData());
+                result[col] = column;
+            }
+            return result;
+        }
+
+        // Unit lower triangular factor
+        [[nodiscard]]
+        Matrix<DataType, N, N> getLower() const {
+            Matrix<DataType, N, N> lower;
+            for (unsigned col = 0; col < N; ++col) {
+                lower(col, col) = 1;
+                for (unsigned row = col + 1; row < N; ++row) {
+                    lower(row, col) = factors[col * N + row];
+                }
+            }
+            return lower;
+        }
+
+        // Upper triangular factor
+        [[nodiscard]]
+        Matrix<DataType, N, N> getUpper() const {
+            Matrix<DataType, N, N> upper;
+            for (unsigned col = 0; col < N; ++col) {
+                for (unsigned row = 0; row <= col; ++row) {
+                    upper(row, col) = factors[col * N + row];
+                }
+            }
+            return upper;
+        }
+
+        // Row i of PA is row permutation[i] of A
+        [[nodiscard]]
+        std::array<unsigned, N> const& getPermutation() const {
+            return permutation;
+        }
+
+    private:
+        void factor() {
+            DataType* lu = factors.get();
+            DataType largestElement {};
+            for (unsigned i = 0; i < N * N; ++i) {
+                largestElement = std::max(largestElement, std::fabs(lu[i]));
+            }
+            auto const negligible = std::numeric_limits<DataType>::epsilon() * N * largestElement;
+
+            for (unsigned k = 0; k < N; ++k) {
+                DataType* pivotColumn = lu + k * N;
+                unsigned pivotRow = k;
+                for (unsigned row = k + 1; row < N; ++row) {
+                    if (std::fabs(pivotColumn[row]) > std::fabs(pivotColumn[pivotRow])) {
+                        pivotRow = row;
+                    }
+                }
+                if (std::fabs(pivotColumn[pivotRow]) <= negligible) {
+                    // Nothing is left to eliminate in this column. The remaining columns are still factored so that
+                    // the determinant, which is zero or nearly so, can be computed
+                    singular = true;
+                    continue;
+                }
+                if (pivotRow != k) {
+                    for (unsigned col = 0; col < N; ++col) {
+                        std::swap(lu[col * N + k], lu[col * N + pivotRow]);
+                    }
+                    std::swap(permutation[k], permutation[pivotRow]);
+                    ++numRowSwaps;
+                }
+
+                // Multipliers replace the eliminated elements of the pivot column
+                DataType const inversePivot = 1 / pivotColumn[k];
+                for (unsigned row = k + 1; row < N; ++row) {
+                    pivotColumn[row] *= inversePivot;
+                }
+                // Subtract multiples of the pivot column from the columns of the trailing matrix
+                for (unsigned col = k + 1; col < N; ++col) {
+                    DataType* column = lu + col * N;
+                    DataType const scale = column[k];
+                    for (unsigned row = k + 1; row < N; ++row) {
+                        column[row] -= pivotColumn[row] * scale;
+                    }
+                }
+            }
+        }
+
+        void validateSolvable() const {
+            if (singular) {
+                throw std::runtime_error("System does not have a solution.");
+            }
+        }
+
+        // solution = inverse(A) * rightHandSide. solution may not alias rightHandSide
+        void solve(DataType const* rightHandSide, DataType* solution) const {
+            for (unsigned row = 0; row < N; ++row) {
+                solution[row] = rightHandSide[permutation[row]];
+            }
+            substitute(solution);
+        }
+
+        // Solve Ly = x and then Ux = y in place, where x has already been permuted. Both substitutions subtract
+        // multiples of a column of the factors at a time
+        void substitute(DataType* x) const {
+            DataType const* lu = factors.get();
+            for (unsigned col = 0; col < N; ++col) {
+                DataType const* column = lu + col * N;
+                for (unsigned row = col + 1; row < N; ++row) {
+                    x[row] -= column[row] * x[col];
+                }
+            }
+            for (unsigned col = N; col-- > 0;) {
+                DataType const* column = lu + col * N;
+                x[col] /= column[col];
+                for (unsigned row = 0; row < col; ++row) {
+                    x[row] -= column[row] * x[col];
+                }
+            }
+        }
+
+        MatrixStorage<DataType, N * N> factors;
+        std::array<unsigned, N> permutation;
+        unsigned numRowSwaps = 0;
+        bool singular = false;
+    };
+}
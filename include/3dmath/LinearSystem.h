@@ -11,7 +11,8 @@ namespace math3d {
     template<typename DataType, unsigned N>
     class LinearSystem {
     public:
-        // Solve a linear system with N equations with N unknowns
+        // Solve a linear system with N equations with N unknowns. The coefficient matrix is eliminated on every call.
+        // Factor it once with LUDecomposition to solve for many right-hand sides
         static Vector<DataType, N>
         solveLinearSystem(Matrix<DataType, N, N> const& coefficientMatrix,
                           Vector<DataType, N> const& solutionVector) {
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#define MATH3D_MMAP 1
+#endif
+
+namespace math3d {
+
+    // Read-only view of a file's contents. Where the platform supports it, the file is mapped into memory so that its
+    // pages are read on demand and parsed in place. Elsewhere the file is read into memory
+    class MappedFile {
+    public:
+        explicit MappedFile(std::filesystem::path const& file) {
+            auto const size = std::filesystem::file_size(file);
+            if (size == 0) return;
+#ifdef MATH3D_MMAP
+            auto const descriptor = ::open(file.c_str(), O_RDONLY);
+            if (descriptor < 0) {
+                throw std::runtime_error("Unable to open " + file.string());
+            }
+            auto* const mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+            // The mapping keeps the file open
+            ::close(descriptor);
+            if (mapping == MAP_FAILED) {
+                throw std::runtime_error("Unable to map " + file.string() + " into memory");
+            }
+            // Files are parsed from start to end
+            ::madvise(mapping, size, MADV_SEQUENTIAL);
+            contents = {static_cast<char const*>(mapping), size};
+#else
+            std::ifstream ifs(file, std::ios::binary);
+            if (!ifs) {
+                throw std::runtime_error("Unable to open " + file.string());
+            }
+            buffer.resize(size);
+            ifs.read(buffer.data(), static_cast<std::streamsize>(size));
+            if (!ifs) {
+                throw std::runtime_error("Unable to read " + file.string());
+            }
+            contents = buffer;
+#endif
+        }
+
+        MappedFile(MappedFile const&) = delete;
+        MappedFile& operator=(MappedFile const&) = delete;
+
+        ~MappedFile() {
+#ifdef MATH3D_MMAP
+            if (!contents.empty()) {
+                ::munmap(const_cast<char*>(contents.data()), contents.size());
+            }
+#endif
+        }
+
+        [[nodiscard]]
+        std::span<char const> getContents() const {
+            return contents;
+        }
+
+    private:
+        std::span<char const> contents;
+#ifndef MATH3D_MMAP
+        std::vector<char> buffer;
+#endif
+    };
+}
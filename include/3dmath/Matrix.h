@@ -7,10 +7,70 @@
 #include <sstream>
 #include <iomanip>
 #include <filesystem>
+#include <algorithm>
+#include <cstring>
+#include <span>
+#include <vector>
 #include "Vector.h"
+#include "MatrixKernels.h"
+
+// Matrices with up to this many elements store their elements inline. Larger matrices, which would otherwise
+// bloat the stack, allocate their elements on the heap. Define before including this header to change the limit
+#ifndef MATH3D_MATRIX_INLINE_STORAGE_LIMIT
+#define MATH3D_MATRIX_INLINE_STORAGE_LIMIT 256
+#endif
 
 namespace math3d {
 
+// Contiguous, zero-initialized element storage for a matrix
+template<typename DataType, unsigned size, bool isInline = (size <= MATH3D_MATRIX_INLINE_STORAGE_LIMIT)>
+class MatrixStorage {
+    public:
+        constexpr DataType* get() { return elements.data(); }
+        constexpr DataType const* get() const { return elements.data(); }
+        constexpr DataType& operator[](unsigned const index) { return elements[index]; }
+        constexpr DataType const& operator[](unsigned const index) const { return elements[index]; }
+
+    private:
+        // Align storage that is large enough to hold at least one SIMD register's worth of elements so that
+        // vectorized kernels can use aligned loads and stores
+        static constexpr size_t alignment = size * sizeof(DataType) >= 32 ? 32 :
+                                            size * sizeof(DataType) >= 16 ? 16 : alignof(DataType);
+        alignas(alignment) std::array<DataType, size> elements{};
+};
+
+template<typename DataType, unsigned size>
+class MatrixStorage<DataType, size, false> {
+    public:
+        MatrixStorage() : elements(std::make_unique<DataType[]>(size)) {}
+
+        MatrixStorage(MatrixStorage const& other) : elements(std::make_unique<DataType[]>(size)) {
+            std::copy_n(other.get(), size, get());
+        }
+
+        MatrixStorage& operator=(MatrixStorage const& other) {
+            if (this != &other) {
+                if (!elements) {
+                    elements = std::make_unique<DataType[]>(size);
+                }
+                std::copy_n(other.get(), size, get());
+            }
+            return *this;
+        }
+
+        MatrixStorage(MatrixStorage&&) noexcept = default;
+        MatrixStorage& operator=(MatrixStorage&&) noexcept = default;
+        ~MatrixStorage() = default;
+
+        DataType* get() { return elements.get(); }
+        DataType const* get() const { return elements.get(); }
+        DataType& operator[](unsigned const index) { return elements[index]; }
+        DataType const& operator[](unsigned const index) const { return elements[index]; }
+
+    private:
+        std::unique_ptr<DataType[]> elements;
+};
+
 // A column-major matrix that stores its elements in contiguous memory
 
 // By default, the implementation assumes that the input data passed to it
@@ -32,6 +92,10 @@ enum class Order {
     RowMajor
 };
 
+// Base class of lazily evaluated element-wise matrix expressions. Defined after Matrix
+template<typename Derived, typename DataType, unsigned numRows, unsigned numCols>
+class MatrixExpression;
+
 template<typename DataType, unsigned numRows, unsigned numCols>
 class Matrix {
 
@@ -39,10 +103,12 @@ class Matrix {
         std::is_floating_point_v<DataType>, "Matrix elements should be of fundamental type");
     
     public:
+        using ValueType = DataType;
+        static constexpr unsigned rows = numRows;
+        static constexpr unsigned columns = numCols;
 
         // Default construction. Elements of the new matrix will be zero-initialized
-        Matrix() : data(std::make_unique<DataType[]>(numRows * numCols)) {
-        }
+        Matrix() = default;
         
         // Construction via an initializer list of initializer lists 
         // Each sub-initializer defines a column or row of matrix data.
@@ -50,27 +116,18 @@ class Matrix {
         // If the order is column major, then each sub-initializer is
         // treated as a column of data otherwise the data is assumed
         // to be in the row major order
-        Matrix(std::initializer_list<std::initializer_list<DataType>> const& initList, Order const& order = Order::RowMajor) {
-            
-            // allocate memory
-            data = std::make_unique<DataType[]>(numRows * numCols);
-            
+        constexpr Matrix(std::initializer_list<std::initializer_list<DataType>> const& initList, Order const& order = Order::RowMajor) {
             // read and store data in data as per the format of the input data
             order == Order::ColumnMajor ? readColumnMajor(initList) : readRowMajor(initList);
         }
 
-        explicit Matrix(std::vector<std::vector<DataType>> const& input, Order const& order = Order::RowMajor) {
-            // allocate memory
-            data = std::make_unique<DataType[]>(numRows * numCols);
-
+        explicit constexpr Matrix(std::vector<std::vector<DataType>> const& input, Order const& order = Order::RowMajor) {
             // read and store data in data as per the format of the input data
             order == Order::ColumnMajor ? readColumnMajor(input) : readRowMajor(input);
         }
 
         // Construct with data from a 1D vector. This is useful to build minors and cofactors
-        explicit Matrix(std::vector<DataType> const& inputData, Order const& order = Order::RowMajor) {
-            // allocate memory
-            data = std::make_unique<DataType[]>(numRows * numCols);
+        explicit constexpr Matrix(std::vector<DataType> const& inputData, Order const& order = Order::RowMajor) {
             for (int i = 0; i < numRows; ++i) {
                 for (int j = 0; j < numCols; ++j) {
                     data[i * numRows + j] =
@@ -80,195 +137,201 @@ class Matrix {
             }
         }
         
-        // Copy construction 
-        Matrix(Matrix const& other) {
-            assign(other);
-        }
-        
-        // Copy assignment
-        Matrix& operator=(Matrix const& other) {
-            assign(other);
-            return *this;
-        }
-
-        // Move construction
-        Matrix(Matrix&& other)  noexcept {
-            data = std::move(other.data);
-        }
-        
-        // Move assignment
-        Matrix& operator=(Matrix&& other)  noexcept {
-            data = std::move(other.data);
+        // Copy and move construction and assignment copy or move the storage. Matrices with inline storage are
+        // trivially copyable
+        Matrix(Matrix const& other) = default;
+        Matrix& operator=(Matrix const& other) = default;
+        Matrix(Matrix&& other) noexcept = default;
+        Matrix& operator=(Matrix&& other) noexcept = default;
+        ~Matrix() = default;
+
+        // Evaluate an element-wise expression such as a + (s * b) - c in a single pass over the elements
+        template<typename Derived>
+        constexpr Matrix(MatrixExpression<Derived, DataType, numRows, numCols> const& expression) { // NOLINT: Implicit evaluation is intended
+            assign(static_cast<Derived const&>(expression));
+        }
+
+        template<typename Derived>
+        constexpr Matrix& operator=(MatrixExpression<Derived, DataType, numRows, numCols> const& expression) {
+            assign(static_cast<Derived const&>(expression));
             return *this;
         }
-        
-        // Destructor 
-        ~Matrix()  = default;
 
         // Conversion operator to get the data as const pointer. Useful for calling OpenGL functions that expect a
         // pointer with a matrix argument instead and have the matrix converted implicitly to a pointer
-        operator DataType const*() { // NOLINT: Implicit conversion is the point of defining this operator
+        constexpr operator DataType const*() { // NOLINT: Implicit conversion is the point of defining this operator
             return data.get();
         }
 
         // Vector multiplication
+        // 4x4 float and double matrices use the vectorized kernels in MatrixKernels.h, except in constant expressions
         [[nodiscard]]
-        auto operator*(Vector<DataType, numRows> const& inputVector) const {
+        constexpr auto operator*(Vector<DataType, numCols> const& inputVector) const {
             Vector<DataType, numRows> outputVector;
-            for (auto row = 0u; row < numRows; ++row) {
-                for (auto col = 0u; col < numCols; ++col) {
-                    outputVector[row] += data[col * numRows + row] * inputVector[col];
+            if constexpr (hasVectorizedProduct) {
+                if !consteval {
+                    kernels::multiply4x4Vector(data.get(), inputVector.getData(), outputVector.getData());
+                    return outputVector;
+                }
+            }
+            for (auto col = 0u; col < numCols; ++col) {
+                DataType const* column = data.get() + col * numRows;
+                DataType const scale = inputVector.getData()[col];
+                for (auto row = 0u; row < numRows; ++row) {
+                    outputVector.getData()[row] += column[row] * scale;
                 }
             }
             return outputVector;
         }
 
         // Matrix multiplication
+        // 4x4 float and double matrices use the vectorized kernels in MatrixKernels.h, except in constant expressions
         template<typename T, unsigned multiplierNumRows, unsigned multiplierNumCols>
         [[nodiscard]]
-        auto operator*(Matrix<T, multiplierNumRows, multiplierNumCols> const& another) const {
+        constexpr auto operator*(Matrix<T, multiplierNumRows, multiplierNumCols> const& another) const {
             static_assert(std::is_same<DataType, T>::value, "Matrix data types should be compatible");
             static_assert(numCols == multiplierNumRows, "Matrix dimensions are not compatible");
             Matrix<T, numRows, multiplierNumCols> result;
-            T* resultData = const_cast<T*>(result.operator const DataType *());
-            for (auto row = 0u; row < numRows; ++row) {
-                auto rowVector = this->operator()(row);
-                for (auto col = 0u; col < multiplierNumCols; ++col) {
-                    Vector<DataType, multiplierNumRows> columnVector = another[col];
-                    resultData[col * multiplierNumCols + row] = rowVector.dot(columnVector);
+            T* resultData = result.data.get();
+            T const* multiplierData = another.data.get();
+            if constexpr (hasVectorizedProduct && multiplierNumCols == 4) {
+                if !consteval {
+                    kernels::multiply4x4(data.get(), multiplierData, resultData);
+                    return result;
+                }
+            }
+            // Each column of the result is a linear combination of the columns of this matrix
+            for (auto col = 0u; col < multiplierNumCols; ++col) {
+                T* resultColumn = resultData + col * numRows;
+                for (auto k = 0u; k < numCols; ++k) {
+                    T const* column = data.get() + k * numRows;
+                    T const scale = multiplierData[col * multiplierNumRows + k];
+                    for (auto row = 0u; row < numRows; ++row) {
+                        resultColumn[row] += column[row] * scale;
+                    }
                 }
             }
             return result;
         }
 
         [[nodiscard]]
-        unsigned getNumberOfRows() const { //NOLINT: Ignore static member function suggestion
+        constexpr unsigned getNumberOfRows() const { //NOLINT: Ignore static member function suggestion
             return numRows;
         }
 
         [[nodiscard]]
-        unsigned getNumberOfColumns() const { //NOLINT: Ignore static member function suggestion
+        constexpr unsigned getNumberOfColumns() const { //NOLINT: Ignore static member function suggestion
             return numCols;
         }
 
         [[nodiscard]]
-        const DataType* getData() const {
+        constexpr const DataType* getData() const {
             return data.get();
         }
 
         // const version of conversion operator to get the data as const pointer
         [[nodiscard]]
-        operator const DataType*() const { // NOLINT: Conversion to pointer is the purpose of this method
+        constexpr operator const DataType*() const { // NOLINT: Conversion to pointer is the purpose of this method
             return data.get();
         }
 
+        // Reference to a column of a matrix. Column references are returned by the non-const column access operator
+        // and allow expressions of the form
+        // matrix[i] = columnVector
+        // or
+        // Vector<DataType, numRows> column = matrix[i]
+        // A column reference only holds a pointer to the first element of the column, so accessing columns does not
+        // modify any state in the matrix
+        class ColumnReference {
+            public:
+                constexpr ColumnReference& operator=(Vector<DataType, numRows> const& column) {
+                    std::copy_n(column.getData(), numRows, columnData);
+                    return *this;
+                }
+
+                constexpr ColumnReference& operator=(ColumnReference const& another) { // NOLINT: Assigns column contents
+                    std::copy_n(another.columnData, numRows, columnData);
+                    return *this;
+                }
+
+                constexpr operator Vector<DataType, numRows>() const { // NOLINT: Conversion to a vector is the purpose of this class
+                    Vector<DataType, numRows> result;
+                    std::copy_n(columnData, numRows, result.getData());
+                    return result;
+                }
+
+            private:
+                explicit constexpr ColumnReference(DataType* columnData) : columnData(columnData) {}
+                ColumnReference(ColumnReference const&) = default;
+                DataType* columnData;
+            friend Matrix;
+        };
+
+        // Column, row and element access operators do not validate indices unless the library is built with
+        // MATH3D_BOUNDS_CHECKS. Use at() for element access that is always validated
+
         // Column access
-        Vector<DataType, numRows> operator[](unsigned const index) const {
-            if (index >= numCols) {
-                throw std::runtime_error(
-                        "Matrix::operator[]() : Invalid access. " + std::to_string(index) + " is not a valid column"
-                        " index for a " + std::to_string(numRows) + 'x' + std::to_string(numCols) + " matrix");
-            }
+        constexpr Vector<DataType, numRows> operator[](unsigned const index) const {
+#ifdef MATH3D_BOUNDS_CHECKS
+            validateColumnAccess(index);
+#endif
             Vector<DataType, numRows> result;
-            for (unsigned i = 0; i < numRows; ++i) {
-                result[i] = data[index * numRows + i];
-            }
-            return result;
-        }
-
-        // Row access
-        Vector<DataType, numCols> operator()(unsigned const rowIndex) const {
-            Vector<DataType, numCols> result;
-            for (unsigned i = 0, index = rowIndex; i < numCols; ++i, index += numRows) {
-                result[i] = data[index];
-            }
+            std::copy_n(data.get() + index * numRows, numRows, result.getData());
             return result;
         }
 
-        // These two operators allow assignment expression of the form
+        // Column access for assignment expressions of the form
         // matrix[i] = columnVector
-        Matrix& operator[](unsigned const index) {
-            if (currentColumn != -1) {
-                throw std::runtime_error(
-                        "Matrix::operator[]() : Invalid access. Previous column access operation is still in progress");
-            }
-            if (index >= numCols) {
-                throw std::runtime_error(
-                        "Matrix::operator[]() : Invalid access. " + std::to_string(index) + " is not a valid column"
-                        " index for a " + std::to_string(numRows) + 'x' + std::to_string(numCols) + " matrix");
-            }
-            currentColumn = index;
-            return *this;
-        }
-
-        void operator=(Vector<DataType, numCols> const& vector) { // NOLINT: Specific use case to assign columns to matrix
-            if(currentColumn == -1) {
-                throw std::runtime_error("Invalid assignment. Check assignment expressions");
-            }
-            memcpy(data.get() + currentColumn * numCols, vector.getData(), numCols * sizeof(DataType));
-            currentColumn = -1;
+        constexpr ColumnReference operator[](unsigned const index) {
+#ifdef MATH3D_BOUNDS_CHECKS
+            validateColumnAccess(index);
+#endif
+            return ColumnReference{data.get() + index * numRows};
         }
 
-        // Conversion to vector
-        // Allows expression of the form Vector<DataType, numRows> column0 = Matrix[0]
-        operator Vector<DataType, numRows>() const { // NOLINT: Specific use case to assign columns to matrix
-            if(currentColumn == -1) {
-                throw std::runtime_error("Invalid conversion to vector. Check assignment expressions");
-            }
-            Vector<DataType, numRows> result;
-            for (unsigned i = 0, index = currentColumn * numRows; i < numRows; ++i) {
-                result[i] = data[index+i];
+        // Row access
+        constexpr Vector<DataType, numCols> operator()(unsigned const rowIndex) const {
+#ifdef MATH3D_BOUNDS_CHECKS
+            validateElementAccess(rowIndex, 0);
+#endif
+            Vector<DataType, numCols> result;
+            for (unsigned i = 0, index = rowIndex; i < numCols; ++i, index += numRows) {
+                result.getData()[i] = data[index];
             }
-            currentColumn = -1;
             return result;
         }
 
-        // Element access operators to allow assignment of individual elements in the form of expression
+        // Element access to allow assignment of individual elements in the form of expression
         // matrix(a, b) = c
-        Matrix& operator()(unsigned const rowIndex, unsigned const columnIndex) {
+        constexpr DataType& operator()(unsigned const rowIndex, unsigned const columnIndex) {
+#ifdef MATH3D_BOUNDS_CHECKS
             validateElementAccess(rowIndex, columnIndex);
-            currentColumn = columnIndex;
-            currentRow = rowIndex;
-            return *this;
+#endif
+            return data[columnIndex * numRows + rowIndex];
         }
 
-        void operator=(DataType value) { //NOLINT: Specific for element assignment
-            if (currentColumn != -1 && currentRow != -1) {
-                data[currentColumn * numRows + currentRow] = value;
-                currentColumn = -1;
-                currentRow = -1;
-            } else {
-                throw std::runtime_error("Invalid assignment. Check assignment expressions");
-            }
+        // Element access for const objects
+        constexpr DataType const& operator()(unsigned const rowIndex, unsigned const columnIndex) const {
+#ifdef MATH3D_BOUNDS_CHECKS
+            validateElementAccess(rowIndex, columnIndex);
+#endif
+            return data[columnIndex * numRows + rowIndex];
         }
 
-        // Conversion operator that allows extraction of the current element
-        // This allows "matrix(a, b)" to appear in non-assignment contexts
-        // float xyz = matrix(a, b);
-        // or
-        // ASSERT_EQ(matrix(a,b), someScalar)
-        // NOTE: Matrix& Matrix::operator(row, column) will be resolved in assignment expressions
-        operator DataType() const { // NOLINT: Specific for element access
-            DataType scalar;
-            if (currentColumn != -1 && currentRow != -1) {
-                scalar = data[currentColumn * numRows + currentRow];
-                currentColumn = -1;
-                currentRow = -1;
-            } else {
-                throw std::runtime_error("Invalid conversion. Check element access expressions");
-            }
-            return scalar;
+        // Element access that throws std::runtime_error if the row or the column index is out of bounds
+        constexpr DataType& at(unsigned const rowIndex, unsigned const columnIndex) {
+            validateElementAccess(rowIndex, columnIndex);
+            return data[columnIndex * numRows + rowIndex];
         }
 
-        // Element access for const objects
-        DataType operator()(unsigned const rowIndex, unsigned const columnIndex) const {
+        constexpr DataType const& at(unsigned const rowIndex, unsigned const columnIndex) const {
             validateElementAccess(rowIndex, columnIndex);
             return data[columnIndex * numRows + rowIndex];
         }
 
         // Extract a range of elements into a new matrix
         template<unsigned newNumRows, unsigned newNumCols>
-        Matrix<DataType, newNumRows, newNumCols> extract(unsigned const startingRow = 0, unsigned const startingColumn = 0) {
+        constexpr Matrix<DataType, newNumRows, newNumCols> extract(unsigned const startingRow = 0, unsigned const startingColumn = 0) {
            if (startingRow >= numRows || startingColumn >= numCols) {
                throw std::runtime_error(
                    "Matrix::extract() [" + std::to_string(startingRow) + ',' + std::to_string(startingColumn) + ']' +
@@ -312,9 +375,14 @@ class Matrix {
         }
 
         // Defined in MatrixOperations.h
-        Matrix transpose();
-        DataType determinant();
-        Matrix inverse();
+        constexpr Matrix<DataType, numCols, numRows> transpose() const;
+        // 2x2, 3x3 and 4x4 determinants and inverses are computed in closed form
+        constexpr DataType determinant() const;
+        constexpr Matrix inverse() const;
+        // Inverses of 4x4 transforms whose last row is [0 0 0 1]. An affine transform's upper-left 3x3 block may
+        // hold any invertible linear transform. A rigid transform's upper-left 3x3 block must be a rotation
+        constexpr Matrix affineInverse() const;
+        constexpr Matrix rigidInverse() const;
         unsigned convertToUpperTriangular(Matrix& upperTriangular) const;
         void swapRows(unsigned rowA, unsigned rowB);
         void addRow(unsigned rowIndex, Vector<DataType, numCols> const& anotherRow);
@@ -322,18 +390,40 @@ class Matrix {
 
         // Defined in MatrixUtil.h
         static void readFromFile(std::filesystem::path const& matrixFile, Matrix&, char delimiter = ',');
+        static std::vector<Matrix> readAllFromFile(std::filesystem::path const& matrixFile, char delimiter = ',');
+        static std::vector<Matrix> readAllFromBinaryFile(std::filesystem::path const& matrixFile);
+        static void writeAllToBinaryFile(std::filesystem::path const& matrixFile, std::span<Matrix const> matrices);
 
 protected:
-        std::unique_ptr<DataType[]> data;
-        mutable int currentColumn {-1};
-        mutable int currentRow {-1};
+        MatrixStorage<DataType, numRows * numCols> data;
 
 
     private:
-        static void validateElementAccess(unsigned const rowIndex, unsigned const columnIndex) {
+        static constexpr bool hasVectorizedProduct =
+            numRows == 4 && numCols == 4 && (std::is_same_v<DataType, float> || std::is_same_v<DataType, double>);
+
+        template<typename Expression>
+        constexpr void assign(Expression const& expression) {
+            for (unsigned i = 0; i < numRows * numCols; ++i) {
+                data[i] = static_cast<DataType>(expression.element(i));
+            }
+        }
+
+        // Defined in MatrixOperations.h
+        constexpr void applyInverseTranslation(Matrix& inverse) const;
+
+        static constexpr void validateColumnAccess(unsigned const index) {
+            if (index >= numCols) [[unlikely]] {
+                throw std::runtime_error(
+                        "Matrix::operator[]() : Invalid access. " + std::to_string(index) + " is not a valid column"
+                        " index for a " + std::to_string(numRows) + 'x' + std::to_string(numCols) + " matrix");
+            }
+        }
+
+        static constexpr void validateElementAccess(unsigned const rowIndex, unsigned const columnIndex) {
             auto const badRowIndex = rowIndex >= numRows;
             auto const badColumnIndex = columnIndex >= numCols;
-            if (badRowIndex || badColumnIndex) {
+            if (badRowIndex || badColumnIndex) [[unlikely]] {
                 std::stringstream errorMessage;
                 errorMessage << "Invalid access: ";
                 if (badRowIndex) {
@@ -348,19 +438,7 @@ protected:
             }
         }
 
-        void assign(Matrix const& other) {
-            if (this != &other) {
-                data = std::make_unique<DataType[]>(numRows * numCols);
-                for (unsigned col = 0; col < numCols; ++col) {
-                    for (unsigned row = 0; row < numRows; ++row) {
-                        auto index = col * numRows + row;
-                        data[index] = other.data[index];
-                    }
-                }
-            }
-        }
-        
-        void readColumnMajor(auto const& initList) {
+        constexpr void readColumnMajor(auto const& initList) {
 
             // Number of columns in input data should match numCols 
             if (numCols != initList.size()) {
@@ -389,7 +467,7 @@ protected:
             }
         }
         
-        void readRowMajor(auto const& initList) {
+        constexpr void readRowMajor(auto const& initList) {
 
             // Number of rows in input data should match numRows 
             if (numRows != initList.size()) {
@@ -421,6 +499,10 @@ protected:
         template<typename T, unsigned, unsigned>
         friend class MatrixTestWrapper;
 
+        // Allow products to write directly to the storage of matrices of other dimensions
+        template<typename T, unsigned, unsigned>
+        friend class Matrix;
+
         // Allow primary matrices to access private data of augmented matrices
         friend class Matrix<DataType, numRows, numCols/2>;
         friend class Matrix<DataType, numRows, numCols-1>;
@@ -457,6 +539,170 @@ class AugmentedMatrix : public Matrix<DataType, numRows, numCols> {
         }
 };
 
+// Expression templates for element-wise matrix arithmetic
+//
+// Like vector arithmetic in Vector.h, sums, differences, negations and scalar multiples of matrices are returned as
+// expression objects that are evaluated element by element when they are assigned to a matrix. Matrix operands that
+// are lvalues are referenced, while temporaries and sub-expressions are stored by value. Matrix products are not
+// element-wise and continue to be computed right away
+template<typename Derived, typename DataType, unsigned numRows, unsigned numCols>
+class MatrixExpression {
+    public:
+        using ValueType = DataType;
+        static constexpr unsigned rows = numRows;
+        static constexpr unsigned columns = numCols;
+
+        [[nodiscard]]
+        constexpr Matrix<DataType, numRows, numCols> eval() const {
+            return Matrix<DataType, numRows, numCols>{static_cast<Derived const&>(*this)};
+        }
+
+        // Element in the given row and column
+        constexpr DataType operator()(unsigned const rowIndex, unsigned const columnIndex) const {
+            return static_cast<Derived const&>(*this).element(columnIndex * numRows + rowIndex);
+        }
+};
+
+template<typename M>
+concept MatrixType = requires(M const& m) { []<typename T, unsigned R, unsigned C>(Matrix<T, R, C> const&){}(m); };
+
+template<typename E>
+concept MatrixExpressionType =
+    requires(E const& e) { []<typename D, typename T, unsigned R, unsigned C>(MatrixExpression<D, T, R, C> const&){}(e); };
+
+template<typename M>
+concept MatrixOperand = MatrixType<std::remove_cvref_t<M>> || MatrixExpressionType<std::remove_cvref_t<M>>;
+
+// Linear, column-major access to the elements of a matrix operand
+template<typename Operand>
+constexpr auto matrixElement(Operand const& operand, unsigned const index) {
+    if constexpr (MatrixType<Operand>) {
+        return operand.getData()[index];
+    } else {
+        return operand.element(index);
+    }
+}
+
+template<typename M1, typename M2>
+concept CompatibleMatrixOperands =
+    MatrixOperand<M1> && MatrixOperand<M2> &&
+    std::is_same_v<typename std::remove_cvref_t<M1>::ValueType, typename std::remove_cvref_t<M2>::ValueType> &&
+    std::remove_cvref_t<M1>::rows == std::remove_cvref_t<M2>::rows &&
+    std::remove_cvref_t<M1>::columns == std::remove_cvref_t<M2>::columns;
+
+// Matrices that are lvalues are stored as references. Temporary matrices and expressions are stored by value
+template<typename Operand>
+using StoredMatrixOperand =
+    std::conditional_t<MatrixType<std::remove_cvref_t<Operand>> && std::is_lvalue_reference_v<Operand>,
+                       std::remove_cvref_t<Operand> const&,
+                       std::remove_cvref_t<Operand>>;
+
+// Element-wise operation on two matrix operands
+template<typename LHS, typename RHS, typename Operation>
+class MatrixBinaryExpression :
+    public MatrixExpression<MatrixBinaryExpression<LHS, RHS, Operation>,
+                            typename std::remove_cvref_t<LHS>::ValueType,
+                            std::remove_cvref_t<LHS>::rows, std::remove_cvref_t<LHS>::columns> {
+    public:
+        template<typename L, typename R>
+        constexpr MatrixBinaryExpression(L&& lhs, R&& rhs)
+        : lhs(std::forward<L>(lhs))
+        , rhs(std::forward<R>(rhs)) {
+        }
+
+        constexpr auto element(unsigned const index) const {
+            return Operation{}(matrixElement(lhs, index), matrixElement(rhs, index));
+        }
+
+    private:
+        LHS lhs;
+        RHS rhs;
+};
+
+// Element-wise operation on a matrix operand and a scalar
+template<typename Operand, typename Operation>
+class MatrixScalarExpression :
+    public MatrixExpression<MatrixScalarExpression<Operand, Operation>,
+                            typename std::remove_cvref_t<Operand>::ValueType,
+                            std::remove_cvref_t<Operand>::rows, std::remove_cvref_t<Operand>::columns> {
+    using T = typename std::remove_cvref_t<Operand>::ValueType;
+    public:
+        template<typename O>
+        constexpr MatrixScalarExpression(O&& operand, T const scalar)
+        : operand(std::forward<O>(operand))
+        , scalar(scalar) {
+        }
+
+        constexpr auto element(unsigned const index) const {
+            return Operation{}(matrixElement(operand, index), scalar);
+        }
+
+    private:
+        Operand operand;
+        T scalar;
+};
+
+// Element-wise operation on a single matrix operand
+template<typename Operand, typename Operation>
+class MatrixUnaryExpression :
+    public MatrixExpression<MatrixUnaryExpression<Operand, Operation>,
+                            typename std::remove_cvref_t<Operand>::ValueType,
+                            std::remove_cvref_t<Operand>::rows, std::remove_cvref_t<Operand>::columns> {
+    public:
+        template<typename O>
+        explicit constexpr MatrixUnaryExpression(O&& operand)
+        : operand(std::forward<O>(operand)) {
+        }
+
+        constexpr auto element(unsigned const index) const {
+            return Operation{}(matrixElement(operand, index));
+        }
+
+    private:
+        Operand operand;
+};
+
+template<typename LHS, typename RHS> requires CompatibleMatrixOperands<LHS, RHS>
+constexpr auto operator+(LHS&& lhs, RHS&& rhs) {
+    return MatrixBinaryExpression<StoredMatrixOperand<LHS>, StoredMatrixOperand<RHS>, std::plus<>>
+        {std::forward<LHS>(lhs), std::forward<RHS>(rhs)};
+}
+
+template<typename LHS, typename RHS> requires CompatibleMatrixOperands<LHS, RHS>
+constexpr auto operator-(LHS&& lhs, RHS&& rhs) {
+    return MatrixBinaryExpression<StoredMatrixOperand<LHS>, StoredMatrixOperand<RHS>, std::minus<>>
+        {std::forward<LHS>(lhs), std::forward<RHS>(rhs)};
+}
+
+template<typename Operand> requires MatrixOperand<Operand>
+constexpr auto operator-(Operand&& operand) {
+    return MatrixUnaryExpression<StoredMatrixOperand<Operand>, std::negate<>>{std::forward<Operand>(operand)};
+}
+
+template<typename Operand, typename Scalar> requires MatrixOperand<Operand> && std::is_arithmetic_v<Scalar>
+constexpr auto operator*(Operand&& operand, Scalar const scalar) {
+    using T = typename std::remove_cvref_t<Operand>::ValueType;
+    return MatrixScalarExpression<StoredMatrixOperand<Operand>, std::multiplies<>>
+        {std::forward<Operand>(operand), static_cast<T>(scalar)};
+}
+
+template<typename Scalar, typename Operand> requires MatrixOperand<Operand> && std::is_arithmetic_v<Scalar>
+constexpr auto operator*(Scalar const scalar, Operand&& operand) {
+    return std::forward<Operand>(operand) * scalar;
+}
+
+template<typename Operand, typename Scalar> requires MatrixOperand<Operand> && std::is_arithmetic_v<Scalar>
+constexpr auto operator/(Operand&& operand, Scalar const scalar) {
+    using T = typename std::remove_cvref_t<Operand>::ValueType;
+    return MatrixScalarExpression<StoredMatrixOperand<Operand>, std::divides<>>
+        {std::forward<Operand>(operand), static_cast<T>(scalar)};
+}
+
+template<typename Derived, typename DataType, unsigned numRows, unsigned numCols>
+inline std::ostream& operator<<(std::ostream& os, MatrixExpression<Derived, DataType, numRows, numCols> const& e) {
+    return os << e.eval();
+}
+
 template<typename DataType, unsigned numRows, unsigned numCols>
 inline std::ostream& operator<<(std::ostream& os, const Matrix<DataType, numRows, numCols>& m) { // NOLINT: clang-tidy is being greedy.
                                                                                                   // Non-member templates have to be inline to avoid ODR violations
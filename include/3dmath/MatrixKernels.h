@@ -0,0 +1,312 @@
+#pragma once
+
+// Kernels for small fixed-size matrices. Matrices are column-major and vectors are contiguous.
+//
+// The 4x4 matrix products are hand-vectorized. Every product computes a column of the result as a linear combination
+// of the columns of the left operand.
+//
+// The instruction set is selected at compile time. AVX is used for double precision when the compiler targets it
+// (e.g. -mavx or -march=native), SSE is used for single precision and as the double precision fallback on x86-64,
+// and portable scalar code is used everywhere else. Define MATH3D_DISABLE_SIMD to force the scalar kernels.
+
+#if !defined(MATH3D_DISABLE_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define MATH3D_SSE 1
+#if defined(__AVX__)
+#define MATH3D_AVX 1
+#include <immintrin.h>
+#else
+#include <emmintrin.h>
+#endif
+#endif
+
+#include <limits>
+#include <type_traits>
+
+namespace math3d::kernels {
+
+    // Portable implementations. These are also used to validate the vectorized kernels
+
+    // result = a * b, where a, b and result are 4x4 column-major matrices. result must not alias a or b
+    template<typename T>
+    inline void multiply4x4Scalar(T const* a, T const* b, T* result) {
+        for (unsigned col = 0; col < 4; ++col) {
+            T const* bColumn = b + col * 4;
+            for (unsigned row = 0; row < 4; ++row) {
+                result[col * 4 + row] = a[row] * bColumn[0] + a[4 + row] * bColumn[1] +
+                                        a[8 + row] * bColumn[2] + a[12 + row] * bColumn[3];
+            }
+        }
+    }
+
+    // result = a * v, where a is a 4x4 column-major matrix and v is a 4D vector. result must not alias v
+    template<typename T>
+    inline void multiply4x4VectorScalar(T const* a, T const* v, T* result) {
+        for (unsigned row = 0; row < 4; ++row) {
+            result[row] = a[row] * v[0] + a[4 + row] * v[1] + a[8 + row] * v[2] + a[12 + row] * v[3];
+        }
+    }
+
+    template<typename T>
+    inline void multiply4x4(T const* a, T const* b, T* result) {
+        multiply4x4Scalar(a, b, result);
+    }
+
+    template<typename T>
+    inline void multiply4x4Vector(T const* a, T const* v, T* result) {
+        multiply4x4VectorScalar(a, v, result);
+    }
+
+#ifdef MATH3D_SSE
+
+    template<>
+    inline void multiply4x4(float const* a, float const* b, float* result) {
+        __m128 const a0 = _mm_loadu_ps(a);
+        __m128 const a1 = _mm_loadu_ps(a + 4);
+        __m128 const a2 = _mm_loadu_ps(a + 8);
+        __m128 const a3 = _mm_loadu_ps(a + 12);
+        for (unsigned col = 0; col < 4; ++col) {
+            float const* bColumn = b + col * 4;
+            __m128 column = _mm_mul_ps(a0, _mm_set1_ps(bColumn[0]));
+            column = _mm_add_ps(column, _mm_mul_ps(a1, _mm_set1_ps(bColumn[1])));
+            column = _mm_add_ps(column, _mm_mul_ps(a2, _mm_set1_ps(bColumn[2])));
+            column = _mm_add_ps(column, _mm_mul_ps(a3, _mm_set1_ps(bColumn[3])));
+            _mm_storeu_ps(result + col * 4, column);
+        }
+    }
+
+    template<>
+    inline void multiply4x4Vector(float const* a, float const* v, float* result) {
+        __m128 column = _mm_mul_ps(_mm_loadu_ps(a), _mm_set1_ps(v[0]));
+        column = _mm_add_ps(column, _mm_mul_ps(_mm_loadu_ps(a + 4), _mm_set1_ps(v[1])));
+        column = _mm_add_ps(column, _mm_mul_ps(_mm_loadu_ps(a + 8), _mm_set1_ps(v[2])));
+        column = _mm_add_ps(column, _mm_mul_ps(_mm_loadu_ps(a + 12), _mm_set1_ps(v[3])));
+        _mm_storeu_ps(result, column);
+    }
+
+#ifdef MATH3D_AVX
+
+    template<>
+    inline void multiply4x4(double const* a, double const* b, double* result) {
+        __m256d const a0 = _mm256_loadu_pd(a);
+        __m256d const a1 = _mm256_loadu_pd(a + 4);
+        __m256d const a2 = _mm256_loadu_pd(a + 8);
+        __m256d const a3 = _mm256_loadu_pd(a + 12);
+        for (unsigned col = 0; col < 4; ++col) {
+            double const* bColumn = b + col * 4;
+            __m256d column = _mm256_mul_pd(a0, _mm256_set1_pd(bColumn[0]));
+            column = _mm256_add_pd(column, _mm256_mul_pd(a1, _mm256_set1_pd(bColumn[1])));
+            column = _mm256_add_pd(column, _mm256_mul_pd(a2, _mm256_set1_pd(bColumn[2])));
+            column = _mm256_add_pd(column, _mm256_mul_pd(a3, _mm256_set1_pd(bColumn[3])));
+            _mm256_storeu_pd(result + col * 4, column);
+        }
+    }
+
+    template<>
+    inline void multiply4x4Vector(double const* a, double const* v, double* result) {
+        __m256d column = _mm256_mul_pd(_mm256_loadu_pd(a), _mm256_set1_pd(v[0]));
+        column = _mm256_add_pd(column, _mm256_mul_pd(_mm256_loadu_pd(a + 4), _mm256_set1_pd(v[1])));
+        column = _mm256_add_pd(column, _mm256_mul_pd(_mm256_loadu_pd(a + 8), _mm256_set1_pd(v[2])));
+        column = _mm256_add_pd(column, _mm256_mul_pd(_mm256_loadu_pd(a + 12), _mm256_set1_pd(v[3])));
+        _mm256_storeu_pd(result, column);
+    }
+
+#else
+
+    // Without AVX a column of doubles spans two SSE registers
+    template<>
+    inline void multiply4x4(double const* a, double const* b, double* result) {
+        for (unsigned col = 0; col < 4; ++col) {
+            double const* bColumn = b + col * 4;
+            __m128d top = _mm_setzero_pd();
+            __m128d bottom = _mm_setzero_pd();
+            for (unsigned k = 0; k < 4; ++k) {
+                __m128d const scale = _mm_set1_pd(bColumn[k]);
+                top = _mm_add_pd(top, _mm_mul_pd(_mm_loadu_pd(a + k * 4), scale));
+                bottom = _mm_add_pd(bottom, _mm_mul_pd(_mm_loadu_pd(a + k * 4 + 2), scale));
+            }
+            _mm_storeu_pd(result + col * 4, top);
+            _mm_storeu_pd(result + col * 4 + 2, bottom);
+        }
+    }
+
+    template<>
+    inline void multiply4x4Vector(double const* a, double const* v, double* result) {
+        __m128d top = _mm_setzero_pd();
+        __m128d bottom = _mm_setzero_pd();
+        for (unsigned k = 0; k < 4; ++k) {
+            __m128d const scale = _mm_set1_pd(v[k]);
+            top = _mm_add_pd(top, _mm_mul_pd(_mm_loadu_pd(a + k * 4), scale));
+            bottom = _mm_add_pd(bottom, _mm_mul_pd(_mm_loadu_pd(a + k * 4 + 2), scale));
+        }
+        _mm_storeu_pd(result, top);
+        _mm_storeu_pd(result + 2, bottom);
+    }
+
+#endif // MATH3D_AVX
+
+#endif // MATH3D_SSE
+
+    // Closed-form determinants and inverses of 2x2, 3x3 and 4x4 matrices. These allocate nothing and are usable in
+    // constant expressions. Inverse kernels return false without writing the result if the matrix is singular. The
+    // result of an inverse must not alias its input
+
+    template<typename T>
+    constexpr T absoluteValue(T const value) {
+        return value < 0 ? -value : value;
+    }
+
+    // Type in which isSingular accumulates the squared column lengths. The squared bound of a float matrix fits in a
+    // double, but that of a double matrix can overflow one, so only double matrices pay for long double arithmetic
+    template<typename T>
+    using SingularityTestType = std::conditional_t<std::is_same_v<T, float>, double, long double>;
+
+    // A determinant is treated as zero if it is negligible relative to the product of the lengths of the matrix
+    // columns, which bounds its magnitude (Hadamard's inequality). The ratio of the two doesn't depend on the scale
+    // of any column, so matrices such as large translations and non-uniform scales aren't mistaken for singular ones.
+    // Squared lengths are compared so that no square root, which isn't usable in constant expressions, is needed
+    template<typename T, unsigned size>
+    constexpr bool isSingular(T const* a, T const determinant) {
+        using Wide = SingularityTestType<T>;
+        if (determinant == 0) {
+            return true;
+        }
+        Wide squaredBound = 1;
+        for (unsigned col = 0; col < size; ++col) {
+            Wide squaredLength = 0;
+            for (unsigned row = 0; row < size; ++row) {
+                squaredLength += static_cast<Wide>(a[col * size + row]) * a[col * size + row];
+            }
+            squaredBound *= squaredLength;
+        }
+        Wide const tolerance = static_cast<Wide>(std::numeric_limits<T>::epsilon()) * size;
+        Wide const wideDeterminant = determinant;
+        return wideDeterminant * wideDeterminant <= tolerance * tolerance * squaredBound;
+    }
+
+    template<typename T>
+    constexpr T determinant2x2(T const* a) {
+        return a[0] * a[3] - a[2] * a[1];
+    }
+
+    template<typename T>
+    constexpr bool invert2x2(T const* a, T* result) {
+        T const determinant = determinant2x2(a);
+        if (isSingular<T, 2>(a, determinant)) {
+            return false;
+        }
+        T const inverseDeterminant = 1 / determinant;
+        result[0] = a[3] * inverseDeterminant;
+        result[1] = -a[1] * inverseDeterminant;
+        result[2] = -a[2] * inverseDeterminant;
+        result[3] = a[0] * inverseDeterminant;
+        return true;
+    }
+
+    // The determinant of a 3x3 matrix is the scalar triple product of its columns. stride is the distance between
+    // the first elements of consecutive columns, which allows the upper-left 3x3 block of a 4x4 matrix to be used
+    template<typename T>
+    constexpr T determinant3x3(T const* a, unsigned const stride = 3) {
+        T const* c0 = a;
+        T const* c1 = a + stride;
+        T const* c2 = a + 2 * stride;
+        return c0[0] * (c1[1] * c2[2] - c1[2] * c2[1]) +
+               c0[1] * (c1[2] * c2[0] - c1[0] * c2[2]) +
+               c0[2] * (c1[0] * c2[1] - c1[1] * c2[0]);
+    }
+
+    // Rows of the inverse of a 3x3 matrix are the cross products of pairs of its columns divided by its determinant
+    template<typename T>
+    constexpr bool invert3x3(T const* a, T* result, unsigned const stride = 3, unsigned const resultStride = 3) {
+        T const* c0 = a;
+        T const* c1 = a + stride;
+        T const* c2 = a + 2 * stride;
+        T const rows[3][3] {
+            {c1[1] * c2[2] - c1[2] * c2[1], c1[2] * c2[0] - c1[0] * c2[2], c1[0] * c2[1] - c1[1] * c2[0]},
+            {c2[1] * c0[2] - c2[2] * c0[1], c2[2] * c0[0] - c2[0] * c0[2], c2[0] * c0[1] - c2[1] * c0[0]},
+            {c0[1] * c1[2] - c0[2] * c1[1], c0[2] * c1[0] - c0[0] * c1[2], c0[0] * c1[1] - c0[1] * c1[0]}
+        };
+        T const determinant = c0[0] * rows[0][0] + c0[1] * rows[0][1] + c0[2] * rows[0][2];
+        T const elements[9] {c0[0], c0[1], c0[2], c1[0], c1[1], c1[2], c2[0], c2[1], c2[2]};
+        if (isSingular<T, 3>(elements, determinant)) {
+            return false;
+        }
+        T const inverseDeterminant = 1 / determinant;
+        for (unsigned col = 0; col < 3; ++col) {
+            for (unsigned row = 0; row < 3; ++row) {
+                result[col * resultStride + row] = rows[row][col] * inverseDeterminant;
+            }
+        }
+        return true;
+    }
+
+    // 4x4 determinant and inverse by Laplace expansion along the first two rows. The 2x2 minors of the top two
+    // rows (s) and the bottom two rows (c) are computed once and shared by the determinant and all cofactors
+    template<typename T>
+    struct Minors4x4 {
+        T s[6];
+        T c[6];
+
+        constexpr explicit Minors4x4(T const* m) : s{}, c{} {
+            auto a = [m](unsigned row, unsigned col) { return m[col * 4 + row]; };
+            s[0] = a(0,0) * a(1,1) - a(1,0) * a(0,1);
+            s[1] = a(0,0) * a(1,2) - a(1,0) * a(0,2);
+            s[2] = a(0,0) * a(1,3) - a(1,0) * a(0,3);
+            s[3] = a(0,1) * a(1,2) - a(1,1) * a(0,2);
+            s[4] = a(0,1) * a(1,3) - a(1,1) * a(0,3);
+            s[5] = a(0,2) * a(1,3) - a(1,2) * a(0,3);
+            c[0] = a(2,0) * a(3,1) - a(3,0) * a(2,1);
+            c[1] = a(2,0) * a(3,2) - a(3,0) * a(2,2);
+            c[2] = a(2,0) * a(3,3) - a(3,0) * a(2,3);
+            c[3] = a(2,1) * a(3,2) - a(3,1) * a(2,2);
+            c[4] = a(2,1) * a(3,3) - a(3,1) * a(2,3);
+            c[5] = a(2,2) * a(3,3) - a(3,2) * a(2,3);
+        }
+
+        constexpr T determinant() const {
+            return s[0] * c[5] - s[1] * c[4] + s[2] * c[3] + s[3] * c[2] - s[4] * c[1] + s[5] * c[0];
+        }
+    };
+
+    template<typename T>
+    constexpr T determinant4x4(T const* a) {
+        return Minors4x4<T>{a}.determinant();
+    }
+
+    template<typename T>
+    constexpr bool invert4x4(T const* m, T* result) {
+        Minors4x4<T> const minors{m};
+        T const determinant = minors.determinant();
+        if (isSingular<T, 4>(m, determinant)) {
+            return false;
+        }
+        T const inverseDeterminant = 1 / determinant;
+        auto a = [m](unsigned row, unsigned col) { return m[col * 4 + row]; };
+        auto const& s = minors.s;
+        auto const& c = minors.c;
+        T const inverse[4][4] {
+            { a(1,1) * c[5] - a(1,2) * c[4] + a(1,3) * c[3],
+             -a(0,1) * c[5] + a(0,2) * c[4] - a(0,3) * c[3],
+              a(3,1) * s[5] - a(3,2) * s[4] + a(3,3) * s[3],
+             -a(2,1) * s[5] + a(2,2) * s[4] - a(2,3) * s[3]},
+            {-a(1,0) * c[5] + a(1,2) * c[2] - a(1,3) * c[1],
+              a(0,0) * c[5] - a(0,2) * c[2] + a(0,3) * c[1],
+             -a(3,0) * s[5] + a(3,2) * s[2] - a(3,3) * s[1],
+              a(2,0) * s[5] - a(2,2) * s[2] + a(2,3) * s[1]},
+            { a(1,0) * c[4] - a(1,1) * c[2] + a(1,3) * c[0],
+             -a(0,0) * c[4] + a(0,1) * c[2] - a(0,3) * c[0],
+              a(3,0) * s[4] - a(3,1) * s[2] + a(3,3) * s[0],
+             -a(2,0) * s[4] + a(2,1) * s[2] - a(2,3) * s[0]},
+            {-a(1,0) * c[3] + a(1,1) * c[1] - a(1,2) * c[0],
+              a(0,0) * c[3] - a(0,1) * c[1] + a(0,2) * c[0],
+             -a(3,0) * s[3] + a(3,1) * s[1] - a(3,2) * s[0],
+              a(2,0) * s[3] - a(2,1) * s[1] + a(2,2) * s[0]}
+        };
+        for (unsigned col = 0; col < 4; ++col) {
+            for (unsigned row = 0; row < 4; ++row) {
+                result[col * 4 + row] = inverse[row][col] * inverseDeterminant;
+            }
+        }
+        return true;
+    }
+
+}
@@ -61,10 +61,21 @@ namespace math3d {
     }
 
     template<typename DataType, unsigned numRows, unsigned numCols>
-    DataType Matrix<DataType, numRows, numCols>::determinant() {
+    constexpr DataType Matrix<DataType, numRows, numCols>::determinant() const {
         static_assert(numRows == numCols, "Matrix::determinant(): Determinants are not defined for non-square matrices");
         static_assert(std::is_floating_point<DataType>::value, "Matrix::determinant(): Matrix's data type needs to be floating point");
 
+        // Use closed-form expressions for small matrices
+        if constexpr (numRows == 1) {
+            return data[0];
+        } else if constexpr (numRows == 2) {
+            return kernels::determinant2x2(data.get());
+        } else if constexpr (numRows == 3) {
+            return kernels::determinant3x3(data.get());
+        } else if constexpr (numRows == 4) {
+            return kernels::determinant4x4(data.get());
+        }
+
         // Calculate determinant using the Gaussian elimination with partial pivoting
         Matrix upperTriangular;
         auto numRowSwaps = convertToUpperTriangular(upperTriangular);
@@ -81,11 +92,28 @@ namespace math3d {
     }
 
     template<typename DataType, unsigned numRows, unsigned numCols>
-    Matrix<DataType, numRows, numCols> Matrix<DataType, numRows, numCols>::inverse() {
+    constexpr Matrix<DataType, numRows, numCols> Matrix<DataType, numRows, numCols>::inverse() const {
         static_assert(numRows == numCols, "Matrix::inverse(): Inverse is not defined. Only square matrices are invertible");
         static_assert(std::is_floating_point<DataType>::value,
                       "Matrix::determinant(): Matrix's data type needs to be floating point");
 
+        // Use closed-form expressions for small matrices
+        if constexpr (numRows >= 2 && numRows <= 4) {
+            Matrix result;
+            bool invertible;
+            if constexpr (numRows == 2) {
+                invertible = kernels::invert2x2(data.get(), result.data.get());
+            } else if constexpr (numRows == 3) {
+                invertible = kernels::invert3x3(data.get(), result.data.get());
+            } else {
+                invertible = kernels::invert4x4(data.get(), result.data.get());
+            }
+            if (!invertible) {
+                throw std::runtime_error("Matrix is not invertible");
+            }
+            return result;
+        }
+
         // Compute inverse using Gauss-Jordan elimination
 
         // Step 1: Create augmented matrix
@@ -146,8 +174,47 @@ namespace math3d {
         return upperTriangular.template extract<numRows, numCols>(0, numCols);
     }
 
+    // Inverse of [A t; 0 1] is [inverse(A) -inverse(A)t; 0 1]
+    template<typename DataType, unsigned numRows, unsigned numCols>
+    constexpr Matrix<DataType, numRows, numCols> Matrix<DataType, numRows, numCols>::affineInverse() const {
+        static_assert(numRows == 4 && numCols == 4, "Matrix::affineInverse(): Affine inverse is defined only for 4x4 transforms");
+        static_assert(std::is_floating_point<DataType>::value,
+                      "Matrix::affineInverse(): Matrix's data type needs to be floating point");
+        Matrix result;
+        if (!kernels::invert3x3(data.get(), result.data.get(), 4, 4)) {
+            throw std::runtime_error("Matrix is not invertible");
+        }
+        applyInverseTranslation(result);
+        return result;
+    }
+
+    // Inverse of [R t; 0 1] is [transpose(R) -transpose(R)t; 0 1] when R is a rotation
+    template<typename DataType, unsigned numRows, unsigned numCols>
+    constexpr Matrix<DataType, numRows, numCols> Matrix<DataType, numRows, numCols>::rigidInverse() const {
+        static_assert(numRows == 4 && numCols == 4, "Matrix::rigidInverse(): Rigid inverse is defined only for 4x4 transforms");
+        Matrix result;
+        for (unsigned col = 0; col < 3; ++col) {
+            for (unsigned row = 0; row < 3; ++row) {
+                result.data[col * 4 + row] = data[row * 4 + col];
+            }
+        }
+        applyInverseTranslation(result);
+        return result;
+    }
+
+    // Set the translation column of an inverse transform whose upper-left 3x3 block has already been computed
+    template<typename DataType, unsigned numRows, unsigned numCols>
+    constexpr void Matrix<DataType, numRows, numCols>::applyInverseTranslation(Matrix& inverse) const {
+        for (unsigned row = 0; row < 3; ++row) {
+            inverse.data[12 + row] = -(inverse.data[row] * data[12] +
+                                       inverse.data[4 + row] * data[13] +
+                                       inverse.data[8 + row] * data[14]);
+        }
+        inverse.data[15] = 1;
+    }
+
     template<typename DataType, unsigned numRows, unsigned numCols>
-    Matrix<DataType, numRows, numCols> Matrix<DataType, numRows, numCols>::transpose() {
+    constexpr Matrix<DataType, numCols, numRows> Matrix<DataType, numRows, numCols>::transpose() const {
         Matrix <DataType, numCols, numRows> transposedMatrix;
         auto& transposedData = transposedMatrix.data;
         for (auto row = 0u; row < numRows; ++row) {
@@ -0,0 +1,214 @@
+#pragma once
+
+#include "Batch.h"
+#include "MatrixKernels.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <vector>
+
+// Cache-blocked products of large column-major matrices
+//
+// C += A * B is computed the way optimized BLAS libraries compute it. Blocks of B that fit in the last level cache and
+// blocks of A that fit in the L2 cache are copied ("packed") into buffers laid out in the order the micro-kernel reads
+// them. The micro-kernel computes a small tile of C whose elements stay in vector registers, reading one column of the
+// packed A panel and one row of the packed B panel per step. Packing pads partial panels with zeros, so the
+// micro-kernel always runs at full width and only its final update of C handles the edges of the matrix.
+//
+// Large products can be split across threads. Each thread computes its own range of columns of C and packs its own
+// buffers, so threads share nothing but A and B, which are only read.
+
+namespace math3d::kernels {
+
+    // Vector registers for the micro-kernel. The portable version holds four lanes and is used for integers, for
+    // long double and when SIMD is disabled
+    template<typename T>
+    struct ProductRegister {
+        static constexpr unsigned lanes = 4;
+        using Type = std::array<T, lanes>;
+        static Type zero() { return {}; }
+        static Type load(T const* data) { Type result; std::copy_n(data, lanes, result.begin()); return result; }
+        static void store(T* data, Type const& value) { std::copy_n(value.begin(), lanes, data); }
+        static Type broadcast(T const value) { Type result; result.fill(value); return result; }
+        static Type multiplyAdd(Type sum, Type const& a, Type const& b) {
+            for (unsigned lane = 0; lane < lanes; ++lane) sum[lane] += a[lane] * b[lane];
+            return sum;
+        }
+    };
+
+#ifdef MATH3D_SSE
+
+#ifdef MATH3D_AVX
+
+    template<>
+    struct ProductRegister<float> {
+        static constexpr unsigned lanes = 8;
+        using Type = __m256;
+        static Type zero() { return _mm256_setzero_ps(); }
+        static Type load(float const* data) { return _mm256_loadu_ps(data); }
+        static void store(float* data, Type const value) { _mm256_storeu_ps(data, value); }
+        static Type broadcast(float const value) { return _mm256_set1_ps(value); }
+        static Type multiplyAdd(Type const sum, Type const a, Type const b) {
+            return _mm256_add_ps(sum, _mm256_mul_ps(a, b));
+        }
+    };
+
+    template<>
+    struct ProductRegister<double> {
+        static constexpr unsigned lanes = 4;
+        using Type = __m256d;
+        static Type zero() { return _mm256_setzero_pd(); }
+        static Type load(double const* data) { return _mm256_loadu_pd(data); }
+        static void store(double* data, Type const value) { _mm256_storeu_pd(data, value); }
+        static Type broadcast(double const value) { return _mm256_set1_pd(value); }
+        static Type multiplyAdd(Type const sum, Type const a, Type const b) {
+            return _mm256_add_pd(sum, _mm256_mul_pd(a, b));
+        }
+    };
+
+#else
+
+    template<>
+    struct ProductRegister<float> {
+        static constexpr unsigned lanes = 4;
+        using Type = __m128;
+        static Type zero() { return _mm_setzero_ps(); }
+        static Type load(float const* data) { return _mm_loadu_ps(data); }
+        static void store(float* data, Type const value) { _mm_storeu_ps(data, value); }
+        static Type broadcast(float const value) { return _mm_set1_ps(value); }
+        static Type multiplyAdd(Type const sum, Type const a, Type const b) { return _mm_add_ps(sum, _mm_mul_ps(a, b)); }
+    };
+
+    template<>
+    struct ProductRegister<double> {
+        static constexpr unsigned lanes = 2;
+        using Type = __m128d;
+        static Type zero() { return _mm_setzero_pd(); }
+        static Type load(double const* data) { return _mm_loadu_pd(data); }
+        static void store(double* data, Type const value) { _mm_storeu_pd(data, value); }
+        static Type broadcast(double const value) { return _mm_set1_pd(value); }
+        static Type multiplyAdd(Type const sum, Type const a, Type const b) { return _mm_add_pd(sum, _mm_mul_pd(a, b)); }
+    };
+
+#endif // MATH3D_AVX
+
+#endif // MATH3D_SSE
+
+    template<typename T>
+    struct ProductBlocking {
+        // The micro-kernel computes a tile of tileRows x tileColumns elements of C, held in two registers per column
+        static constexpr unsigned tileRows = 2 * ProductRegister<T>::lanes;
+        static constexpr unsigned tileColumns = 4;
+        // A depth x rows block of A is packed to stay in the L2 cache, and a depth x columns block of B to stay in
+        // the last level cache
+        static constexpr size_t depth = 256;
+        static constexpr size_t rows = 128;
+        static constexpr size_t columns = 1024;
+        static_assert(rows % tileRows == 0 && columns % tileColumns == 0, "Blocks should hold whole tiles");
+    };
+
+    // Copy rows x depth elements of A, with leading dimension lda, into panels of tileRows rows. Each panel stores
+    // the tileRows elements of a column one after the other, for every column in turn
+    template<typename T>
+    void packPanelsOfA(T const* a, size_t const lda, size_t const rows, size_t const depth, T* packed) {
+        constexpr auto tileRows = ProductBlocking<T>::tileRows;
+        for (size_t panel = 0; panel < rows; panel += tileRows) {
+            auto const panelRows = std::min<size_t>(tileRows, rows - panel);
+            for (size_t k = 0; k < depth; ++k) {
+                T const* column = a + k * lda + panel;
+                std::copy_n(column, panelRows, packed);
+                std::fill(packed + panelRows, packed + tileRows, T{});
+                packed += tileRows;
+            }
+        }
+    }
+
+    // Copy depth x columns elements of B, with leading dimension ldb, into panels of tileColumns columns. Each panel
+    // stores the tileColumns elements of a row one after the other, for every row in turn
+    template<typename T>
+    void packPanelsOfB(T const* b, size_t const ldb, size_t const depth, size_t const columns, T* packed) {
+        constexpr auto tileColumns = ProductBlocking<T>::tileColumns;
+        for (size_t panel = 0; panel < columns; panel += tileColumns) {
+            auto const panelColumns = std::min<size_t>(tileColumns, columns - panel);
+            for (size_t k = 0; k < depth; ++k) {
+                for (size_t col = 0; col < tileColumns; ++col) {
+                    *packed++ = col < panelColumns ? b[(panel + col) * ldb + k] : T{};
+                }
+            }
+        }
+    }
+
+    // C += A * B for a tile of C, given a panel of A and a panel of B packed over depth. Only the top-left rows x
+    // columns elements of the tile are stored, for tiles at the edges of C
+    template<typename T>
+    void multiplyTile(size_t const depth, T const* packedA, T const* packedB, T* c, size_t const ldc,
+                      size_t const rows, size_t const columns) {
+        using Register = ProductRegister<T>;
+        constexpr auto lanes = Register::lanes;
+        constexpr auto tileRows = ProductBlocking<T>::tileRows;
+        constexpr auto tileColumns = ProductBlocking<T>::tileColumns;
+
+        typename Register::Type sums[tileColumns][2];
+        for (auto& column : sums) {
+            column[0] = column[1] = Register::zero();
+        }
+        for (size_t k = 0; k < depth; ++k, packedA += tileRows, packedB += tileColumns) {
+            auto const top = Register::load(packedA);
+            auto const bottom = Register::load(packedA + lanes);
+            for (unsigned col = 0; col < tileColumns; ++col) {
+                auto const scale = Register::broadcast(packedB[col]);
+                sums[col][0] = Register::multiplyAdd(sums[col][0], top, scale);
+                sums[col][1] = Register::multiplyAdd(sums[col][1], bottom, scale);
+            }
+        }
+
+        std::array<T, tileRows> column;
+        for (unsigned col = 0; col < columns; ++col) {
+            T* cColumn = c + col * ldc;
+            Register::store(column.data(), sums[col][0]);
+            Register::store(column.data() + lanes, sums[col][1]);
+            for (unsigned row = 0; row < rows; ++row) {
+                cColumn[row] += column[row];
+            }
+        }
+    }
+
+    // C += A * B, where A is rows x depth, B is depth x columns and C is rows x columns, all column-major with
+    // leading dimensions lda, ldb and ldc. C must not alias A or B
+    template<typename T>
+    void multiplyBlocked(T const* a, size_t const lda, T const* b, size_t const ldb, T* c, size_t const ldc,
+                         size_t const rows, size_t const depth, size_t const columns,
+                         Execution const execution = Execution::Sequential) {
+        using Blocking = ProductBlocking<T>;
+        if (rows == 0 || depth == 0 || columns == 0) return;
+
+        auto const multiplyColumns = [&](size_t const firstColumn, size_t const lastColumn) {
+            std::vector<T> packedA(Blocking::rows * Blocking::depth);
+            std::vector<T> packedB(Blocking::depth * Blocking::columns);
+            for (auto jc = firstColumn; jc < lastColumn; jc += Blocking::columns) {
+                auto const blockColumns = std::min(Blocking::columns, lastColumn - jc);
+                for (size_t pc = 0; pc < depth; pc += Blocking::depth) {
+                    auto const blockDepth = std::min(Blocking::depth, depth - pc);
+                    packPanelsOfB(b + jc * ldb + pc, ldb, blockDepth, blockColumns, packedB.data());
+                    for (size_t ic = 0; ic < rows; ic += Blocking::rows) {
+                        auto const blockRows = std::min(Blocking::rows, rows - ic);
+                        packPanelsOfA(a + pc * lda + ic, lda, blockRows, blockDepth, packedA.data());
+                        for (size_t jr = 0; jr < blockColumns; jr += Blocking::tileColumns) {
+                            for (size_t ir = 0; ir < blockRows; ir += Blocking::tileRows) {
+                                multiplyTile(blockDepth, packedA.data() + ir * blockDepth,
+                                             packedB.data() + jr * blockDepth, c + (jc + jr) * ldc + ic + ir, ldc,
+                                             std::min<size_t>(Blocking::tileRows, blockRows - ir),
+                                             std::min<size_t>(Blocking::tileColumns, blockColumns - jr));
+                            }
+                        }
+                    }
+                }
+            }
+        };
+
+        // A thread should have at least a few million multiply-adds to compute, i.e. rows * depth per column of C
+        constexpr size_t minimumMultiplyAddsPerThread = 1 << 22;
+        batch::forEachRange(columns, execution, multiplyColumns,
+                            std::max<size_t>(minimumMultiplyAddsPerThread / (rows * depth), Blocking::tileColumns));
+    }
+}
@@ -1,50 +1,165 @@
 #pragma once
 #include "Matrix.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
-#include <sstream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Matrix files
+//
+// Text files hold a matrix row per line with elements separated by a delimiter. Files can hold any number of matrices,
+// one after the other, and blank lines between them are ignored. Elements are parsed with std::from_chars straight
+// out of the memory mapped file, which doesn't allocate and doesn't depend on the locale.
+//
+// Binary files hold the elements of matrices one after the other in column-major order, the order in which matrices
+// store them, in the machine's byte order.
 
 namespace math3d {
-    template<typename DataType, unsigned numRows, unsigned numCols>
-    void Matrix<DataType, numRows, numCols>::readFromFile(std::filesystem::path const& matrixFile,
-                                                          Matrix& matrix,
-                                                          char const delimiter) {
 
-        if (!exists(matrixFile)) {
-            throw std::runtime_error(matrixFile.string() + " does not exist");
+    namespace matrixFile {
+
+        inline MappedFile open(std::filesystem::path const& matrixFile) {
+            if (!exists(matrixFile)) {
+                throw std::runtime_error(matrixFile.string() + " does not exist");
+            }
+            return MappedFile(matrixFile);
+        }
+
+        inline bool isBlank(std::string_view const line) {
+            return line.find_first_not_of(" \t\r") == std::string_view::npos;
         }
 
-        std::ifstream ifs(matrixFile.string(), std::ios::binary | std::ios::ate);
-        if (!ifs) {
-            throw std::runtime_error("Error reading " + matrixFile.string());
+        // Parse numValues values separated by delimiter, which may be surrounded by spaces, from a line. Values are
+        // stored stride elements apart
+        template<typename DataType>
+        void parseRow(std::string_view const line, char const delimiter, DataType* values, unsigned const numValues,
+                      unsigned const stride) {
+            auto const malformed = [line]() {
+                return std::runtime_error("Malformed matrix row \"" + std::string(line) + '"');
+            };
+            auto const isSpace = [](char const c) { return c == ' ' || c == '\t' || c == '\r'; };
+            auto const skipSpaces = [isSpace](char const* position, char const* end) {
+                while (position != end && isSpace(*position)) ++position;
+                return position;
+            };
+            auto const* position = line.data();
+            auto const* const end = line.data() + line.size();
+            for (unsigned i = 0; i < numValues; ++i) {
+                auto const* const valueEnd = position;
+                position = skipSpaces(position, end);
+                if (i != 0) {
+                    if (position != end && *position == delimiter) {
+                        position = skipSpaces(position + 1, end);
+                    } else if (!isSpace(delimiter) || position == valueEnd) {
+                        // Spaces are the delimiter when the delimiter is a space
+                        throw malformed();
+                    }
+                }
+                // from_chars doesn't accept a leading +
+                if (position != end && *position == '+') ++position;
+                auto const [next, error] = std::from_chars(position, end, values[i * stride]);
+                if (error != std::errc{}) throw malformed();
+                position = next;
+            }
+            if (skipSpaces(position, end) != end) throw malformed();
         }
 
-        auto fileSize = ifs.tellg();
-        std::string fileContents(fileSize, ' ');
+        // Call parseMatrixRow(row, line) for the rows of consecutive matrices in the file contents, with row going
+        // from 0 to numRows - 1 for each matrix, until it returns false. Returns the number of rows parsed
+        template<typename ParseMatrixRow>
+        size_t forEachRow(std::span<char const> const contents, unsigned const numRows,
+                          ParseMatrixRow&& parseMatrixRow) {
+            auto const* position = contents.data();
+            auto const* const end = contents.data() + contents.size();
+            size_t numRowsParsed = 0;
+            while (position != end) {
+                auto const* const lineEnd = std::find(position, end, '\n');
+                std::string_view const line(position, static_cast<size_t>(lineEnd - position));
+                position = lineEnd == end ? end : lineEnd + 1;
+                if (isBlank(line)) continue;
+                if (!parseMatrixRow(static_cast<unsigned>(numRowsParsed++ % numRows), line)) break;
+            }
+            return numRowsParsed;
+        }
+    }
 
-        ifs.seekg(0, std::ios::beg);
-        ifs.read(fileContents.data(), fileSize);
+    template<typename DataType, unsigned numRows, unsigned numCols>
+    void Matrix<DataType, numRows, numCols>::readFromFile(std::filesystem::path const& matrixFile,
+                                                          Matrix& matrix,
+                                                          char const delimiter) {
+        auto const file = matrixFile::open(matrixFile);
+        auto const numRowsParsed = matrixFile::forEachRow(file.getContents(), numRows,
+                                                     [&matrix, delimiter](unsigned const row, std::string_view line) {
+            matrixFile::parseRow(line, delimiter, matrix.data.get() + row, numCols, numRows);
+            return row + 1 != numRows;
+        });
+        if (numRowsParsed != numRows) {
+            throw std::runtime_error("Malformed matrix. " + matrixFile.string() + " has " +
+                                     std::to_string(numRowsParsed) + " rows instead of " + std::to_string(numRows));
+        }
+    }
 
+    template<typename DataType, unsigned numRows, unsigned numCols>
+    std::vector<Matrix<DataType, numRows, numCols>>
+    Matrix<DataType, numRows, numCols>::readAllFromFile(std::filesystem::path const& matrixFile,
+                                                        char const delimiter) {
+        auto const file = matrixFile::open(matrixFile);
+        auto const contents = file.getContents();
+        std::vector<Matrix> matrices;
+        // Every row is a line
+        matrices.reserve(static_cast<size_t>(std::count(contents.begin(), contents.end(), '\n')) / numRows + 1);
+        auto const numRowsParsed = matrixFile::forEachRow(contents, numRows,
+                                                     [&matrices, delimiter](unsigned const row, std::string_view line) {
+            if (row == 0) matrices.emplace_back();
+            matrixFile::parseRow(line, delimiter, matrices.back().data.get() + row, numCols, numRows);
+            return true;
+        });
+        if (numRowsParsed % numRows != 0) {
+            throw std::runtime_error("Malformed matrix. The last matrix in " + matrixFile.string() + " has " +
+                                     std::to_string(numRowsParsed % numRows) + " rows instead of " +
+                                     std::to_string(numRows));
+        }
+        return matrices;
+    }
 
-        std::istringstream iss(fileContents, '\n');
-        auto nextNumber = [delimiter](std::string const& row, long& delimiterPosition) -> DataType {
-            size_t startPosition = delimiterPosition + 1;
-            delimiterPosition = row.find_first_of(delimiter, delimiterPosition + 1);
-            size_t endPosition = delimiterPosition - 1;
-            return static_cast<DataType>(std::atof(row.substr(startPosition, endPosition).c_str()));
-        };
+    template<typename DataType, unsigned numRows, unsigned numCols>
+    std::vector<Matrix<DataType, numRows, numCols>>
+    Matrix<DataType, numRows, numCols>::readAllFromBinaryFile(std::filesystem::path const& matrixFile) {
+        auto const file = matrixFile::open(matrixFile);
+        auto const contents = file.getContents();
+        constexpr size_t matrixSize = numRows * numCols * sizeof(DataType);
+        if (contents.size() % matrixSize != 0) {
+            throw std::runtime_error("Malformed matrix file. The size of " + matrixFile.string() + " is not a " +
+                                     "multiple of the size of a " + std::to_string(numRows) + 'x' +
+                                     std::to_string(numCols) + " matrix");
+        }
+        std::vector<Matrix> matrices(contents.size() / matrixSize);
+        for (size_t i = 0; i < matrices.size(); ++i) {
+            std::memcpy(matrices[i].data.get(), contents.data() + i * matrixSize, matrixSize);
+        }
+        return matrices;
+    }
 
-        for (unsigned i = 0; i < numRows; ++i) {
-            std::string row;
-            long delimiterPosition = -1;
-            getline(iss, row);
-            for (unsigned j = 0; j < numCols; ++j) {
-                if (j != 0 && delimiterPosition == std::string::npos) {
-                    throw std::runtime_error("Malformed matrix");
-                }
-                matrix.data[j * numRows + i] = nextNumber(row, delimiterPosition);
-            }
+    template<typename DataType, unsigned numRows, unsigned numCols>
+    void Matrix<DataType, numRows, numCols>::writeAllToBinaryFile(std::filesystem::path const& matrixFile,
+                                                                  std::span<Matrix const> matrices) {
+        std::ofstream ofs(matrixFile, std::ios::binary);
+        if (!ofs) {
+            throw std::runtime_error("Unable to open " + matrixFile.string() + " for writing");
+        }
+        for (auto const& matrix : matrices) {
+            ofs.write(reinterpret_cast<char const*>(matrix.getData()), numRows * numCols * sizeof(DataType));
+        }
+        if (!ofs) {
+            throw std::runtime_error("Unable to write " + matrixFile.string());
         }
     }
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,178 @@
+#pragma once
+
+#include "Batch.h"
+#include "MappedFile.h"
+#include "TypeAliases.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Wavefront OBJ input
+//
+// Vertex positions and faces are read from the memory mapped file with std::from_chars. Other statements, such as
+// texture coordinates, normals, groups and materials, are skipped. Faces with more than three vertices are split into
+// a fan of triangles, and faces with fewer, such as the line segments written for rays, are skipped. Face vertices
+// can be "v", "v/vt", "v//vn" or "v/vt/vn", of which only the position index v is used. Negative indices count back
+// from the last vertex read.
+//
+// Large files can be parsed on several threads. The file is split into ranges of bytes, and each range parses the
+// lines that start in it, so every line is parsed by exactly one range. Ranges don't know how many vertices precede
+// them, so negative indices are resolved once all ranges are parsed.
+
+namespace math3d {
+
+    namespace obj {
+
+        // Vertices and triangles of the lines of a range of the file
+        struct ParsedRange {
+            types::Vertices vertices;
+            types::Tris tris;
+            // Indices of triangle corners whose index is relative to the range's first vertex, which are the corners
+            // that had negative indices
+            std::vector<size_t> relativeCorners;
+        };
+
+        [[noreturn]] inline void throwParseError(std::string_view const line) {
+            throw std::runtime_error("Unable to parse OBJ statement \"" + std::string(line) + '"');
+        }
+
+        inline char const* skipSpaces(char const* position, char const* end) {
+            while (position != end && (*position == ' ' || *position == '\t')) ++position;
+            return position;
+        }
+
+        // Parse "v x y z", ignoring an optional w
+        inline void parseVertex(std::string_view const line, ParsedRange& range) {
+            auto const* position = line.data() + 1;
+            auto const* const end = line.data() + line.size();
+            types::Vertex vertex;
+            for (unsigned axis = 0; axis < 3; ++axis) {
+                position = skipSpaces(position, end);
+                // from_chars doesn't accept a leading +
+                if (position != end && *position == '+') ++position;
+                auto const [next, error] = std::from_chars(position, end, vertex[axis]);
+                if (error != std::errc{}) {
+                    throwParseError(line);
+                }
+                position = next;
+            }
+            range.vertices.push_back(vertex);
+        }
+
+        // Parse "f v1 v2 v3 ..." into a fan of triangles around v1
+        inline void parseFace(std::string_view const line, ParsedRange& range) {
+            auto const* position = line.data() + 1;
+            auto const* const end = line.data() + line.size();
+            std::array<unsigned, 3> corners;
+            std::array<bool, 3> relative;
+            unsigned numberOfCorners = 0;
+            while ((position = skipSpaces(position, end)) != end && *position != '\r') {
+                int64_t index;
+                auto const [next, error] = std::from_chars(position, end, index);
+                if (error != std::errc{} || index == 0) {
+                    throwParseError(line);
+                }
+                // Skip texture coordinate and normal indices
+                position = next;
+                while (position != end && *position != ' ' && *position != '\t' && *position != '\r') ++position;
+
+                // Positive indices are one-based. Negative indices count back from the range's last vertex, and are
+                // relative to its first until all ranges are parsed
+                auto const isRelative = index < 0;
+                auto const cornerIndex = isRelative ? static_cast<int64_t>(range.vertices.size()) + index : index - 1;
+                auto const corner = std::min(numberOfCorners, 2u);
+                corners[corner] = static_cast<unsigned>(cornerIndex);
+                relative[corner] = isRelative;
+                if (++numberOfCorners >= 3) {
+                    for (unsigned i = 0; i < 3; ++i) {
+                        if (relative[i]) range.relativeCorners.push_back(3 * range.tris.size() + i);
+                    }
+                    range.tris.emplace_back(corners[0], corners[1], corners[2]);
+                    // The next triangle of the fan starts from the first corner and this one
+                    corners[1] = corners[2];
+                    relative[1] = relative[2];
+                }
+            }
+        }
+
+        // Parse the lines that start in [begin, end) of the file contents
+        inline ParsedRange parseRange(std::span<char const> const contents, size_t begin, size_t const end) {
+            // A line that starts before the range belongs to the previous range
+            if (begin != 0 && contents[begin - 1] != '\n') {
+                auto const lineEnd = std::find(contents.begin() + static_cast<std::ptrdiff_t>(begin),
+                                               contents.end(), '\n');
+                begin = static_cast<size_t>(lineEnd - contents.begin()) + 1;
+            }
+            ParsedRange range;
+            while (begin < end) {
+                auto const lineEnd = std::find(contents.begin() + static_cast<std::ptrdiff_t>(begin),
+                                               contents.end(), '\n');
+                auto const length = static_cast<size_t>(lineEnd - contents.begin()) - begin;
+                std::string_view const line(contents.data() + begin, length);
+                auto const* const statement = skipSpaces(line.data(), line.data() + line.size());
+                auto const statementLine = line.substr(static_cast<size_t>(statement - line.data()));
+                if (statementLine.size() > 1 && (statementLine[1] == ' ' || statementLine[1] == '\t')) {
+                    if (statementLine[0] == 'v') {
+                        parseVertex(statementLine, range);
+                    } else if (statementLine[0] == 'f') {
+                        parseFace(statementLine, range);
+                    }
+                }
+                begin += length + 1;
+            }
+            return range;
+        }
+    }
+
+    inline types::Mesh readOBJ(std::filesystem::path const& inputFile,
+                               Execution const execution = Execution::Sequential) {
+        MappedFile const file(inputFile);
+        auto const contents = file.getContents();
+
+        // Ranges are parsed in any order, and merged in the order of their first lines
+        std::map<size_t, obj::ParsedRange> ranges;
+        std::mutex rangesMutex;
+        batch::forEachRange(contents.size(), execution, [&](size_t const begin, size_t const end) {
+            auto range = obj::parseRange(contents, begin, end);
+            std::scoped_lock lock(rangesMutex);
+            ranges.emplace(begin, std::move(range));
+        });
+
+        types::Mesh mesh;
+        size_t numberOfVertices = 0, numberOfTris = 0;
+        for (auto const& [begin, range] : ranges) {
+            numberOfVertices += range.vertices.size();
+            numberOfTris += range.tris.size();
+        }
+        mesh.vertices.reserve(numberOfVertices);
+        mesh.tris.reserve(numberOfTris);
+        for (auto& [begin, range] : ranges) {
+            auto const firstVertex = static_cast<unsigned>(mesh.vertices.size());
+            auto const firstTri = mesh.tris.size();
+            mesh.vertices.insert(mesh.vertices.end(), range.vertices.begin(), range.vertices.end());
+            mesh.tris.insert(mesh.tris.end(), range.tris.begin(), range.tris.end());
+            for (auto const corner : range.relativeCorners) {
+                mesh.tris[firstTri + corner / 3][corner % 3] += firstVertex;
+            }
+        }
+
+        for (auto const& tri : mesh.tris) {
+            for (auto const index : tri) {
+                if (index >= mesh.vertices.size()) {
+                    throw std::runtime_error(inputFile.string() + " has a face with vertex index " +
+                                             std::to_string(static_cast<int>(index) + 1) + ", which is out of bounds "
+                                             "for its " + std::to_string(mesh.vertices.size()) + " vertices");
+                }
+            }
+        }
+        return mesh;
+    }
+}
@@ -0,0 +1,148 @@
+#pragma once
+
+#include "Batch.h"
+#include "TypeAliases.h"
+#include <array>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+
+// Wavefront OBJ output
+//
+// Vertices and faces are formatted with std::to_chars into a buffer that is written to the file in one go, rather than
+// through a string stream per line. Coordinates are formatted like printf's %g, with the given number of significant
+// digits, which is also how streams format them by default. Large meshes can be formatted on several threads, each
+// formatting a contiguous range of lines into its own buffer, and the buffers are written in order.
+//
+// Any number of meshes can be written into the same file. OBJ indices refer to all vertices written before them, so
+// the indices of a mesh's faces are offset by the number of vertices of the meshes written before it.
+
+namespace math3d {
+
+    class OBJWriter {
+    public:
+        // Number of significant digits of vertex coordinates that streams write by default
+        static constexpr int defaultPrecision = 6;
+        // Single precision values have at most nine significant digits
+        static constexpr int maximumPrecision = 9;
+
+        explicit OBJWriter(std::filesystem::path const& outputFile, int const precision = defaultPrecision,
+                           Execution const execution = Execution::Sequential)
+        : ofs(outputFile, std::ios::binary)
+        , precision(precision)
+        , execution(execution) {
+            if (precision < 1 || precision > maximumPrecision) {
+                throw std::invalid_argument("Precision should be between 1 and " + std::to_string(maximumPrecision) +
+                                            " significant digits. Precision is " + std::to_string(precision));
+            }
+            if (!ofs) {
+                throw std::runtime_error("Unable to open " + outputFile.string() + " for writing");
+            }
+        }
+
+        // Write vertices followed by faces that index them. Faces are arrays of zero-based vertex indices, such as
+        // triangles or the line segments of rays
+        template<typename Face, size_t indicesPerFace = std::tuple_size_v<Face>>
+        void write(std::span<types::Vertex const> vertices, std::span<Face const> faces) {
+            validateOpen();
+            // "v" and three coordinates of at most precision digits, a sign, a decimal point and a four character
+            // exponent or up to four leading zeros
+            writeLines(vertices.size(), 3 * (precision + 8) + 2, [this, vertices](char* out, size_t const i) {
+                *out++ = 'v';
+                for (unsigned axis = 0; axis < 3; ++axis) {
+                    *out++ = ' ';
+                    out = std::to_chars(out, out + precision + 8, vertices[i][axis],
+                                        std::chars_format::general, precision).ptr;
+                }
+                return out;
+            });
+
+            // "f" and the one-based indices
+            auto const firstVertexNumber = numberOfVertices + 1;
+            writeLines(faces.size(), indicesPerFace * 21 + 1, [faces, firstVertexNumber](char* out, size_t const i) {
+                *out++ = 'f';
+                for (size_t index = 0; index < indicesPerFace; ++index) {
+                    *out++ = ' ';
+                    out = std::to_chars(out, out + 20, firstVertexNumber + faces[i][index]).ptr;
+                }
+                return out;
+            });
+            numberOfVertices += vertices.size();
+        }
+
+        void write(std::span<types::Vertex const> vertices, std::span<types::Tri const> tris) {
+            write<types::Tri, 3>(vertices, tris);
+        }
+
+        // Write the geometry of a primitive, generating it first if it hasn't been generated
+        template<typename PrimitiveType>
+        void write(PrimitiveType& primitive) {
+            if (primitive.getVertices().empty()) {
+                primitive.generateGeometry();
+            }
+            write(primitive.getVertices(), primitive.getTris());
+        }
+
+        // Close the file. Closing a closed writer does nothing
+        void close() {
+            if (!ofs.is_open()) return;
+            ofs.close();
+            if (!ofs) {
+                throw std::runtime_error("Unable to write OBJ file");
+            }
+        }
+
+    private:
+        void validateOpen() const {
+            if (!ofs.is_open()) {
+                throw std::runtime_error("Unable to write geometry. The OBJ writer was closed");
+            }
+        }
+
+        // Write count lines. formatLine(out, i) formats line i, without its line break, starting at out and returns
+        // the end of the formatted text. Lines are at most maximumLineLength characters long
+        template<typename FormatLine>
+        void writeLines(size_t const count, size_t const maximumLineLength, FormatLine&& formatLine) {
+            auto const formatLines = [&](size_t const begin, size_t const end) {
+                std::string lines(maximumLineLength * (end - begin) + (end - begin), '\0');
+                auto* out = lines.data();
+                for (auto i = begin; i < end; ++i) {
+                    out = formatLine(out, i);
+                    *out++ = '\n';
+                }
+                lines.resize(out - lines.data());
+                return lines;
+            };
+
+            // Ranges are formatted in any order, and written in the order of their first lines
+            std::map<size_t, std::string> rangeLines;
+            std::mutex rangeLinesMutex;
+            batch::forEachRange(count, execution, [&](size_t const begin, size_t const end) {
+                auto lines = formatLines(begin, end);
+                std::scoped_lock lock(rangeLinesMutex);
+                rangeLines.emplace(begin, std::move(lines));
+            });
+            for (auto const& [begin, lines] : rangeLines) {
+                writeText(lines);
+            }
+        }
+
+        void writeText(std::string const& text) {
+            ofs.write(text.data(), static_cast<std::streamsize>(text.size()));
+            if (!ofs) {
+                throw std::runtime_error("Unable to write OBJ file");
+            }
+        }
+
+        std::ofstream ofs;
+        int const precision;
+        Execution const execution;
+        size_t numberOfVertices = 0;
+    };
+}
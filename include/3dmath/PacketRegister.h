@@ -0,0 +1,213 @@
+#pragma once
+
+#include "MatrixKernels.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+
+// Vector registers of N single precision lanes, for kernels that process N elements at once such as ray packets and
+// batched triangle normals. Kernels are written once against the static functions of PacketRegister<N> and compile to
+// SSE for four lanes, to AVX for eight lanes where the compiler targets it and to pairs of SSE registers otherwise, and
+// to pairs of eight lane registers for sixteen lanes. Portable code is used for every other width and instruction set.
+
+namespace math3d {
+
+    namespace batch {
+
+        template<unsigned N>
+        struct PacketRegister {
+            using Type = std::array<float, N>;
+            using Mask = std::array<bool, N>;
+
+            template<typename Operation>
+            static Type apply(Type const& a, Type const& b, Operation&& operation) {
+                Type result;
+                for (unsigned lane = 0; lane < N; ++lane) result[lane] = operation(a[lane], b[lane]);
+                return result;
+            }
+
+            template<typename Operation>
+            static Mask compare(Type const& a, Type const& b, Operation&& operation) {
+                Mask result;
+                for (unsigned lane = 0; lane < N; ++lane) result[lane] = operation(a[lane], b[lane]);
+                return result;
+            }
+
+            static Type broadcast(float const value) { Type result; result.fill(value); return result; }
+            static Type load(float const* data) { Type result; std::copy_n(data, N, result.begin()); return result; }
+            static void store(float* data, Type const& value) { std::copy_n(value.begin(), N, data); }
+            static Type add(Type const& a, Type const& b) { return apply(a, b, std::plus<>{}); }
+            static Type subtract(Type const& a, Type const& b) { return apply(a, b, std::minus<>{}); }
+            static Type multiply(Type const& a, Type const& b) { return apply(a, b, std::multiplies<>{}); }
+            static Type divide(Type const& a, Type const& b) { return apply(a, b, std::divides<>{}); }
+            static Type min(Type const& a, Type const& b) {
+                return apply(a, b, [](float const x, float const y) { return std::min(x, y); });
+            }
+            static Type max(Type const& a, Type const& b) {
+                return apply(a, b, [](float const x, float const y) { return std::max(x, y); });
+            }
+            static Type sqrt(Type a) { for (auto& value : a) value = std::sqrt(value); return a; }
+            static Type abs(Type a) { for (auto& value : a) value = std::fabs(value); return a; }
+            static Mask lessThan(Type const& a, Type const& b) { return compare(a, b, std::less<>{}); }
+            static Mask lessThanOrEqual(Type const& a, Type const& b) { return compare(a, b, std::less_equal<>{}); }
+            static Mask logicalAnd(Mask a, Mask const& b) {
+                for (unsigned lane = 0; lane < N; ++lane) a[lane] = a[lane] && b[lane];
+                return a;
+            }
+            static Mask logicalOr(Mask a, Mask const& b) {
+                for (unsigned lane = 0; lane < N; ++lane) a[lane] = a[lane] || b[lane];
+                return a;
+            }
+            static Mask logicalNot(Mask a) { for (auto& value : a) value = !value; return a; }
+            // Lanes of a where the mask is set and lanes of b elsewhere
+            static Type select(Mask const& mask, Type const& a, Type const& b) {
+                Type result;
+                for (unsigned lane = 0; lane < N; ++lane) result[lane] = mask[lane] ? a[lane] : b[lane];
+                return result;
+            }
+            // Bit i of the result is set if lane i of the mask is set
+            static unsigned bits(Mask const& mask) {
+                unsigned result = 0;
+                for (unsigned lane = 0; lane < N; ++lane) result |= static_cast<unsigned>(mask[lane]) << lane;
+                return result;
+            }
+        };
+
+#ifdef MATH3D_SSE
+        template<>
+        struct PacketRegister<4> {
+            using Type = __m128;
+            using Mask = __m128;
+            static Type broadcast(float const value) { return _mm_set1_ps(value); }
+            static Type load(float const* data) { return _mm_loadu_ps(data); }
+            static void store(float* data, Type const value) { _mm_storeu_ps(data, value); }
+            static Type add(Type const a, Type const b) { return _mm_add_ps(a, b); }
+            static Type subtract(Type const a, Type const b) { return _mm_sub_ps(a, b); }
+            static Type multiply(Type const a, Type const b) { return _mm_mul_ps(a, b); }
+            static Type divide(Type const a, Type const b) { return _mm_div_ps(a, b); }
+            static Type min(Type const a, Type const b) { return _mm_min_ps(a, b); }
+            static Type max(Type const a, Type const b) { return _mm_max_ps(a, b); }
+            static Type sqrt(Type const a) { return _mm_sqrt_ps(a); }
+            static Type abs(Type const a) { return _mm_andnot_ps(_mm_set1_ps(-0.f), a); }
+            static Mask lessThan(Type const a, Type const b) { return _mm_cmplt_ps(a, b); }
+            static Mask lessThanOrEqual(Type const a, Type const b) { return _mm_cmple_ps(a, b); }
+            static Mask logicalAnd(Mask const a, Mask const b) { return _mm_and_ps(a, b); }
+            static Mask logicalOr(Mask const a, Mask const b) { return _mm_or_ps(a, b); }
+            static Mask logicalNot(Mask const a) { return _mm_xor_ps(a, _mm_castsi128_ps(_mm_set1_epi32(-1))); }
+            static Type select(Mask const mask, Type const a, Type const b) {
+                return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+            }
+            static unsigned bits(Mask const mask) { return static_cast<unsigned>(_mm_movemask_ps(mask)); }
+        };
+#endif
+
+#ifdef MATH3D_AVX
+        template<>
+        struct PacketRegister<8> {
+            using Type = __m256;
+            using Mask = __m256;
+            static Type broadcast(float const value) { return _mm256_set1_ps(value); }
+            static Type load(float const* data) { return _mm256_loadu_ps(data); }
+            static void store(float* data, Type const value) { _mm256_storeu_ps(data, value); }
+            static Type add(Type const a, Type const b) { return _mm256_add_ps(a, b); }
+            static Type subtract(Type const a, Type const b) { return _mm256_sub_ps(a, b); }
+            static Type multiply(Type const a, Type const b) { return _mm256_mul_ps(a, b); }
+            static Type divide(Type const a, Type const b) { return _mm256_div_ps(a, b); }
+            static Type min(Type const a, Type const b) { return _mm256_min_ps(a, b); }
+            static Type max(Type const a, Type const b) { return _mm256_max_ps(a, b); }
+            static Type sqrt(Type const a) { return _mm256_sqrt_ps(a); }
+            static Type abs(Type const a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.f), a); }
+            static Mask lessThan(Type const a, Type const b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+            static Mask lessThanOrEqual(Type const a, Type const b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+            static Mask logicalAnd(Mask const a, Mask const b) { return _mm256_and_ps(a, b); }
+            static Mask logicalOr(Mask const a, Mask const b) { return _mm256_or_ps(a, b); }
+            static Mask logicalNot(Mask const a) { return _mm256_xor_ps(a, _mm256_castsi256_ps(_mm256_set1_epi32(-1))); }
+            static Type select(Mask const mask, Type const a, Type const b) { return _mm256_blendv_ps(b, a, mask); }
+            static unsigned bits(Mask const mask) { return static_cast<unsigned>(_mm256_movemask_ps(mask)); }
+        };
+#elif defined(MATH3D_SSE)
+        // Without AVX, eight lanes are held in two SSE registers
+        template<>
+        struct PacketRegister<8> {
+            using Half = PacketRegister<4>;
+            struct Type {
+                __m128 low;
+                __m128 high;
+            };
+            using Mask = Type;
+
+            template<typename Operation>
+            static Type apply(Type const a, Type const b, Operation&& operation) {
+                return {operation(a.low, b.low), operation(a.high, b.high)};
+            }
+
+            static Type broadcast(float const value) { return {Half::broadcast(value), Half::broadcast(value)}; }
+            static Type load(float const* data) { return {Half::load(data), Half::load(data + 4)}; }
+            static void store(float* data, Type const value) {
+                Half::store(data, value.low);
+                Half::store(data + 4, value.high);
+            }
+            static Type add(Type const a, Type const b) { return apply(a, b, Half::add); }
+            static Type subtract(Type const a, Type const b) { return apply(a, b, Half::subtract); }
+            static Type multiply(Type const a, Type const b) { return apply(a, b, Half::multiply); }
+            static Type divide(Type const a, Type const b) { return apply(a, b, Half::divide); }
+            static Type min(Type const a, Type const b) { return apply(a, b, Half::min); }
+            static Type max(Type const a, Type const b) { return apply(a, b, Half::max); }
+            static Type sqrt(Type const a) { return {Half::sqrt(a.low), Half::sqrt(a.high)}; }
+            static Type abs(Type const a) { return {Half::abs(a.low), Half::abs(a.high)}; }
+            static Mask lessThan(Type const a, Type const b) { return apply(a, b, Half::lessThan); }
+            static Mask lessThanOrEqual(Type const a, Type const b) { return apply(a, b, Half::lessThanOrEqual); }
+            static Mask logicalAnd(Mask const a, Mask const b) { return apply(a, b, Half::logicalAnd); }
+            static Mask logicalOr(Mask const a, Mask const b) { return apply(a, b, Half::logicalOr); }
+            static Mask logicalNot(Mask const a) { return {Half::logicalNot(a.low), Half::logicalNot(a.high)}; }
+            static Type select(Mask const mask, Type const a, Type const b) {
+                return {Half::select(mask.low, a.low, b.low), Half::select(mask.high, a.high, b.high)};
+            }
+            static unsigned bits(Mask const mask) { return Half::bits(mask.low) | (Half::bits(mask.high) << 4); }
+        };
+#endif
+
+#ifdef MATH3D_SSE
+        // Sixteen lanes are held in two eight lane registers
+        template<>
+        struct PacketRegister<16> {
+            using Half = PacketRegister<8>;
+            struct Type {
+                Half::Type low;
+                Half::Type high;
+            };
+            using Mask = Type;
+
+            template<typename Operation>
+            static Type apply(Type const a, Type const b, Operation&& operation) {
+                return {operation(a.low, b.low), operation(a.high, b.high)};
+            }
+
+            static Type broadcast(float const value) { return {Half::broadcast(value), Half::broadcast(value)}; }
+            static Type load(float const* data) { return {Half::load(data), Half::load(data + 8)}; }
+            static void store(float* data, Type const value) {
+                Half::store(data, value.low);
+                Half::store(data + 8, value.high);
+            }
+            static Type add(Type const a, Type const b) { return apply(a, b, Half::add); }
+            static Type subtract(Type const a, Type const b) { return apply(a, b, Half::subtract); }
+            static Type multiply(Type const a, Type const b) { return apply(a, b, Half::multiply); }
+            static Type divide(Type const a, Type const b) { return apply(a, b, Half::divide); }
+            static Type min(Type const a, Type const b) { return apply(a, b, Half::min); }
+            static Type max(Type const a, Type const b) { return apply(a, b, Half::max); }
+            static Type sqrt(Type const a) { return {Half::sqrt(a.low), Half::sqrt(a.high)}; }
+            static Type abs(Type const a) { return {Half::abs(a.low), Half::abs(a.high)}; }
+            static Mask lessThan(Type const a, Type const b) { return apply(a, b, Half::lessThan); }
+            static Mask lessThanOrEqual(Type const a, Type const b) { return apply(a, b, Half::lessThanOrEqual); }
+            static Mask logicalAnd(Mask const a, Mask const b) { return apply(a, b, Half::logicalAnd); }
+            static Mask logicalOr(Mask const a, Mask const b) { return apply(a, b, Half::logicalOr); }
+            static Mask logicalNot(Mask const a) { return {Half::logicalNot(a.low), Half::logicalNot(a.high)}; }
+            static Type select(Mask const mask, Type const a, Type const b) {
+                return {Half::select(mask.low, a.low, b.low), Half::select(mask.high, a.high, b.high)};
+            }
+            static unsigned bits(Mask const mask) { return Half::bits(mask.low) | (Half::bits(mask.high) << 8); }
+        };
+#endif
+    }
+}
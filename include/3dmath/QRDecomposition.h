@@ -0,0 +1,183 @@
+#pragma once
+
+#include "Matrix.h"
+#include "Vector.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+namespace math3d {
+
+    // QR decomposition by Householder reflections, A = QR, where A has at least as many rows as columns, Q has
+    // orthonormal columns and R is upper triangular
+    //
+    // Orthogonal transformations don't amplify errors, so least squares fits are solved from R directly rather than
+    // from the normal equations A^T A x = A^T b, whose condition number is the square of A's. Q and R are normalized so
+    // that the diagonal of R is non-negative, which makes Q the result of orthonormalizing the columns of A in order,
+    // like Gram-Schmidt but without its loss of orthogonality.
+    //
+    // R is stored in the upper triangle of a column-major matrix and the Householder vectors below the diagonal, with
+    // their leading ones implied. Q isn't formed unless it is asked for. Storage is MatrixStorage, so nothing is
+    // allocated unless the matrix is too large to be stored inline.
+    template<typename DataType, unsigned numRows, unsigned numCols>
+    class QRDecomposition {
+        static_assert(std::is_floating_point_v<DataType>, "Data type must be floating point");
+        static_assert(numRows >= numCols, "Matrix must have at least as many rows as columns");
+
+    public:
+        explicit QRDecomposition(Matrix<DataType, numRows, numCols> const& matrix) {
+            std::copy_n(matrix.getData(), numRows * numCols, factors.get());
+            decompose();
+        }
+
+        // A matrix has full rank if no diagonal element of R is negligible relative to the largest column of the
+        // matrix. Least squares solutions are unique only for matrices of full rank
+        [[nodiscard]]
+        bool isFullRank() const {
+            return fullRank;
+        }
+
+        // Least squares solution, i.e. the x that minimizes ||Ax - b||, which solves Ax = b exactly if A is square.
+        // Throws std::runtime_error if the matrix doesn't have full rank
+        [[nodiscard]]
+        Vector<DataType, numCols> solve(Vector<DataType, numRows> const& rightHandSide) const {
+            if (!fullRank) {
+                throw std::runtime_error("Matrix does not have full rank. Least squares solution is not unique");
+            }
+            Vector<DataType, numRows> transformed = rightHandSide;
+            applyQTranspose(transformed.getData());
+            Vector<DataType, numCols> solution;
+            DataType const* r = factors.get();
+            for (unsigned col = numCols; col-- > 0;) {
+                DataType const* column = r + col * numRows;
+                solution[col] = transformed[col] / column[col];
+                for (unsigned row = 0; row < col; ++row) {
+                    transformed[row] -= column[row] * solution[col];
+                }
+            }
+            return solution;
+        }
+
+        // numRows x numCols factor with orthonormal columns
+        [[nodiscard]]
+        Matrix<DataType, numRows, numCols> getQ() const {
+            Matrix<DataType, numRows, numCols> q;
+            auto* qData = const_cast<DataType*>(q.getData());
+            for (unsigned col = 0; col < numCols; ++col) {
+                DataType* column = qData + col * numRows;
+                column[col] = 1;
+                applyQ(column);
+                if (factors[col * numRows + col] < 0) {
+                    for (unsigned row = 0; row < numRows; ++row) {
+                        column[row] = -column[row];
+                    }
+                }
+            }
+            return q;
+        }
+
+        // numCols x numCols upper triangular factor with a non-negative diagonal
+        [[nodiscard]]
+        Matrix<DataType, numCols, numCols> getR() const {
+            Matrix<DataType, numCols, numCols> r;
+            for (unsigned row = 0; row < numCols; ++row) {
+                DataType const sign = factors[row * numRows + row] < 0 ? -1 : 1;
+                for (unsigned col = row; col < numCols; ++col) {
+                    r(row, col) = sign * factors[col * numRows + row];
+                }
+            }
+            return r;
+        }
+
+    private:
+        // Column k is reflected onto a multiple of e_k by H = I - tau v v^T, where v is scaled so that v_k = 1
+        void decompose() {
+            DataType* a = factors.get();
+            DataType largestColumnNorm {};
+            for (unsigned col = 0; col < numCols; ++col) {
+                DataType squaredNorm {};
+                for (unsigned row = 0; row < numRows; ++row) {
+                    squaredNorm += a[col * numRows + row] * a[col * numRows + row];
+                }
+                largestColumnNorm = std::max(largestColumnNorm, std::sqrt(squaredNorm));
+            }
+            auto const negligible = std::numeric_limits<DataType>::epsilon() * numRows * largestColumnNorm;
+
+            for (unsigned k = 0; k < numCols; ++k) {
+                DataType* column = a + k * numRows;
+                DataType squaredNormBelow {};
+                for (unsigned row = k + 1; row < numRows; ++row) {
+                    squaredNormBelow += column[row] * column[row];
+                }
+                if (squaredNormBelow == 0) {
+                    // Nothing to eliminate. H is the identity
+                    tau[k] = 0;
+                } else {
+                    DataType const diagonal = column[k];
+                    // Reflect onto the side that avoids cancellation in v_k = diagonal - beta
+                    DataType const beta = (diagonal < 0 ? 1 : -1) * std::sqrt(diagonal * diagonal + squaredNormBelow);
+                    tau[k] = (beta - diagonal) / beta;
+                    DataType const scale = 1 / (diagonal - beta);
+                    for (unsigned row = k + 1; row < numRows; ++row) {
+                        column[row] *= scale;
+                    }
+                    column[k] = beta;
+
+                    // Reflect the columns to the right, x -= tau (v . x) v
+                    for (unsigned col = k + 1; col < numCols; ++col) {
+                        DataType* x = a + col * numRows;
+                        DataType dot = x[k];
+                        for (unsigned row = k + 1; row < numRows; ++row) {
+                            dot += column[row] * x[row];
+                        }
+                        dot *= tau[k];
+                        x[k] -= dot;
+                        for (unsigned row = k + 1; row < numRows; ++row) {
+                            x[row] -= dot * column[row];
+                        }
+                    }
+                }
+                if (std::fabs(column[k]) <= negligible) {
+                    fullRank = false;
+                }
+            }
+        }
+
+        // x = H_k x, which is its own inverse
+        void reflect(unsigned const k, DataType* x) const {
+            if (tau[k] == 0) {
+                return;
+            }
+            DataType const* v = factors.get() + k * numRows;
+            DataType dot = x[k];
+            for (unsigned row = k + 1; row < numRows; ++row) {
+                dot += v[row] * x[row];
+            }
+            dot *= tau[k];
+            x[k] -= dot;
+            for (unsigned row = k + 1; row < numRows; ++row) {
+                x[row] -= dot * v[row];
+            }
+        }
+
+        // Q = H_0 H_1 ... H_(numCols - 1)
+        void applyQ(DataType* x) const {
+            for (unsigned k = numCols; k-- > 0;) {
+                reflect(k, x);
+            }
+        }
+
+        void applyQTranspose(DataType* x) const {
+            for (unsigned k = 0; k < numCols; ++k) {
+                reflect(k, x);
+            }
+        }
+
+        MatrixStorage<DataType, numRows * numCols> factors;
+        std::array<DataType, numCols> tau {};
+        bool fullRank = true;
+    };
+}
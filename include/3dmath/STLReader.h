@@ -0,0 +1,90 @@
+#pragma once
+
+#include "MappedFile.h"
+#include "STLWriter.h"
+#include "TypeAliases.h"
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+// Binary STL input
+//
+// Triangle records are read straight out of the memory mapped file. STL files don't share vertices between
+// triangles, so every triangle has its own three vertices unless the reader welds them, i.e. merges vertices at the
+// same position into one. Welding produces an indexed mesh with about a sixth as many vertices for closed meshes.
+// Normals in the file are ignored, since they can be computed from the vertices.
+
+namespace math3d {
+
+    enum class VertexWelding {
+        // Every triangle has its own vertices
+        None,
+        // Vertices at exactly the same position are merged
+        Exact
+    };
+
+    inline types::Mesh readSTL(std::filesystem::path const& inputFile,
+                               VertexWelding const welding = VertexWelding::Exact) {
+        MappedFile const file(inputFile);
+        auto const contents = file.getContents();
+        constexpr auto countOffset = STLWriter::headerLength;
+        constexpr auto recordsOffset = countOffset + sizeof(uint32_t);
+        if (contents.size() < recordsOffset) {
+            throw std::runtime_error(inputFile.string() + " is not a binary STL file. It is too short for a header");
+        }
+        uint32_t numberOfTriangles;
+        std::memcpy(&numberOfTriangles, contents.data() + countOffset, sizeof(numberOfTriangles));
+        if (contents.size() < recordsOffset + size_t{numberOfTriangles} * STLWriter::recordLength) {
+            throw std::runtime_error(inputFile.string() + " is not a binary STL file or is truncated. Its header "
+                                     "lists " + std::to_string(numberOfTriangles) + " triangles");
+        }
+
+        types::Mesh mesh;
+        mesh.tris.reserve(numberOfTriangles);
+        mesh.vertices.reserve(welding == VertexWelding::None ? 3 * size_t{numberOfTriangles} : numberOfTriangles);
+
+        // Vertices are welded by the bit patterns of their coordinates. -0 and +0 are the same position, so zeros
+        // are made positive first
+        struct VertexHash {
+            size_t operator()(std::array<uint32_t, 3> const& bits) const {
+                return (size_t{bits[0]} * 0x9E3779B1u) ^ (size_t{bits[1]} * 0x85EBCA77u) ^
+                       (size_t{bits[2]} * 0xC2B2AE3Du);
+            }
+        };
+        std::unordered_map<std::array<uint32_t, 3>, unsigned, VertexHash> vertexIndices;
+        if (welding == VertexWelding::Exact) {
+            vertexIndices.reserve(numberOfTriangles);
+        }
+
+        auto const* record = contents.data() + recordsOffset;
+        for (uint32_t triangle = 0; triangle < numberOfTriangles; ++triangle, record += STLWriter::recordLength) {
+            // Vertices follow the normal
+            std::array<float, 9> coordinates;
+            std::memcpy(coordinates.data(), record + 3 * sizeof(float), sizeof(coordinates));
+            std::array<unsigned, 3> indices;
+            for (unsigned corner = 0; corner < 3; ++corner) {
+                types::Vertex const vertex {coordinates[3 * corner] + 0.f,
+                                            coordinates[3 * corner + 1] + 0.f,
+                                            coordinates[3 * corner + 2] + 0.f};
+                auto const nextIndex = static_cast<unsigned>(mesh.vertices.size());
+                if (welding == VertexWelding::Exact) {
+                    auto const [existing, inserted] = vertexIndices.try_emplace(
+                        {std::bit_cast<uint32_t>(vertex.x), std::bit_cast<uint32_t>(vertex.y),
+                         std::bit_cast<uint32_t>(vertex.z)}, nextIndex);
+                    indices[corner] = existing->second;
+                    if (!inserted) continue;
+                } else {
+                    indices[corner] = nextIndex;
+                }
+                mesh.vertices.push_back(vertex);
+            }
+            mesh.tris.emplace_back(indices[0], indices[1], indices[2]);
+        }
+        return mesh;
+    }
+}
@@ -0,0 +1,179 @@
+#pragma once
+
+#include "PacketRegister.h"
+#include "TypeAliases.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+// Binary STL output
+//
+// A binary STL file is an 80 byte header, a 32-bit triangle count and a 50 byte record per triangle that holds its
+// normal, its three vertices and a 16-bit attribute. The writer packs records into a large buffer, which is written to
+// the file when it's full, so that a mesh costs a write per tens of thousands of triangles rather than several writes
+// per triangle. Any number of meshes can be written into the same file. The triangle count isn't known until the last
+// mesh is written, so it's patched into the file when the writer is closed.
+//
+// Normals are the cross products of the triangle edges b - a and c - a, which aren't normalized. They are computed
+// for groups of eight triangles at a time with SIMD.
+
+namespace math3d {
+
+    class STLWriter {
+    public:
+        static constexpr size_t headerLength = 80;
+        static constexpr size_t recordLength = 50;
+
+        explicit STLWriter(std::filesystem::path const& outputFile, std::string_view const header = defaultHeader)
+        : ofs(outputFile, std::ios::binary)
+        , buffer(std::make_unique<char[]>(bufferLength)) {
+            if (!ofs) {
+                throw std::runtime_error("Unable to open " + outputFile.string() + " for writing");
+            }
+            std::array<char, headerLength> headerBytes{};
+            std::copy_n(header.begin(), std::min(header.size(), headerLength), headerBytes.begin());
+            ofs.write(headerBytes.data(), headerLength);
+            // Placeholder for the triangle count
+            uint32_t const numberOfTrianglesInFile = 0;
+            ofs.write(reinterpret_cast<char const*>(&numberOfTrianglesInFile), sizeof(numberOfTrianglesInFile));
+        }
+
+        STLWriter(STLWriter const&) = delete;
+        STLWriter& operator=(STLWriter const&) = delete;
+
+        // Destructors can't report errors. Call close() to find out if the file was written successfully
+        ~STLWriter() {
+            try {
+                close();
+            } catch (...) {
+            }
+        }
+
+        // Write the triangles of a mesh. Each triangle is three indices into vertices
+        void write(std::span<types::Vertex const> vertices, std::span<types::Tri const> tris) {
+            if (!ofs.is_open()) {
+                throw std::runtime_error("Unable to write triangles. The STL writer was closed");
+            }
+            if (numberOfTriangles + tris.size() > std::numeric_limits<uint32_t>::max()) {
+                throw std::length_error("Binary STL files can hold at most " +
+                                        std::to_string(std::numeric_limits<uint32_t>::max()) + " triangles");
+            }
+            for (size_t first = 0; first < tris.size(); first += groupSize) {
+                auto const count = static_cast<unsigned>(std::min<size_t>(groupSize, tris.size() - first));
+                if (bufferPosition + count * recordLength > bufferLength) {
+                    flush();
+                }
+                writeGroup(vertices, tris.subspan(first, count));
+            }
+            numberOfTriangles += tris.size();
+        }
+
+        // Write the triangles of a primitive, generating its geometry first if it hasn't been generated
+        template<typename PrimitiveType>
+        void write(PrimitiveType& primitive) {
+            if (primitive.getVertices().empty()) {
+                primitive.generateGeometry();
+            }
+            write(primitive.getVertices(), primitive.getTris());
+        }
+
+        [[nodiscard]]
+        size_t getNumberOfTriangles() const {
+            return numberOfTriangles;
+        }
+
+        // Write buffered triangles and the triangle count, and close the file. Closing a closed writer does nothing
+        void close() {
+            if (!ofs.is_open()) return;
+            flush();
+            ofs.seekp(headerLength);
+            auto const numberOfTrianglesInFile = static_cast<uint32_t>(numberOfTriangles);
+            ofs.write(reinterpret_cast<char const*>(&numberOfTrianglesInFile), sizeof(numberOfTrianglesInFile));
+            ofs.close();
+            if (!ofs) {
+                throw std::runtime_error("Unable to write STL file");
+            }
+        }
+
+    private:
+        static constexpr std::string_view defaultHeader = "STL generated by 3dmath";
+        static constexpr unsigned groupSize = 8;
+        // Room for 2^16 triangles
+        static constexpr size_t bufferLength = recordLength << 16;
+        using Register = batch::PacketRegister<groupSize>;
+
+        // Append the records of up to groupSize triangles to the buffer
+        void writeGroup(std::span<types::Vertex const> vertices, std::span<types::Tri const> tris) {
+            // Vertex coordinates of the triangles, one array per coordinate of each of the three vertices. Lanes past
+            // the last triangle are zero
+            std::array<std::array<float, groupSize>, 9> coordinates{};
+            for (unsigned lane = 0; lane < tris.size(); ++lane) {
+                for (unsigned vertex = 0; vertex < 3; ++vertex) {
+                    auto const index = tris[lane][vertex];
+                    if (index >= vertices.size()) {
+                        throw std::out_of_range("Triangle vertex index " + std::to_string(index) +
+                                                " is out of bounds for a mesh of " +
+                                                std::to_string(vertices.size()) + " vertices");
+                    }
+                    for (unsigned axis = 0; axis < 3; ++axis) {
+                        coordinates[3 * vertex + axis][lane] = vertices[index][axis];
+                    }
+                }
+            }
+
+            // The same operations in the same order as the cross product of Vector, so that normals are identical
+            auto const load = [&coordinates](unsigned const i) { return Register::load(coordinates[i].data()); };
+            auto const ax = load(0), ay = load(1), az = load(2);
+            auto const abx = Register::subtract(load(3), ax);
+            auto const aby = Register::subtract(load(4), ay);
+            auto const abz = Register::subtract(load(5), az);
+            auto const acx = Register::subtract(load(6), ax);
+            auto const acy = Register::subtract(load(7), ay);
+            auto const acz = Register::subtract(load(8), az);
+            std::array<std::array<float, groupSize>, 3> normals;
+            Register::store(normals[0].data(), Register::subtract(Register::multiply(aby, acz),
+                                                                  Register::multiply(abz, acy)));
+            Register::store(normals[1].data(), Register::subtract(Register::multiply(acx, abz),
+                                                                  Register::multiply(abx, acz)));
+            Register::store(normals[2].data(), Register::subtract(Register::multiply(abx, acy),
+                                                                  Register::multiply(aby, acx)));
+
+            for (unsigned lane = 0; lane < tris.size(); ++lane) {
+                std::array<float, 12> record;
+                for (unsigned i = 0; i < 3; ++i) {
+                    record[i] = normals[i][lane];
+                }
+                for (unsigned i = 0; i < 9; ++i) {
+                    record[3 + i] = coordinates[i][lane];
+                }
+                auto* destination = buffer.get() + bufferPosition;
+                std::memcpy(destination, record.data(), sizeof(record));
+                // Attribute byte count, which is zero by convention
+                destination[48] = destination[49] = 0;
+                bufferPosition += recordLength;
+            }
+        }
+
+        void flush() {
+            ofs.write(buffer.get(), static_cast<std::streamsize>(bufferPosition));
+            if (!ofs) {
+                throw std::runtime_error("Unable to write STL file");
+            }
+            bufferPosition = 0;
+        }
+
+        std::ofstream ofs;
+        std::unique_ptr<char[]> buffer;
+        size_t bufferPosition = 0;
+        size_t numberOfTriangles = 0;
+    };
+}
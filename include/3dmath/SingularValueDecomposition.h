@@ -0,0 +1,373 @@
+#pragma once
+
+#include "Matrix.h"
+#include "Vector.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+namespace math3d {
+
+    // Singular value decomposition, A = U S V^T, where A has at least as many rows as columns, U has orthonormal
+    // columns, S is the diagonal matrix of singular values in decreasing order and V is orthogonal
+    //
+    // Singular values are computed by Jacobi rotations, which are accurate to the precision of the matrix elements.
+    // Matrices other than 3x3 are orthogonalized one-sidedly: pairs of columns of A are rotated until all are
+    // orthogonal, when the singular values are their lengths and U is the normalized columns.
+    //
+    // 3x3 matrices, e.g. the covariance matrices of point set registration (Kabsch) and matrices that have drifted from
+    // being rotations, take a path whose rotations are unrolled: A^T A is diagonalized by Jacobi rotations of the pairs
+    // of rows and columns (0, 1), (0, 2) and (1, 2), which gives V, and AV is reduced to a diagonal matrix by Givens
+    // rotations, which gives U. U is orthogonal even if A is singular, and nothing branches on the rank of A.
+    //
+    // Storage is MatrixStorage, so nothing is allocated unless the matrix is too large to be stored inline.
+    template<typename DataType, unsigned numRows, unsigned numCols>
+    class SingularValueDecomposition {
+        static_assert(std::is_floating_point_v<DataType>, "Data type must be floating point");
+        static_assert(numRows >= numCols, "Matrix must have at least as many rows as columns");
+
+    public:
+        explicit SingularValueDecomposition(Matrix<DataType, numRows, numCols> const& matrix) {
+            if constexpr (numRows == 3 && numCols == 3) {
+                decompose3x3(matrix.getData());
+            } else {
+                decompose(matrix.getData());
+            }
+        }
+
+        // numRows x numCols factor with orthonormal columns
+        [[nodiscard]]
+        Matrix<DataType, numRows, numCols> getU() const {
+            Matrix<DataType, numRows, numCols> result;
+            std::copy_n(u.get(), numRows * numCols, const_cast<DataType*>(result.getData()));
+            return result;
+        }
+
+        // Non-negative singular values in decreasing order
+        [[nodiscard]]
+        Vector<DataType, numCols> const& getSingularValues() const {
+            return singularValues;
+        }
+
+        [[nodiscard]]
+        Matrix<DataType, numCols, numCols> getV() const {
+            Matrix<DataType, numCols, numCols> result;
+            std::copy_n(v.get(), numCols * numCols, const_cast<DataType*>(result.getData()));
+            return result;
+        }
+
+        // Number of singular values that aren't negligible relative to the largest one
+        [[nodiscard]]
+        unsigned getRank() const {
+            unsigned rank = 0;
+            while (rank < numCols && singularValues[rank] > negligibleSingularValue()) {
+                ++rank;
+            }
+            return rank;
+        }
+
+        // Least squares solution of minimum length, x = V inverse(S) U^T b, where the inverses of negligible singular
+        // values are taken to be zero. Unlike the solutions of the other decompositions, it exists for every matrix
+        [[nodiscard]]
+        Vector<DataType, numCols> solve(Vector<DataType, numRows> const& rightHandSide) const {
+            Vector<DataType, numCols> solution;
+            for (unsigned k = 0; k < getRank(); ++k) {
+                DataType const* uColumn = u.get() + k * numRows;
+                DataType projection {};
+                for (unsigned row = 0; row < numRows; ++row) {
+                    projection += uColumn[row] * rightHandSide[row];
+                }
+                projection /= singularValues[k];
+                DataType const* vColumn = v.get() + k * numCols;
+                for (unsigned row = 0; row < numCols; ++row) {
+                    solution[row] += vColumn[row] * projection;
+                }
+            }
+            return solution;
+        }
+
+        // Rotation closest to the matrix in the Frobenius norm, U D V^T, where D is the identity, or has -1 as its
+        // last element if U V^T would be a reflection. This orthonormalizes a matrix that has drifted from being a
+        // rotation, and is the rotation that best aligns two point sets if the matrix is their cross-covariance
+        [[nodiscard]]
+        Matrix<DataType, numRows, numCols> getClosestRotation() const requires (numRows == numCols) {
+            Matrix<DataType, numRows, numCols> uTimesD = getU();
+            auto const uvTranspose = uTimesD * getV().transpose();
+            if (uvTranspose.determinant() < 0) {
+                for (unsigned row = 0; row < numRows; ++row) {
+                    uTimesD(row, numCols - 1) = -uTimesD(row, numCols - 1);
+                }
+                return uTimesD * getV().transpose();
+            }
+            return uvTranspose;
+        }
+
+    private:
+        [[nodiscard]]
+        DataType negligibleSingularValue() const {
+            return std::numeric_limits<DataType>::epsilon() * numRows * singularValues[0];
+        }
+
+        // Rotate columns p and q of a column-major matrix, (x_p, x_q) = (c x_p - s x_q, s x_p + c x_q)
+        template<unsigned columnLength>
+        static void rotateColumns(DataType* matrix, unsigned const p, unsigned const q, DataType const c,
+                                  DataType const s) {
+            DataType* columnP = matrix + p * columnLength;
+            DataType* columnQ = matrix + q * columnLength;
+            for (unsigned row = 0; row < columnLength; ++row) {
+                DataType const x = columnP[row];
+                DataType const y = columnQ[row];
+                columnP[row] = c * x - s * y;
+                columnQ[row] = s * x + c * y;
+            }
+        }
+
+        // Tangent of the Jacobi rotation angle that zeroes the off-diagonal element of the symmetric matrix
+        // [[pp, pq], [pq, qq]], the smaller of the two roots for stability. The tangent is zero if the rotation angle
+        // is too small to represent
+        static DataType jacobiTangent(DataType const pp, DataType const qq, DataType const pq) {
+            DataType const theta = (qq - pp) / (2 * pq);
+            DataType const tangent = 1 / (std::fabs(theta) + std::sqrt(theta * theta + 1));
+            return theta < 0 ? -tangent : tangent;
+        }
+
+        // One-sided Jacobi. Rotating columns p and q of A by the Jacobi rotation of their Gram matrix makes them
+        // orthogonal. Sweeps over all pairs are repeated until every pair is orthogonal to working precision
+        void decompose(DataType const* matrix) {
+            DataType* a = u.get();
+            std::copy_n(matrix, numRows * numCols, a);
+            for (unsigned i = 0; i < numCols; ++i) {
+                v[i * numCols + i] = 1;
+            }
+
+            constexpr unsigned maximumSweeps = 32;
+            bool rotated = true;
+            for (unsigned sweep = 0; sweep < maximumSweeps && rotated; ++sweep) {
+                rotated = false;
+                for (unsigned p = 0; p + 1 < numCols; ++p) {
+                    for (unsigned q = p + 1; q < numCols; ++q) {
+                        DataType pp {}, qq {}, pq {};
+                        for (unsigned row = 0; row < numRows; ++row) {
+                            DataType const x = a[p * numRows + row];
+                            DataType const y = a[q * numRows + row];
+                            pp += x * x;
+                            qq += y * y;
+                            pq += x * y;
+                        }
+                        if (std::fabs(pq) <= std::numeric_limits<DataType>::epsilon() * std::sqrt(pp * qq)) {
+                            continue;
+                        }
+                        DataType const t = jacobiTangent(pp, qq, pq);
+                        if (t == 0) {
+                            continue;
+                        }
+                        rotated = true;
+                        DataType const c = 1 / std::sqrt(t * t + 1);
+                        rotateColumns<numRows>(a, p, q, c, c * t);
+                        rotateColumns<numCols>(v.get(), p, q, c, c * t);
+                    }
+                }
+            }
+
+            std::array<unsigned, numCols> order;
+            for (unsigned col = 0; col < numCols; ++col) {
+                order[col] = col;
+                DataType squaredNorm {};
+                for (unsigned row = 0; row < numRows; ++row) {
+                    squaredNorm += a[col * numRows + row] * a[col * numRows + row];
+                }
+                singularValues[col] = std::sqrt(squaredNorm);
+            }
+            std::sort(order.begin(), order.end(), [this](unsigned const i, unsigned const j) {
+                return singularValues[i] > singularValues[j];
+            });
+            permuteColumns(order);
+
+            // Columns of U are normalized columns of AV. Columns whose singular values are negligible have no
+            // direction of their own, so they are completed to an orthonormal set instead
+            for (unsigned col = 0; col < numCols; ++col) {
+                DataType* column = a + col * numRows;
+                if (singularValues[col] > negligibleSingularValue()) {
+                    DataType const inverseLength = 1 / singularValues[col];
+                    for (unsigned row = 0; row < numRows; ++row) {
+                        column[row] *= inverseLength;
+                    }
+                } else {
+                    completeOrthonormalColumn(col);
+                }
+            }
+        }
+
+        // Reorder the singular values and the columns of U and V
+        void permuteColumns(std::array<unsigned, numCols> const& order) {
+            MatrixStorage<DataType, numRows * numCols> const unorderedU = u;
+            MatrixStorage<DataType, numCols * numCols> const unorderedV = v;
+            auto const unorderedSingularValues = singularValues;
+            for (unsigned col = 0; col < numCols; ++col) {
+                std::copy_n(unorderedU.get() + order[col] * numRows, numRows, u.get() + col * numRows);
+                std::copy_n(unorderedV.get() + order[col] * numCols, numCols, v.get() + col * numCols);
+                singularValues[col] = unorderedSingularValues[order[col]];
+            }
+        }
+
+        // Replace column col of U by the standard basis vector whose component orthogonal to the columns before it
+        // is longest, orthogonalized by Gram-Schmidt
+        void completeOrthonormalColumn(unsigned const col) {
+            DataType* column = u.get() + col * numRows;
+            DataType longest = -1;
+            for (unsigned axis = 0; axis < numRows; ++axis) {
+                // Squared length of e_axis minus its projections onto the previous columns
+                DataType squaredLength = 1;
+                for (unsigned previous = 0; previous < col; ++previous) {
+                    DataType const component = u[previous * numRows + axis];
+                    squaredLength -= component * component;
+                }
+                if (squaredLength > longest) {
+                    longest = squaredLength;
+                    std::fill_n(column, numRows, DataType{});
+                    column[axis] = 1;
+                }
+            }
+            // Gram-Schmidt is repeated once, which makes the column orthogonal to working precision
+            for (unsigned pass = 0; pass < 2; ++pass) {
+                for (unsigned previous = 0; previous < col; ++previous) {
+                    DataType const* previousColumn = u.get() + previous * numRows;
+                    DataType projection {};
+                    for (unsigned row = 0; row < numRows; ++row) {
+                        projection += previousColumn[row] * column[row];
+                    }
+                    for (unsigned row = 0; row < numRows; ++row) {
+                        column[row] -= projection * previousColumn[row];
+                    }
+                }
+            }
+            DataType squaredNorm {};
+            for (unsigned row = 0; row < numRows; ++row) {
+                squaredNorm += column[row] * column[row];
+            }
+            DataType const inverseLength = 1 / std::sqrt(squaredNorm);
+            for (unsigned row = 0; row < numRows; ++row) {
+                column[row] *= inverseLength;
+            }
+        }
+
+        // Jacobi rotation of rows and columns p and q of the symmetric matrix s, whose third row and column is r.
+        // Returns whether a rotation was applied
+        template<unsigned p, unsigned q>
+        static bool rotateSymmetric3x3(DataType (&s)[3][3], DataType* vData) {
+            constexpr unsigned r = 3 - p - q;
+            constexpr DataType squaredEpsilon = std::numeric_limits<DataType>::epsilon() *
+                                                std::numeric_limits<DataType>::epsilon();
+            if (s[p][q] * s[p][q] <= squaredEpsilon * s[p][p] * s[q][q]) {
+                return false;
+            }
+            DataType const t = jacobiTangent(s[p][p], s[q][q], s[p][q]);
+            if (t == 0) {
+                return false;
+            }
+            DataType const c = 1 / std::sqrt(t * t + 1);
+            DataType const sine = c * t;
+            s[p][p] -= t * s[p][q];
+            s[q][q] += t * s[p][q];
+            s[p][q] = s[q][p] = 0;
+            DataType const rp = s[r][p];
+            DataType const rq = s[r][q];
+            s[r][p] = s[p][r] = c * rp - sine * rq;
+            s[r][q] = s[q][r] = sine * rp + c * rq;
+            rotateColumns<3>(vData, p, q, c, sine);
+            return true;
+        }
+
+        // Zero element (q, p) of the column-major matrix b by a rotation of its rows p and q, which is undone on
+        // columns p and q of U
+        template<unsigned p, unsigned q>
+        static void eliminate3x3(DataType* b, DataType* uData) {
+            DataType const x = b[p * 3 + p];
+            DataType const y = b[p * 3 + q];
+            DataType const length = std::sqrt(x * x + y * y);
+            if (length == 0) {
+                return;
+            }
+            DataType const c = x / length;
+            DataType const s = y / length;
+            for (unsigned col = 0; col < 3; ++col) {
+                DataType const rowP = b[col * 3 + p];
+                DataType const rowQ = b[col * 3 + q];
+                b[col * 3 + p] = c * rowP + s * rowQ;
+                b[col * 3 + q] = c * rowQ - s * rowP;
+            }
+            rotateColumns<3>(uData, p, q, c, -s);
+        }
+
+        void decompose3x3(DataType const* a) {
+            DataType* vData = v.get();
+            DataType* uData = u.get();
+            for (unsigned i = 0; i < 3; ++i) {
+                vData[i * 3 + i] = 1;
+                uData[i * 3 + i] = 1;
+            }
+
+            // A^T A, whose eigenvectors are the columns of V
+            DataType s[3][3];
+            for (unsigned i = 0; i < 3; ++i) {
+                for (unsigned j = i; j < 3; ++j) {
+                    s[i][j] = s[j][i] = a[i * 3] * a[j * 3] + a[i * 3 + 1] * a[j * 3 + 1] + a[i * 3 + 2] * a[j * 3 + 2];
+                }
+            }
+            // Cyclic Jacobi converges quadratically. Random matrices take about four sweeps, the last of which
+            // rotates nothing
+            constexpr unsigned maximumSweeps = 16;
+            for (unsigned sweep = 0; sweep < maximumSweeps; ++sweep) {
+                bool const rotated01 = rotateSymmetric3x3<0, 1>(s, vData);
+                bool const rotated02 = rotateSymmetric3x3<0, 2>(s, vData);
+                bool const rotated12 = rotateSymmetric3x3<1, 2>(s, vData);
+                if (!rotated01 && !rotated02 && !rotated12) {
+                    break;
+                }
+            }
+
+            // B = AV has orthogonal columns, which are sorted by decreasing length
+            DataType b[9];
+            for (unsigned col = 0; col < 3; ++col) {
+                for (unsigned row = 0; row < 3; ++row) {
+                    b[col * 3 + row] = a[row] * vData[col * 3] + a[3 + row] * vData[col * 3 + 1] +
+                                       a[6 + row] * vData[col * 3 + 2];
+                }
+            }
+            auto const squaredLength = [&b](unsigned const col) {
+                return b[col * 3] * b[col * 3] + b[col * 3 + 1] * b[col * 3 + 1] + b[col * 3 + 2] * b[col * 3 + 2];
+            };
+            auto const sortPair = [&](unsigned const i, unsigned const j) {
+                if (squaredLength(i) < squaredLength(j)) {
+                    std::swap_ranges(b + i * 3, b + i * 3 + 3, b + j * 3);
+                    std::swap_ranges(vData + i * 3, vData + i * 3 + 3, vData + j * 3);
+                }
+            };
+            sortPair(0, 1);
+            sortPair(0, 2);
+            sortPair(1, 2);
+
+            // Givens QR of B. R is diagonal up to rounding, since the columns of B are orthogonal, and U = Q. The
+            // first two diagonal elements are non-negative by construction
+            eliminate3x3<0, 1>(b, uData);
+            eliminate3x3<0, 2>(b, uData);
+            eliminate3x3<1, 2>(b, uData);
+            singularValues[0] = b[0];
+            singularValues[1] = b[4];
+            singularValues[2] = b[8];
+            if (singularValues[2] < 0) {
+                singularValues[2] = -singularValues[2];
+                for (unsigned row = 0; row < 3; ++row) {
+                    uData[6 + row] = -uData[6 + row];
+                }
+            }
+        }
+
+        MatrixStorage<DataType, numRows * numCols> u;
+        MatrixStorage<DataType, numCols * numCols> v;
+        Vector<DataType, numCols> singularValues;
+    };
+}
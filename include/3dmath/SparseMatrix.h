@@ -0,0 +1,287 @@
+#pragma once
+
+#include "Batch.h"
+#include "TypeAliases.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Sparse matrices in compressed sparse row (CSR) format
+//
+// Only non-zero elements are stored. The column indices and values of the non-zeros of row i are stored at positions
+// [rowOffsets[i], rowOffsets[i + 1]) of the column index and value arrays, sorted by column. Memory and the cost of a
+// product scale with the number of non-zeros rather than with the number of rows times the number of columns, which
+// suits matrices such as mesh Laplacians and stiffness matrices that have a handful of non-zeros per row.
+//
+// Products of large matrices and vectors can be split across threads, each computing a range of rows of the result.
+
+namespace math3d {
+
+    template<typename DataType>
+    class SparseMatrix {
+        static_assert(std::is_floating_point_v<DataType>, "Data type must be floating point");
+
+    public:
+        // An element given by its row and column. Matrices are assembled from lists of elements
+        struct Element {
+            unsigned row;
+            unsigned column;
+            DataType value;
+        };
+
+        SparseMatrix() = default;
+
+        // Assemble a matrix from a list of elements in any order. Values of elements at the same position are summed,
+        // which is how finite element matrices are assembled from the contributions of their elements
+        SparseMatrix(unsigned const numRows, unsigned const numCols, std::span<Element const> const elements)
+        : numRows(numRows)
+        , numCols(numCols)
+        , rowOffsets(size_t{numRows} + 1) {
+            for (auto const& element : elements) {
+                if (element.row >= numRows || element.column >= numCols) {
+                    throw std::out_of_range("Element [" + std::to_string(element.row) + ',' +
+                                            std::to_string(element.column) + "] is outside a " + dimensions() +
+                                            " matrix");
+                }
+                ++rowOffsets[element.row + 1];
+            }
+            std::partial_sum(rowOffsets.begin(), rowOffsets.end(), rowOffsets.begin());
+
+            // Bucket elements by row, then sort each row by column and merge elements at the same position
+            std::vector<size_t> nextInRow(rowOffsets.begin(), rowOffsets.end() - 1);
+            columnIndices.resize(elements.size());
+            values.resize(elements.size());
+            for (auto const& element : elements) {
+                auto const position = nextInRow[element.row]++;
+                columnIndices[position] = element.column;
+                values[position] = element.value;
+            }
+            std::vector<std::pair<unsigned, DataType>> row;
+            size_t numNonZeros = 0;
+            for (unsigned rowIndex = 0; rowIndex < numRows; ++rowIndex) {
+                row.clear();
+                for (auto i = rowOffsets[rowIndex]; i < rowOffsets[rowIndex + 1]; ++i) {
+                    row.emplace_back(columnIndices[i], values[i]);
+                }
+                std::sort(row.begin(), row.end(), [](auto const& a, auto const& b) { return a.first < b.first; });
+                rowOffsets[rowIndex] = numNonZeros;
+                for (size_t i = 0; i < row.size(); ++i) {
+                    if (i != 0 && row[i].first == row[i - 1].first) {
+                        values[numNonZeros - 1] += row[i].second;
+                    } else {
+                        columnIndices[numNonZeros] = row[i].first;
+                        values[numNonZeros++] = row[i].second;
+                    }
+                }
+            }
+            rowOffsets[numRows] = numNonZeros;
+            columnIndices.resize(numNonZeros);
+            values.resize(numNonZeros);
+        }
+
+        SparseMatrix(unsigned const numRows, unsigned const numCols, std::vector<Element> const& elements)
+        : SparseMatrix(numRows, numCols, std::span<Element const>(elements)) {
+        }
+
+        // Take over arrays that are already in CSR format. Column indices of each row must be sorted and unique
+        SparseMatrix(unsigned const numRows, unsigned const numCols, std::vector<size_t> rowOffsets,
+                     std::vector<unsigned> columnIndices, std::vector<DataType> values)
+        : numRows(numRows)
+        , numCols(numCols)
+        , rowOffsets(std::move(rowOffsets))
+        , columnIndices(std::move(columnIndices))
+        , values(std::move(values)) {
+            validate();
+        }
+
+        [[nodiscard]]
+        unsigned getNumberOfRows() const {
+            return numRows;
+        }
+
+        [[nodiscard]]
+        unsigned getNumberOfColumns() const {
+            return numCols;
+        }
+
+        [[nodiscard]]
+        size_t getNumberOfNonZeros() const {
+            return values.size();
+        }
+
+        [[nodiscard]]
+        std::span<size_t const> getRowOffsets() const {
+            return rowOffsets;
+        }
+
+        [[nodiscard]]
+        std::span<unsigned const> getColumnIndices() const {
+            return columnIndices;
+        }
+
+        [[nodiscard]]
+        std::span<DataType const> getValues() const {
+            return values;
+        }
+
+        // Element in the given row and column, which is zero if it isn't stored. Throws std::out_of_range if the row
+        // or the column index is out of bounds
+        [[nodiscard]]
+        DataType at(unsigned const rowIndex, unsigned const columnIndex) const {
+            if (rowIndex >= numRows || columnIndex >= numCols) {
+                throw std::out_of_range("Invalid access: [" + std::to_string(rowIndex) + ',' +
+                                        std::to_string(columnIndex) + "] is not a valid element of a " +
+                                        dimensions() + " matrix");
+            }
+            auto const rowBegin = columnIndices.begin() + static_cast<std::ptrdiff_t>(rowOffsets[rowIndex]);
+            auto const rowEnd = columnIndices.begin() + static_cast<std::ptrdiff_t>(rowOffsets[rowIndex + 1]);
+            auto const column = std::lower_bound(rowBegin, rowEnd, columnIndex);
+            return column != rowEnd && *column == columnIndex ? values[column - columnIndices.begin()] : DataType{};
+        }
+
+        // Diagonal elements, including the zeros that aren't stored
+        [[nodiscard]]
+        std::vector<DataType> getDiagonal() const {
+            std::vector<DataType> diagonal(std::min(numRows, numCols));
+            for (unsigned row = 0; row < diagonal.size(); ++row) {
+                diagonal[row] = at(row, row);
+            }
+            return diagonal;
+        }
+
+        [[nodiscard]]
+        SparseMatrix transpose() const {
+            std::vector<size_t> transposeOffsets(size_t{numCols} + 1);
+            for (auto const column : columnIndices) {
+                ++transposeOffsets[column + 1];
+            }
+            std::partial_sum(transposeOffsets.begin(), transposeOffsets.end(), transposeOffsets.begin());
+            std::vector<unsigned> transposeColumns(columnIndices.size());
+            std::vector<DataType> transposeValues(values.size());
+            std::vector<size_t> next(transposeOffsets.begin(), transposeOffsets.end() - 1);
+            // Rows are visited in order, so the columns of every row of the transpose come out sorted
+            for (unsigned row = 0; row < numRows; ++row) {
+                for (auto i = rowOffsets[row]; i < rowOffsets[row + 1]; ++i) {
+                    auto const position = next[columnIndices[i]]++;
+                    transposeColumns[position] = row;
+                    transposeValues[position] = values[i];
+                }
+            }
+            return {numCols, numRows, std::move(transposeOffsets), std::move(transposeColumns),
+                    std::move(transposeValues)};
+        }
+
+        // result = this * x. result must not alias x
+        void multiply(std::span<DataType const> const x, std::span<DataType> const result,
+                      Execution const execution = Execution::Sequential) const {
+            if (x.size() != numCols || result.size() != numRows) {
+                throw std::invalid_argument("Incompatible dimensions: A " + dimensions() + " matrix can't be " +
+                                            "multiplied by a vector of size " + std::to_string(x.size()) +
+                                            " into a vector of size " + std::to_string(result.size()));
+            }
+            forEachRowRange(execution, [&](size_t const begin, size_t const end) {
+                for (auto row = begin; row < end; ++row) {
+                    DataType sum {};
+                    for (auto i = rowOffsets[row]; i < rowOffsets[row + 1]; ++i) {
+                        sum += values[i] * x[columnIndices[i]];
+                    }
+                    result[row] = sum;
+                }
+            });
+        }
+
+        [[nodiscard]]
+        std::vector<DataType> operator*(std::span<DataType const> const x) const {
+            std::vector<DataType> result(numRows);
+            multiply(x, result);
+            return result;
+        }
+
+        // Run kernel(begin, end) over ranges of rows. Rows are split so that each thread gets about as many non-zeros
+        // as a batch operation gets elements
+        template<typename Kernel>
+        void forEachRowRange(Execution const execution, Kernel&& kernel) const {
+            auto const nonZerosPerRow = std::max<size_t>(values.size() / std::max(numRows, 1u), 1);
+            batch::forEachRange(numRows, execution, kernel, batch::minimumElementsPerThread / nonZerosPerRow);
+        }
+
+    private:
+        [[nodiscard]]
+        std::string dimensions() const {
+            return std::to_string(numRows) + 'x' + std::to_string(numCols);
+        }
+
+        void validate() const {
+            if (rowOffsets.size() != size_t{numRows} + 1 || rowOffsets.front() != 0 ||
+                rowOffsets.back() != values.size() || columnIndices.size() != values.size()) {
+                throw std::invalid_argument("Malformed CSR arrays. A " + dimensions() + " matrix needs " +
+                                            std::to_string(numRows + 1) + " row offsets from 0 to the number of " +
+                                            "values, and as many column indices as values");
+            }
+            for (unsigned row = 0; row < numRows; ++row) {
+                if (rowOffsets[row] > rowOffsets[row + 1]) {
+                    throw std::invalid_argument("Malformed CSR arrays. Row offsets are decreasing at row " +
+                                                std::to_string(row));
+                }
+                for (auto i = rowOffsets[row]; i < rowOffsets[row + 1]; ++i) {
+                    bool const unsorted = i != rowOffsets[row] && columnIndices[i] <= columnIndices[i - 1];
+                    if (columnIndices[i] >= numCols || unsorted) {
+                        throw std::invalid_argument("Malformed CSR arrays. Column indices of row " +
+                                                    std::to_string(row) + " are not sorted, unique and less than " +
+                                                    std::to_string(numCols));
+                    }
+                }
+            }
+        }
+
+        unsigned numRows = 0;
+        unsigned numCols = 0;
+        std::vector<size_t> rowOffsets {0};
+        std::vector<unsigned> columnIndices;
+        std::vector<DataType> values;
+    };
+
+    // Graph Laplacian of a triangle mesh, L = D - A, where A is the adjacency matrix of the mesh's edges and D is the
+    // diagonal matrix of vertex degrees. L is symmetric positive semi-definite, with the constant vector in its null
+    // space, so systems such as (I + t L) x = b that smooth mesh data are symmetric positive definite
+    template<typename DataType>
+    SparseMatrix<DataType> buildGraphLaplacian(unsigned const numVertices, std::span<types::Tri const> const tris) {
+        using Element = typename SparseMatrix<DataType>::Element;
+        std::vector<Element> elements;
+        elements.reserve(tris.size() * 6 + numVertices);
+        for (unsigned vertex = 0; vertex < numVertices; ++vertex) {
+            elements.push_back({vertex, vertex, 0});
+        }
+        for (auto const& tri : tris) {
+            for (unsigned corner = 0; corner < 3; ++corner) {
+                auto const a = tri[corner];
+                auto const b = tri[(corner + 1) % 3];
+                if (a >= numVertices || b >= numVertices) {
+                    throw std::out_of_range("Triangle vertex index is out of bounds for " +
+                                            std::to_string(numVertices) + " vertices");
+                }
+                elements.push_back({a, b, 0});
+                elements.push_back({b, a, 0});
+            }
+        }
+        // Assembly merges the edges that triangles share, which leaves the sparsity pattern of L. Every
+        // off-diagonal element of a row is then an edge of weight -1, and the diagonal element is the vertex degree
+        SparseMatrix<DataType> const pattern(numVertices, numVertices, elements);
+        auto const rowOffsets = pattern.getRowOffsets();
+        auto const columnIndices = pattern.getColumnIndices();
+        std::vector<DataType> values(columnIndices.size(), -1);
+        for (unsigned row = 0; row < numVertices; ++row) {
+            auto const* const rowBegin = columnIndices.data() + rowOffsets[row];
+            auto const* const rowEnd = columnIndices.data() + rowOffsets[row + 1];
+            auto const diagonal = std::lower_bound(rowBegin, rowEnd, row) - columnIndices.data();
+            values[diagonal] = static_cast<DataType>(rowEnd - rowBegin - 1);
+        }
+        return {numVertices, numVertices, {rowOffsets.begin(), rowOffsets.end()},
+                {columnIndices.begin(), columnIndices.end()}, std::move(values)};
+    }
+}
@@ -3,7 +3,12 @@
 #include <cmath>
 #include <string>
 #include <initializer_list>
+#include <span>
+#include <array>
+#include <limits>
+#include <optional>
 
+#include "BatchTypes.h"
 #include "IdentityMatrix.h"
 #include "ScalingMatrix.h"
 #include "Vector.h"
@@ -33,6 +38,12 @@ namespace math3d {
         }
     };
 
+    template<unsigned N>
+    class RayPacket;
+
+    template<unsigned N>
+    struct PacketIntersectionResult;
+
     template<typename T>
     struct Bounds3D {
         Extent<T> x;
@@ -147,6 +158,21 @@ namespace math3d {
             z.merge(another.z);
         }
 
+        void merge(Vector3<T> const& point) {
+            x.merge({point.x, point.x});
+            y.merge({point.y, point.y});
+            z.merge({point.z, point.z});
+        }
+
+        // Compute bounds of a set of points. The points are reduced a vector register at a time where SIMD is
+        // available, and large sets can be split across threads by passing Execution::Parallel. Bounds of an empty
+        // set are invalid. Defined in BoundsKernels.h
+        [[nodiscard]]
+        static Bounds3D fromPoints(Points<T const> points, Execution execution = Execution::Sequential);
+
+        [[nodiscard]]
+        static Bounds3D fromPoints(Coordinates<T const> points, Execution execution = Execution::Sequential);
+
         [[nodiscard]]
         Vector3<T> min() const {
             return {x.min, y.min, z.min};
@@ -196,6 +222,10 @@ namespace math3d {
                 };
         }
 
+        // Intersect a packet of rays with the bounds. Defined in primitives/RayPacket.h
+        template<unsigned N>
+        [[nodiscard]] PacketIntersectionResult<N> intersectWithRays(RayPacket<N> const& rays) const;
+
         [[nodiscard]]
         Extent<T> extent(Direction dir) const {
             if (dir == Direction::x) {
@@ -214,6 +244,60 @@ namespace math3d {
         }
     };
 
+    // Builds bounds incrementally, e.g. while geometry is still being loaded. Points can be added one at a time or in
+    // blocks, which are reduced with Bounds3D::fromPoints and so need BoundsKernels.h. An accumulator is not
+    // synchronized; loaders that add points from several threads should use one accumulator per thread and merge them
+    // at the end
+    template<typename T>
+    class BoundsAccumulator {
+    public:
+        void add(Vector3<T> const& point) {
+            bounds.merge(point);
+            ++numberOfPoints;
+        }
+
+        void add(Points<T const> points, Execution const execution = Execution::Sequential) {
+            bounds.merge(Bounds3D<T>::fromPoints(points, execution));
+            numberOfPoints += points.size();
+        }
+
+        void add(Coordinates<T const> points, Execution const execution = Execution::Sequential) {
+            bounds.merge(Bounds3D<T>::fromPoints(points, execution));
+            numberOfPoints += points.size();
+        }
+
+        void merge(BoundsAccumulator const& another) {
+            bounds.merge(another.bounds);
+            numberOfPoints += another.numberOfPoints;
+        }
+
+        void reset() {
+            bounds.reset();
+            numberOfPoints = 0;
+        }
+
+        // Bounds of all points added so far. Bounds3D::isValid() requires a non-zero extent along every axis, so the
+        // bounds stay invalid for a single point or for coplanar points. Use isEmpty() to check if points were added
+        [[nodiscard]]
+        Bounds3D<T> const& getBounds() const {
+            return bounds;
+        }
+
+        [[nodiscard]]
+        bool isEmpty() const {
+            return numberOfPoints == 0;
+        }
+
+        [[nodiscard]]
+        size_t getNumberOfPoints() const {
+            return numberOfPoints;
+        }
+
+    private:
+        Bounds3D<T> bounds;
+        size_t numberOfPoints{};
+    };
+
     template<typename T>
     class Remapper final {
     public:
@@ -231,6 +315,11 @@ namespace math3d {
             return {remappedPoint.x, remappedPoint.y, remappedPoint.z};
         }
 
+        // Remap many points at once. Defined in BatchTransforms.h
+        void operator()(std::span<Vector3<T> const> sourcePoints, std::span<Vector3<T>> remappedPoints,
+                        Execution execution = Execution::Sequential) const;
+
+        // Matrix::inverse() is defined in MatrixOperations.h
         Matrix<T, 4, 4> getInverseTransform() {
             if (!remapTransform) {
                 computeRemapTransform();
@@ -9,13 +9,23 @@ class TranslationMatrix : public IdentityMatrix<DataType, 4, 4> {
 
 public:
     // Allow creation of an identity rotation matrix
-    TranslationMatrix() = default;
+    constexpr TranslationMatrix() = default;
 
     // Set 4th column to [tx, ty, tz, 1]
-    TranslationMatrix(Vector3<DataType> const& translation) {
+    constexpr TranslationMatrix(Vector3<DataType> const& translation) {
         this->operator[](3) = Vector<DataType, 4>(translation, static_cast<DataType>(1));
     }
 
+    // The inverse of a translation is the opposite translation
+    [[nodiscard]]
+    constexpr TranslationMatrix inverse() const {
+        TranslationMatrix result;
+        for (unsigned row = 0; row < 3; ++row) {
+            result(row, 3) = -(*this)(row, 3);
+        }
+        return result;
+    }
+
 };
 
 }
\ No newline at end of file
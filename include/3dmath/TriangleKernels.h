@@ -0,0 +1,99 @@
+#pragma once
+
+#include "Vector.h"
+#include <cmath>
+#include <limits>
+
+// Kernels for ray queries against triangles, shared by Triangle and by acceleration structures that store triangles
+// in their own layout.
+//
+// Triangles are given as a vertex and the edges from it to the other two vertices, which is all the Möller–Trumbore
+// algorithm needs. Callers that query the same triangle repeatedly should precompute the edges. Barycentric
+// coordinates are the weights of the three vertices in order, i.e. the vertex, the end of the first edge and the end
+// of the second edge.
+
+namespace math3d::kernels {
+
+    template<typename T>
+    struct RayTriangleHit {
+        // Ray parameter at the hit point. This is the distance from the ray origin when the direction is normalized
+        T distance;
+        // Weights of the ends of the first and second edges. The weight of the vertex is 1 - u - v
+        T u;
+        T v;
+
+        [[nodiscard]] Vector3<T> getBarycentricCoordinates() const {
+            return {T{1} - u - v, u, v};
+        }
+    };
+
+    // The Möller–Trumbore determinant is the triple product of the ray direction and the two edges, so its magnitude
+    // is at most |direction| |edge1| |edge2|. Rays are parallel to the triangle when the determinant is negligible
+    // relative to that bound, which keeps the test independent of the scale of the triangle and of the direction.
+    // Squared lengths avoid square roots, and a NaN determinant, from degenerate or non-finite input, is rejected too
+    template<typename T>
+    inline bool isDeterminantSignificant(T const determinant, T const directionLengthSquared,
+                                         T const edgeLengthsSquaredProduct) {
+        constexpr T squaredEpsilon = std::numeric_limits<T>::epsilon() * std::numeric_limits<T>::epsilon();
+        return determinant * determinant > squaredEpsilon * directionLengthSquared * edgeLengthsSquaredProduct;
+    }
+
+    // Möller–Trumbore ray-triangle intersection. Returns true and updates hit if the ray hits the triangle at a
+    // distance in [0, hit.distance). Passing the distance of the closest hit so far skips triangles that can't
+    // improve it, and passing infinity accepts any hit in front of the ray origin. Rays parallel to the triangle miss
+    template<typename T>
+    inline bool intersectRayTriangle(Vector3<T> const& origin, Vector3<T> const& direction, Vector3<T> const& vertex,
+                                     Vector3<T> const& edge1, Vector3<T> const& edge2, RayTriangleHit<T>& hit) {
+        Vector3<T> const p = direction * edge2;
+        auto const determinant = edge1.dot(p);
+        if (!isDeterminantSignificant(determinant, direction.dot(direction), edge1.dot(edge1) * edge2.dot(edge2))) {
+            return false;
+        }
+        auto const inverseDeterminant = T{1} / determinant;
+        Vector3<T> const s = origin - vertex;
+        auto const u = s.dot(p) * inverseDeterminant;
+        if (u < T{0} || u > T{1}) return false;
+        Vector3<T> const q = s * edge1;
+        auto const v = direction.dot(q) * inverseDeterminant;
+        if (v < T{0} || u + v > T{1}) return false;
+        auto const t = edge2.dot(q) * inverseDeterminant;
+        if (t < T{0} || t >= hit.distance) return false;
+        hit = {t, u, v};
+        return true;
+    }
+
+    // Precomputed dot products of a triangle's edges, which reduce barycentric coordinates of a point to two dot
+    // products and a handful of multiplications
+    template<typename T>
+    struct TriangleEdgeProducts {
+        T edge1LengthSquared;
+        T edge1DotEdge2;
+        T edge2LengthSquared;
+        T inverseDenominator;
+
+        TriangleEdgeProducts() = default;
+
+        TriangleEdgeProducts(Vector3<T> const& edge1, Vector3<T> const& edge2)
+        : edge1LengthSquared(edge1.dot(edge1))
+        , edge1DotEdge2(edge1.dot(edge2))
+        , edge2LengthSquared(edge2.dot(edge2))
+        , inverseDenominator(T{1} / (edge1LengthSquared * edge2LengthSquared - edge1DotEdge2 * edge1DotEdge2)) {
+        }
+    };
+
+    // Barycentric coordinates of a point in the plane of the triangle. Points off the plane are projected onto it.
+    // Coordinates are negative for points outside the triangle, and all three sum to one
+    template<typename T>
+    inline Vector3<T> barycentricCoordinates(Vector3<T> const& point, Vector3<T> const& vertex,
+                                             Vector3<T> const& edge1, Vector3<T> const& edge2,
+                                             TriangleEdgeProducts<T> const& products) {
+        Vector3<T> const toPoint = point - vertex;
+        auto const alongEdge1 = toPoint.dot(edge1);
+        auto const alongEdge2 = toPoint.dot(edge2);
+        auto const u = (products.edge2LengthSquared * alongEdge1 - products.edge1DotEdge2 * alongEdge2) *
+                       products.inverseDenominator;
+        auto const v = (products.edge1LengthSquared * alongEdge2 - products.edge1DotEdge2 * alongEdge1) *
+                       products.inverseDenominator;
+        return {T{1} - u - v, u, v};
+    }
+}
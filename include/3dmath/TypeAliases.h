@@ -15,4 +15,10 @@ namespace math3d::types {
         }
     };
     using Tris = std::vector<Tri>;
+
+    // Indexed triangle mesh
+    struct Mesh {
+        Vertices vertices;
+        Tris tris;
+    };
 }
\ No newline at end of file
@@ -13,16 +13,39 @@ namespace math3d {
     public:
         template<typename T>
         [[nodiscard]]
-        static T asDegrees(T radians) {
+        static constexpr T asDegrees(T radians) {
             return radians * constants::radiansToDegrees;
         };
 
         template<typename T>
         [[nodiscard]]
-        static T asRadians(T degrees) {
+        static constexpr T asRadians(T degrees) {
             return degrees / constants::radiansToDegrees;
         };
 
+        // Sine and cosine of an angle in degrees that can also be evaluated at compile time. Compile time evaluation
+        // uses a power series, which is exact for multiples of 90 degrees and accurate to within a few ulps otherwise.
+        // Runtime evaluation uses std::sin and std::cos
+        template<typename T>
+        [[nodiscard]]
+        static constexpr T sine(T const degrees) {
+            if consteval {
+                return sineAndCosine(degrees).first;
+            } else {
+                return static_cast<T>(std::sin(asRadians(degrees)));
+            }
+        }
+
+        template<typename T>
+        [[nodiscard]]
+        static constexpr T cosine(T const degrees) {
+            if consteval {
+                return sineAndCosine(degrees).second;
+            } else {
+                return static_cast<T>(std::cos(asRadians(degrees)));
+            }
+        }
+
         template<typename T>
         [[nodiscard]]
         static bool isZero(T const val) {
@@ -61,6 +84,14 @@ namespace math3d {
             return result;
         }
 
+        // Compare vector expressions such as u + v by evaluating them first
+        template<typename V1, typename V2>
+        requires CompatibleVectorOperands<V1, V2> && (VectorExpressionType<V1> || VectorExpressionType<V2>)
+        [[nodiscard]] static bool areEqual(V1 const v1, V2 const v2) {
+            using VectorType = Vector<typename V1::ValueType, V1::dimension>;
+            return areEqual(VectorType{v1}, VectorType{v2});
+        }
+
 
         template<typename T, unsigned size>
         [[nodiscard]] static T distanceBetween(Vector<T, size> const& point1, Vector<T, size> const& point2) {
@@ -83,6 +114,39 @@ namespace math3d {
             return {-vector.y, vector.x, 0};
         }
 
+        template<typename Derived, typename T, unsigned size>
+        [[nodiscard]]
+        static Vector<T, size> getPerpendicular(VectorExpression<Derived, T, size> const& expression) {
+            return getPerpendicular(expression.eval());
+        }
+
+    private:
+        template<typename T>
+        static constexpr std::pair<T, T> sineAndCosine(T const degrees) {
+            // Reduce the angle to a quadrant and an angle in [0, 90) within that quadrant
+            long double angle = degrees - 360.0L * static_cast<long long>(degrees / 360);
+            if (angle < 0) angle += 360;
+            auto const quadrant = static_cast<unsigned>(angle / 90) % 4;
+            long double const x = asRadians(angle - 90.0L * static_cast<unsigned>(angle / 90));
+
+            // Taylor series converge to long double precision within 15 terms for angles in [0, pi/2)
+            long double sine {}, cosine {}, sineTerm {x}, cosineTerm {1};
+            for (unsigned n = 0; n < 15; ++n) {
+                sine += sineTerm;
+                cosine += cosineTerm;
+                sineTerm *= -x * x / ((2 * n + 2) * (2 * n + 3));
+                cosineTerm *= -x * x / ((2 * n + 1) * (2 * n + 2));
+            }
+
+            switch (quadrant) {
+                case 0: return {static_cast<T>(sine), static_cast<T>(cosine)};
+                case 1: return {static_cast<T>(cosine), static_cast<T>(-sine)};
+                case 2: return {static_cast<T>(-sine), static_cast<T>(-cosine)};
+                default: return {static_cast<T>(-cosine), static_cast<T>(sine)};
+            }
+        }
+
+    public:
         static float asFloat(double value) {
             return std::round(value / constants::tolerance) * constants::tolerance;
         }
@@ -7,143 +7,79 @@
 #include <array>
 #include <iostream>
 #include <vector>
+#include <functional>
+#include <type_traits>
 
 namespace math3d {
 
-    // A vector whose elements are stored in contiguous memory
+    // Element storage for vectors. Elements are held in a std::array, and 1,2,3 and 4D vectors overlay named
+    // members on that array so vector data can be accessed in a semantically meaningful fashion.
+    // For example:
+    //      using Point2D = Vector<float, 2>
+    //      Point2D origin{10, 10};
+    //      origin.x += 10
+    //      origin.y += 10;
+    // or
+    //      using RGBColor = Vector<float,3>
+    //      RGBColor color{RED, GREEN, BLUE}
+    //      glClearColor(color.r, color.g, color.b);
+    // The named members and the array share storage, which keeps a vector exactly Size * sizeof(T) bytes and
+    // trivially copyable, so arrays of vectors can be memcpy'd and handed to SIMD code and graphics APIs as is
     template<typename T, unsigned Size>
-    class Vector {
-        // Proxy to an element in the vector
-        struct Proxy;
-    public:
-        // Vector data accessors that allow 1,2,3 and 4D vectors to be used in semantically meaningful fashion.
-        // For example:
-        //      using Point2D = Vector<float, 2>
-        //      Point2D origin{10, 10};
-        //      origin.x += 10
-        //      origin.y += 10;
-        // or
-        //      using RGBColor = Vector<float,3>
-        //      RGBColor color{RED, GREEN, BLUE}
-        //      glClearColor(color.r, color.g, color.b);
-        union {Proxy x{}; Proxy r;};
-        union {Proxy y{}; Proxy g;};
-        union {Proxy z{}; Proxy b;};
-        union {Proxy w{}; Proxy a;};
-
-    private:
-        // Definition of element proxy. Proxy is defined private so clients of vector cannot create proxies external to a vector
-        struct Proxy {
-            // Update element pointed to by the proxy to T. value is const T& to accept both l and rvalues
-            // e.g.
-            // using Point3D = Vector<float,3>;
-            // Point3D p1, p2;
-            // p1.x = 100.f
-            // or
-            // p2.x = p1.x;
-            void operator=(T const& value) { // NOLINT: We are intentionally using a different signature for = operator
-                if (!data) {
-                    throw std::runtime_error("Invalid access!");
-                }
-                *data = value;
-            }
-            // Convert to T so a proxy can be used in expressions that involve T
-            // e.g.
-            // void someFunction(float val);
-            // using Point3D = Vector<float,3>;
-            // Point3D p1;
-            // someFunction(p1.x);
-            operator T() {          // NOLINT: Supress implicit conversion clang-tidy warning since we want Proxy to be
-                                    //         converted to T implicitly without client calling Proxy.operator T() or
-                                    //         doing an ugly cast
-                return *data;
-            }
-            operator T() const {    // NOLINT
-                return *data;
-            }
-
-            // Convert the address of the proxy to the address of the object
-            // Allows conversions of this form:
-            // Point2D windowSize;
-            // getWindowSize(..., &windowSize.x, &windowSize.y);
-            T* operator&() {        // NOLINT
-                return data;
-            }
-
-            // Convenience functions for using vector's convenience members in shorthand expressions
-            void operator+=(T const& another) {
-                *data += another;
-            }
-            void operator-=(T const& another) {
-                *data -= another;
-            }
-            void operator*=(T const& another) {
-                *data *= another;
-            }
-            void operator/=(T const& another) {
-                *data /= another;
-            }
-            void operator+=(Proxy const& another) {
-                *data += *(another.data);
-            }
-            void operator-=(Proxy const& another) {
-                *data -= *(another.data);
-            }
-            void operator*=(Proxy const& another) {
-                *data *= *(another.data);
-            }
-            void operator/=(Proxy const& another) {
-                *data /= *(another.data);
-            }
+    struct VectorStorage {
+        std::array<T, Size> data{};
+    };
 
-        private:
-            // Clear the proxy. Permits a Vector to be moved meaningfully by allowing the r-value that's moved to have its proxies
-            // null-ed out. Defined private to prevent clients of vector from clobbering the internal state of a vector
-            void reset() {
-                data = nullptr;
-            }
+    template<typename T>
+    struct VectorStorage<T, 1> {
+        union {
+            std::array<T, 1> data{};
+            struct { T x; };
+            struct { T r; };
+        };
+    };
 
-            void bind(T& element) {
-                if(!data) {
-                    data = &element;
-                } else {
-                    throw std::runtime_error("Proxy already bound");
-                }
-            }
+    template<typename T>
+    struct VectorStorage<T, 2> {
+        union {
+            std::array<T, 2> data{};
+            struct { T x, y; };
+            struct { T r, g; };
+        };
+    };
 
-            T* data {};
+    template<typename T>
+    struct VectorStorage<T, 3> {
+        union {
+            std::array<T, 3> data{};
+            struct { T x, y, z; };
+            struct { T r, g, b; };
+        };
+    };
 
-            // Allow the outer class Vector to call reset() to facilitate move operations
-            friend Vector;
+    template<typename T>
+    struct VectorStorage<T, 4> {
+        union {
+            std::array<T, 4> data{};
+            struct { T x, y, z, w; };
+            struct { T r, g, b, a; };
         };
+    };
 
-        // These macros prevent code duplication in vector's constructors and operators
-        #define SET_CONVENIENCE_MEMBERS           \
-            switch (Size) {                       \
-            case 4:                               \
-                w.bind(data[3]);                  \
-            case 3:                               \
-                z.bind(data[2]);                  \
-            case 2:                               \
-                y.bind(data[1]);                  \
-            case 1:                               \
-                x.bind(data[0]);                  \
-            default:                              \
-                break;                            \
-            }
-
-        #define RESET_CONVENIENCE_MEMBERS(Vector) \
-            Vector.x.reset();                     \
-            Vector.y.reset();                     \
-            Vector.z.reset();                     \
-            Vector.w.reset();
+    // Base class of lazily evaluated vector arithmetic expressions. Defined after Vector
+    template<typename Derived, typename T, unsigned Size>
+    class VectorExpression;
 
+    // A vector whose elements are stored in contiguous memory
+    template<typename T, unsigned Size>
+    class Vector : public VectorStorage<T, Size> {
         public:
-            Vector() {
-                SET_CONVENIENCE_MEMBERS
-            }
+            using ValueType = T;
+            static constexpr unsigned dimension = Size;
 
-            Vector(std::initializer_list<T> const& vals) {
+            Vector() = default;
+
+            constexpr Vector(std::initializer_list<T> const& vals) {
                 if (vals.size() != Size) {
                     throw std::invalid_argument("Dimension mismatch: Vector's dimension is " +
                                                 std::to_string(Size) + " Input size is " +
@@ -152,48 +88,18 @@ namespace math3d {
                 for (size_t i = 0; i < vals.size(); ++i) {
                     data[i] = std::data(vals)[i];
                 }
-                SET_CONVENIENCE_MEMBERS
             }
 
             // Convenience constructor to build a vector with a different last component
-            Vector(Vector<T, Size-1> const& another, T const val) {
+            constexpr Vector(Vector<T, Size-1> const& another, T const val) {
                 for (auto i = 0u; i < Size-1; ++i) {
-                    data[i] = another[i];
+                    data[i] = another.getData()[i];
                 }
                 data[Size-1] = val;
-                SET_CONVENIENCE_MEMBERS
-            }
-
-            Vector(Vector const& other) {
-               this->operator=(other);
-               SET_CONVENIENCE_MEMBERS
-            }
-
-            Vector& operator=(Vector const& rhs) {
-                if (&rhs != this) {
-                    for (unsigned i = 0; i < Size; ++i) {
-                        data[i] = rhs.data[i];
-                    }
-                }
-                return *this;
-            }
-
-            Vector(Vector&& other) noexcept {
-                data = std::move(other.data);
-                SET_CONVENIENCE_MEMBERS
-                RESET_CONVENIENCE_MEMBERS(other)
-            }
-
-            Vector& operator=(Vector&& other) noexcept {
-                if (&other != this) {
-                    data = std::move(other.data);
-                    RESET_CONVENIENCE_MEMBERS(other)
-                }
-                return *this;
             }
 
             // Conversion constructor to build from an STL vector
-            explicit Vector(std::vector<T> const& v) {
+            explicit constexpr Vector(std::vector<T> const& v) {
                 if (Size != v.size()) {
                     throw std::invalid_argument("Dimension mismatch: Vector's dimension is " +
                                                 std::to_string(Size) + " Input size is " +
@@ -202,69 +108,49 @@ namespace math3d {
                 for (size_t i = 0; i < v.size(); ++i) {
                     data[i] = v[i];
                 }
-                SET_CONVENIENCE_MEMBERS
             }
 
-            // Add this vector to another and return the sum
-            Vector operator+(Vector const& another) const {
-                Vector result;
-                for (unsigned i = 0; i < Size; ++i) {
-                    result.data[i] = this->data[i] + another.data[i];
-                }
-                return result;
-            } 
+            // Evaluate a vector expression such as a + (s * b) - c. Every element of the expression is computed in a
+            // single pass without building intermediate vectors
+            template<typename Derived, typename AnotherType>
+            constexpr Vector(VectorExpression<Derived, AnotherType, Size> const& expression) { // NOLINT: Implicit evaluation is intended
+                assign(static_cast<Derived const&>(expression));
+            }
 
-            // Subtract this vector from another and return the difference
-            Vector operator-(Vector const& another) const {
-                Vector result;
-                for (unsigned i = 0; i < Size; ++i) {
-                    result.data[i] = this->data[i] - another.data[i];
-                }
-                return result;
+            template<typename Derived, typename AnotherType>
+            constexpr Vector& operator=(VectorExpression<Derived, AnotherType, Size> const& expression) {
+                assign(static_cast<Derived const&>(expression));
+                return *this;
             }
 
-            T const& operator[](const unsigned index) const {
-                if (index >= Size)
-                    throw std::invalid_argument(std::to_string(index) + " is out of bounds."
-                                                " Vector dimension is " + std::to_string(Size));
+            // Element access. Indices are not validated unless the library is built with MATH3D_BOUNDS_CHECKS.
+            // Use at() for access that is always validated
+            constexpr T const& operator[](const unsigned index) const {
+#ifdef MATH3D_BOUNDS_CHECKS
+                validateIndex(index);
+#endif
                 return data[index];
             }
 
-            T& operator[](const unsigned index) {
-                if (index >= Size)
-                    throw std::invalid_argument(std::to_string(index) + " is out of bounds."
-                                                " Vector dimension is " + std::to_string(Size));
+            constexpr T& operator[](const unsigned index) {
+#ifdef MATH3D_BOUNDS_CHECKS
+                validateIndex(index);
+#endif
                 return data[index];
             }
-            
-            // Compute cross product of this vector and another and return the mutually orthonormal vector
-            Vector operator*(Vector const& another) const {
-                static_assert(Size == 3, "Cross product can only be computed for 3D vectors");
-                Vector result;
-                auto* v1 = getData();
-                auto* v2 = another.getData();
-                result[0] = v1[1]*v2[2] - v1[2]*v2[1];
-                result[1] = v2[0]*v1[2] - v1[0]*v2[2];
-                result[2] = v1[0]*v2[1] - v1[1]*v2[0];
-                return result; 
-            }
-
-            Vector operator*(T const scalar) const {
-                Vector result;
-                for(auto i = 0; i < Size; ++i) {
-                    result[i] = scalar * data[i];
-                }
-                return result;
+
+            // Element access that throws std::invalid_argument if the index is out of bounds
+            constexpr T const& at(const unsigned index) const {
+                validateIndex(index);
+                return data[index];
             }
 
-            Vector operator-() const {
-                Vector result;
-                for(auto i = 0; i < Size; ++i) {
-                    result[i] = -data[i];
-                }
-                return result;
+            constexpr T& at(const unsigned index) {
+                validateIndex(index);
+                return data[index];
             }
 
+
             Vector& normalize() {
                 T norm = length();
                 for (size_t i = 0; i < Size; ++i) {
@@ -286,7 +172,7 @@ namespace math3d {
                 return static_cast<T> (sqrt(lengthSquared()));
             }
 
-            T lengthSquared() const {
+            constexpr T lengthSquared() const {
                 T result = 0;
                 for (size_t i = 0; i < Size; ++i) {
                     result += (data[i] * data[i]);
@@ -294,39 +180,41 @@ namespace math3d {
                 return result;
             }
 
-            Vector operator/(const T scalar) const {
-                Vector result;
-                for (size_t i = 0; i < Size; ++i) {
-                    result.data[i] = data[i]/scalar;
-                }
-                return result;
-            }
-
-            void operator/=(const T scalar) {
+            constexpr void operator/=(const T scalar) {
                 for (size_t i = 0; i < Size; ++i) {
                     data[i] /= scalar;
                 }
             }
 
-            void operator+=(Vector const& another) {
+            constexpr void operator+=(Vector const& another) {
                 for (size_t i = 0; i < Size; ++i) {
-                    data[i] += another[i];
+                    data[i] += another.data[i];
                 }
             }
 
-            T dot(Vector const& another) const {
+            constexpr T dot(Vector const& another) const {
                 T proj {};
                 for (size_t i = 0; i < Size; ++i)
-                    proj += this->operator[](i) * another[i];
+                    proj += data[i] * another.data[i];
+                return proj;
+            }
+
+            // Dot product with a vector expression that evaluates the expression's elements as they are consumed
+            template<typename Derived>
+            constexpr T dot(VectorExpression<Derived, T, Size> const& expression) const {
+                auto const& another = static_cast<Derived const&>(expression);
+                T proj {};
+                for (unsigned i = 0; i < Size; ++i)
+                    proj += data[i] * another[i];
                 return proj;
             }
 
             template<typename AnotherType>
-            operator Vector<AnotherType, Size>() const { // NOLINT
+            constexpr operator Vector<AnotherType, Size>() const { // NOLINT
                 static_assert(std::is_floating_point<AnotherType>::value, "Cannot convert vector to non-floating point types");
                 Vector<AnotherType, Size> result;
                 for (unsigned i = 0; i < Size; ++i) {
-                    result[i] = data[i];
+                    result.getData()[i] = data[i];
                 }
                 return result;
             }
@@ -340,20 +228,20 @@ namespace math3d {
             [[nodiscard]]
             VectorProjection getVectorProjection(Vector const& u) const {
                 VectorProjection result;
-                auto uNormalized = u / u.length();
+                Vector uNormalized = u / u.length();
                 result.parallel = uNormalized * this->dot(uNormalized);
                 result.perpendicular = *this - result.parallel;
                 return result;
             }
 
-            T const* getData() const { return data.data(); }
-            T* getData() { return data.data(); }
+            constexpr T const* getData() const { return data.data(); }
+            constexpr T* getData() { return data.data(); }
 
             [[nodiscard]]
             std::string asString() const {
                 std::string result{'['};
                 for (auto i = 0; i < Size; ++i) {
-                    result += std::to_string((*this)[i]) + ' ';
+                    result += std::to_string(data[i]) + ' ';
                 }
                 result.erase(result.size() - 1);
                 result += ']';
@@ -363,7 +251,7 @@ namespace math3d {
             void print(std::ostream& os) const {
                 os << '[';
                 for (auto i = 0; i < Size; ++i) {
-                    os << (*this)[i];
+                    os << data[i];
                     os << ((i == Size - 1) ? ']' : ',');
                 }
             }
@@ -372,23 +260,257 @@ namespace math3d {
                 print(std::cout);
             }
 
-            std::array<T, Size> const& getComponents() const {
+            constexpr std::array<T, Size> const& getComponents() const {
                 return data;
             }
 
         protected:
-            std::array<T, Size> data{};
+            using VectorStorage<T, Size>::data;
+
+        private:
+            template<typename Expression>
+            constexpr void assign(Expression const& expression) {
+                for (unsigned i = 0; i < Size; ++i) {
+                    data[i] = static_cast<T>(expression[i]);
+                }
+            }
+
+            static constexpr void validateIndex(unsigned const index) {
+                if (index >= Size) [[unlikely]] {
+                    throw std::invalid_argument(std::to_string(index) + " is out of bounds."
+                                                " Vector dimension is " + std::to_string(Size));
+                }
+            }
     };
 
+    static_assert(sizeof(Vector<float, 3>) == 3 * sizeof(float), "Vectors should not carry any storage besides their elements");
+    static_assert(std::is_trivially_copyable_v<Vector<float, 3>>, "Vectors should be trivially copyable");
+    static_assert(std::is_standard_layout_v<Vector<float, 3>>, "Vectors should have standard layout");
+
     template<typename DataType, unsigned numRows>
     std::ostream& operator << (std::ostream& os, Vector<DataType, numRows> const& v) {
         v.print(os);
         return os;
     }
 
-    template <typename DataType, unsigned numRows>
-    Vector<DataType, numRows> operator*(DataType scalar, Vector<DataType, numRows> const& vector) {
-        return vector * scalar;
+    // Expression templates for vector arithmetic
+    //
+    // Adding, subtracting, negating and scaling vectors does not compute a result right away. These operations
+    // return lightweight expression objects that describe the computation, and the computation happens when the
+    // expression is assigned to a vector or when its elements are read. Consequently, an expression such as
+    //      Vector3<double> corner = origin + (halfSize * horizontalAxis) + (halfSize * verticalAxis);
+    // is evaluated in a single loop over the elements of corner, without any temporary vectors.
+    //
+    // Expressions reference vector operands that are lvalues and store temporaries and sub-expressions by value,
+    // so an expression held in an auto variable does not refer to destroyed temporaries. It does refer to the named
+    // vectors it was built from, and reflects any changes made to them before the expression is evaluated
+    template<typename Derived, typename T, unsigned Size>
+    class VectorExpression {
+        public:
+            using ValueType = T;
+            static constexpr unsigned dimension = Size;
+
+            [[nodiscard]]
+            constexpr Vector<T, Size> eval() const {
+                return Vector<T, Size>{derived()};
+            }
+
+            constexpr T dot(Vector<T, Size> const& another) const {
+                return another.dot(derived());
+            }
+
+            template<typename AnotherDerived>
+            constexpr T dot(VectorExpression<AnotherDerived, T, Size> const& expression) const {
+                auto const& another = static_cast<AnotherDerived const&>(expression);
+                T proj {};
+                for (unsigned i = 0; i < Size; ++i)
+                    proj += derived()[i] * another[i];
+                return proj;
+            }
+
+            constexpr T lengthSquared() const {
+                return eval().lengthSquared();
+            }
+
+            T length() const {
+                return eval().length();
+            }
+
+            [[nodiscard]]
+            Vector<T, Size> normalize() const {
+                return eval().normalize();
+            }
+
+            [[nodiscard]]
+            std::string asString() const {
+                return eval().asString();
+            }
+
+        private:
+            constexpr Derived const& derived() const {
+                return static_cast<Derived const&>(*this);
+            }
+    };
+
+    template<typename V>
+    concept VectorType = requires(V const& v) { []<typename T, unsigned Size>(Vector<T, Size> const&){}(v); };
+
+    template<typename E>
+    concept VectorExpressionType =
+        requires(E const& e) { []<typename Derived, typename T, unsigned Size>(VectorExpression<Derived, T, Size> const&){}(e); };
+
+    template<typename V>
+    concept VectorOperand = VectorType<std::remove_cvref_t<V>> || VectorExpressionType<std::remove_cvref_t<V>>;
+
+    template<typename V1, typename V2>
+    concept CompatibleVectorOperands =
+        VectorOperand<V1> && VectorOperand<V2> &&
+        std::is_same_v<typename std::remove_cvref_t<V1>::ValueType, typename std::remove_cvref_t<V2>::ValueType> &&
+        std::remove_cvref_t<V1>::dimension == std::remove_cvref_t<V2>::dimension;
+
+    // Unchecked element access for vector operands of expressions
+    template<typename Operand>
+    constexpr auto vectorElement(Operand const& operand, unsigned const index) {
+        if constexpr (VectorType<Operand>) {
+            return operand.getData()[index];
+        } else {
+            return operand[index];
+        }
+    }
+
+    // Vectors that are lvalues are stored as references. Temporary vectors and expressions are stored by value
+    template<typename Operand>
+    using StoredVectorOperand =
+        std::conditional_t<VectorType<std::remove_cvref_t<Operand>> && std::is_lvalue_reference_v<Operand>,
+                           std::remove_cvref_t<Operand> const&,
+                           std::remove_cvref_t<Operand>>;
+
+    // Element-wise operation on two vector operands
+    template<typename LHS, typename RHS, typename Operation>
+    class VectorBinaryExpression :
+        public VectorExpression<VectorBinaryExpression<LHS, RHS, Operation>,
+                                typename std::remove_cvref_t<LHS>::ValueType, std::remove_cvref_t<LHS>::dimension> {
+        public:
+            template<typename L, typename R>
+            constexpr VectorBinaryExpression(L&& lhs, R&& rhs)
+            : lhs(std::forward<L>(lhs))
+            , rhs(std::forward<R>(rhs)) {
+            }
+
+            constexpr auto operator[](unsigned const index) const {
+                return Operation{}(vectorElement(lhs, index), vectorElement(rhs, index));
+            }
+
+        private:
+            LHS lhs;
+            RHS rhs;
+    };
+
+    // Element-wise operation on a vector operand and a scalar
+    template<typename Operand, typename Operation>
+    class VectorScalarExpression :
+        public VectorExpression<VectorScalarExpression<Operand, Operation>,
+                                typename std::remove_cvref_t<Operand>::ValueType, std::remove_cvref_t<Operand>::dimension> {
+        using T = typename std::remove_cvref_t<Operand>::ValueType;
+        public:
+            template<typename O>
+            constexpr VectorScalarExpression(O&& operand, T const scalar)
+            : operand(std::forward<O>(operand))
+            , scalar(scalar) {
+            }
+
+            constexpr auto operator[](unsigned const index) const {
+                return Operation{}(vectorElement(operand, index), scalar);
+            }
+
+        private:
+            Operand operand;
+            T scalar;
+    };
+
+    // Element-wise operation on a single vector operand
+    template<typename Operand, typename Operation>
+    class VectorUnaryExpression :
+        public VectorExpression<VectorUnaryExpression<Operand, Operation>,
+                                typename std::remove_cvref_t<Operand>::ValueType, std::remove_cvref_t<Operand>::dimension> {
+        public:
+            template<typename O>
+            explicit constexpr VectorUnaryExpression(O&& operand)
+            : operand(std::forward<O>(operand)) {
+            }
+
+            constexpr auto operator[](unsigned const index) const {
+                return Operation{}(vectorElement(operand, index));
+            }
+
+        private:
+            Operand operand;
+    };
+
+    // Sum of two vectors
+    template<typename LHS, typename RHS> requires CompatibleVectorOperands<LHS, RHS>
+    constexpr auto operator+(LHS&& lhs, RHS&& rhs) {
+        return VectorBinaryExpression<StoredVectorOperand<LHS>, StoredVectorOperand<RHS>, std::plus<>>
+            {std::forward<LHS>(lhs), std::forward<RHS>(rhs)};
+    }
+
+    // Difference of two vectors
+    template<typename LHS, typename RHS> requires CompatibleVectorOperands<LHS, RHS>
+    constexpr auto operator-(LHS&& lhs, RHS&& rhs) {
+        return VectorBinaryExpression<StoredVectorOperand<LHS>, StoredVectorOperand<RHS>, std::minus<>>
+            {std::forward<LHS>(lhs), std::forward<RHS>(rhs)};
+    }
+
+    // Negation of a vector
+    template<typename Operand> requires VectorOperand<Operand>
+    constexpr auto operator-(Operand&& operand) {
+        return VectorUnaryExpression<StoredVectorOperand<Operand>, std::negate<>>{std::forward<Operand>(operand)};
+    }
+
+    // Product of a vector and a scalar
+    template<typename Operand, typename Scalar> requires VectorOperand<Operand> && std::is_arithmetic_v<Scalar>
+    constexpr auto operator*(Operand&& operand, Scalar const scalar) {
+        using T = typename std::remove_cvref_t<Operand>::ValueType;
+        return VectorScalarExpression<StoredVectorOperand<Operand>, std::multiplies<>>
+            {std::forward<Operand>(operand), static_cast<T>(scalar)};
+    }
+
+    template<typename Scalar, typename Operand> requires VectorOperand<Operand> && std::is_arithmetic_v<Scalar>
+    constexpr auto operator*(Scalar const scalar, Operand&& operand) {
+        return std::forward<Operand>(operand) * scalar;
+    }
+
+    // Quotient of a vector and a scalar
+    template<typename Operand, typename Scalar> requires VectorOperand<Operand> && std::is_arithmetic_v<Scalar>
+    constexpr auto operator/(Operand&& operand, Scalar const scalar) {
+        using T = typename std::remove_cvref_t<Operand>::ValueType;
+        return VectorScalarExpression<StoredVectorOperand<Operand>, std::divides<>>
+            {std::forward<Operand>(operand), static_cast<T>(scalar)};
+    }
+
+    // Compute cross product of two vectors and return the mutually orthonormal vector
+    // Cross product is not an element-wise operation, so it is evaluated right away
+    template<typename LHS, typename RHS> requires CompatibleVectorOperands<LHS, RHS>
+    constexpr auto operator*(LHS const& lhs, RHS const& rhs) {
+        using T = typename LHS::ValueType;
+        static_assert(LHS::dimension == 3, "Cross product can only be computed for 3D vectors");
+        Vector<T, 3> v1 {lhs};
+        Vector<T, 3> v2 {rhs};
+        // Elements are read through the array rather than the named members, which are not usable in constant
+        // expressions
+        T const* a = v1.getData();
+        T const* b = v2.getData();
+        Vector<T, 3> result;
+        T* c = result.getData();
+        c[0] = a[1]*b[2] - a[2]*b[1];
+        c[1] = b[0]*a[2] - a[0]*b[2];
+        c[2] = a[0]*b[1] - a[1]*b[0];
+        return result;
+    }
+
+    template<typename Derived, typename T, unsigned Size>
+    std::ostream& operator << (std::ostream& os, VectorExpression<Derived, T, Size> const& expression) {
+        return os << expression.eval();
     }
 
     template<typename T>
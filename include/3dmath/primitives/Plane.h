@@ -2,6 +2,7 @@
 
 #include "ConvexPrimitive.h"
 #include "Ray.h"
+#include "RayPacket.h"
 #include <iostream>
 
 namespace math3d {
@@ -106,6 +107,32 @@ namespace math3d {
             return result;
         }
 
+        // Intersect a packet of rays with the plane. As with intersectWithRay, rays are treated as lines: rays that
+        // point away from the plane hit it at negative distances, and rays that start on the plane hit it at their
+        // origin
+        template<unsigned N>
+        [[nodiscard]] PacketIntersectionResult<N> intersectWithRays(RayPacket<N> const& rays) const {
+            using Register = batch::PacketRegister<N>;
+            batch::PacketRays<N> const packet(rays);
+            Vector3<float> const planeOrigin = origin;
+            Vector3<float> const planeNormal = normal;
+
+            // Distance of the plane from the ray origins along the plane normal, and the rate at which the rays
+            // cover that distance
+            auto const distanceFromOrigin = Register::subtract(Register::broadcast(planeOrigin.dot(planeNormal)),
+                                                               batch::PacketRays<N>::dot(packet.originX, packet.originY,
+                                                                                         packet.originZ, planeNormal));
+            auto const rate = packet.dotDirection(planeNormal);
+
+            auto const tolerance = Register::broadcast(static_cast<float>(constants::tolerance));
+            auto const startsOnPlane = Register::lessThan(Register::abs(distanceFromOrigin), tolerance);
+            auto const isParallel = Register::lessThan(Register::abs(rate), tolerance);
+            auto const distance = Register::select(startsOnPlane, Register::broadcast(0.f),
+                                                   Register::divide(distanceFromOrigin, rate));
+            auto const hits = Register::logicalOr(startsOnPlane, Register::logicalNot(isParallel));
+            return batch::makePacketIntersectionResult(packet, Register::bits(hits) & rays.getActiveMask(), distance);
+        }
+
     private:
         types::Vector3D normal;
         float const geometrySize;
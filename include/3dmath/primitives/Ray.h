@@ -1,8 +1,8 @@
 #pragma once
 
 #include <array>
-#include <fstream>
 #include "Primitive.h"
+#include "../OBJWriter.h"
 #include "../SupportingTypes.h"
 #include "../Utilities.h"
 
@@ -96,15 +96,11 @@ namespace math3d {
                 if (vertices.empty()) {
                     generateGeometry();
                 }
-                std::ofstream ofs(outputFile.string());
-                for (auto& vertex : vertices) {
-                    ofs << "v " << vertex.x << ' ' << vertex.y << ' ' << vertex.z << std::endl;
-                }
-                ofs << "f 1 2" << std::endl;
-                ofs << "f 2 3" << std::endl;
-                ofs << "f 2 4" << std::endl;
-
-                ofs.close();
+                // Line segments of the shaft and the two legs of the arrowhead
+                std::array<std::array<unsigned, 2>, 3> const segments {{{0, 1}, {1, 2}, {1, 3}}};
+                OBJWriter writer(outputFile);
+                writer.write<std::array<unsigned, 2>>(vertices, segments);
+                writer.close();
             } else {
                 throw std::runtime_error("Only OBJ output is supported for rays");
             }
@@ -0,0 +1,192 @@
+#pragma once
+
+#include "Ray.h"
+#include "../PacketRegister.h"
+#include "../SupportingTypes.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
+
+// Packets of rays that are intersected with a primitive together
+//
+// Coherent rays, such as the camera rays of neighboring pixels, tend to hit the same primitives. Intersecting N of them
+// at once with SIMD amortizes the cost of loading the primitive and computes N intersections for the price of about
+// one. Packets store rays in single precision as separate arrays of origin and direction coordinates (SoA), so that
+// each coordinate of all N rays is a single vector register.
+//
+// Packets of four and eight rays are intersected with SSE or AVX as described in PacketRegister.h. Portable code is used
+// for every other width.
+
+namespace math3d {
+
+    // Up to N rays. Lanes that haven't been assigned a ray are inactive and never report a hit
+    template<unsigned N>
+    class RayPacket {
+    public:
+        static_assert(N > 0 && N <= 32, "Hit masks have a bit per ray, so packets can have at most 32 rays");
+        static constexpr unsigned size = N;
+
+        RayPacket() = default;
+
+        explicit RayPacket(std::span<Ray const> rays) {
+            if (rays.size() > N) {
+                throw std::invalid_argument("A packet holds at most " + std::to_string(N) + " rays. " +
+                                            std::to_string(rays.size()) + " rays were given");
+            }
+            for (unsigned lane = 0; lane < rays.size(); ++lane) {
+                setRay(lane, rays[lane]);
+            }
+        }
+
+        // The direction is used as is, so distances to hits are in units of its length
+        void setRay(unsigned const lane, Vector3<float> const& origin, Vector3<float> const& direction) {
+            validateLane(lane);
+            originX[lane] = origin.x;
+            originY[lane] = origin.y;
+            originZ[lane] = origin.z;
+            directionX[lane] = direction.x;
+            directionY[lane] = direction.y;
+            directionZ[lane] = direction.z;
+            activeMask |= 1u << lane;
+        }
+
+        void setRay(unsigned const lane, Ray const& ray) {
+            setRay(lane, Utilities::asFloat(ray.getOrigin()), Utilities::asFloat(ray.getDirection()));
+        }
+
+        [[nodiscard]]
+        Vector3<float> getOrigin(unsigned const lane) const {
+            validateLane(lane);
+            return {originX[lane], originY[lane], originZ[lane]};
+        }
+
+        [[nodiscard]]
+        Vector3<float> getDirection(unsigned const lane) const {
+            validateLane(lane);
+            return {directionX[lane], directionY[lane], directionZ[lane]};
+        }
+
+        // Bit i is set if lane i holds a ray
+        [[nodiscard]]
+        unsigned getActiveMask() const {
+            return activeMask;
+        }
+
+        std::array<float, N> originX{};
+        std::array<float, N> originY{};
+        std::array<float, N> originZ{};
+        std::array<float, N> directionX{};
+        std::array<float, N> directionY{};
+        std::array<float, N> directionZ{};
+
+    private:
+        static void validateLane(unsigned const lane) {
+            if (lane >= N) {
+                throw std::invalid_argument("Lane " + std::to_string(lane) + " is out of bounds for a packet of " +
+                                            std::to_string(N) + " rays");
+            }
+        }
+
+        unsigned activeMask = 0;
+    };
+
+    // Result of intersecting a packet of rays with a primitive. Distances and intersection points are only
+    // meaningful in lanes whose bit is set in hitMask
+    template<unsigned N>
+    struct PacketIntersectionResult {
+        unsigned hitMask = 0;
+        std::array<float, N> distance{};
+        std::array<float, N> intersectionPointX{};
+        std::array<float, N> intersectionPointY{};
+        std::array<float, N> intersectionPointZ{};
+
+        [[nodiscard]]
+        bool intersects(unsigned const lane) const {
+            return lane < N && (hitMask & (1u << lane));
+        }
+
+        [[nodiscard]]
+        Vector3<float> getIntersectionPoint(unsigned const lane) const {
+            return {intersectionPointX[lane], intersectionPointY[lane], intersectionPointZ[lane]};
+        }
+    };
+
+    namespace batch {
+
+        // Packet coordinates loaded into registers
+        template<unsigned N>
+        struct PacketRays {
+            using Register = PacketRegister<N>;
+            typename Register::Type originX, originY, originZ;
+            typename Register::Type directionX, directionY, directionZ;
+
+            explicit PacketRays(RayPacket<N> const& rays)
+            : originX(Register::load(rays.originX.data()))
+            , originY(Register::load(rays.originY.data()))
+            , originZ(Register::load(rays.originZ.data()))
+            , directionX(Register::load(rays.directionX.data()))
+            , directionY(Register::load(rays.directionY.data()))
+            , directionZ(Register::load(rays.directionZ.data())) {
+            }
+
+            // Dot products of the directions with a vector
+            typename Register::Type dotDirection(Vector3<float> const& vector) const {
+                return dot(directionX, directionY, directionZ, vector);
+            }
+
+            static typename Register::Type dot(typename Register::Type const& x, typename Register::Type const& y,
+                                               typename Register::Type const& z, Vector3<float> const& vector) {
+                return Register::add(Register::add(Register::multiply(x, Register::broadcast(vector.x)),
+                                                   Register::multiply(y, Register::broadcast(vector.y))),
+                                     Register::multiply(z, Register::broadcast(vector.z)));
+            }
+        };
+
+        // Store the distances and the points at those distances of the lanes in hitMask
+        template<unsigned N>
+        PacketIntersectionResult<N> makePacketIntersectionResult(PacketRays<N> const& rays, unsigned const hitMask,
+                                                                 typename PacketRegister<N>::Type const& distance) {
+            using Register = PacketRegister<N>;
+            PacketIntersectionResult<N> result;
+            result.hitMask = hitMask;
+            Register::store(result.distance.data(), distance);
+            Register::store(result.intersectionPointX.data(),
+                            Register::add(rays.originX, Register::multiply(distance, rays.directionX)));
+            Register::store(result.intersectionPointY.data(),
+                            Register::add(rays.originY, Register::multiply(distance, rays.directionY)));
+            Register::store(result.intersectionPointZ.data(),
+                            Register::add(rays.originZ, Register::multiply(distance, rays.directionZ)));
+            return result;
+        }
+    }
+
+    // Slab test of every ray against the box. Rays that start inside the box hit it at distance zero
+    template<typename T>
+    template<unsigned N>
+    PacketIntersectionResult<N> Bounds3D<T>::intersectWithRays(RayPacket<N> const& rays) const {
+        using Register = batch::PacketRegister<N>;
+        batch::PacketRays<N> const packet(rays);
+        auto nearest = Register::broadcast(0.f);
+        auto farthest = Register::broadcast(std::numeric_limits<float>::infinity());
+        auto const clip = [&nearest, &farthest](Extent<T> const& extent, typename Register::Type const& origin,
+                                                typename Register::Type const& direction) {
+            auto const inverseDirection = Register::divide(Register::broadcast(1.f), direction);
+            auto const t0 = Register::multiply(
+                Register::subtract(Register::broadcast(static_cast<float>(extent.min)), origin), inverseDirection);
+            auto const t1 = Register::multiply(
+                Register::subtract(Register::broadcast(static_cast<float>(extent.max)), origin), inverseDirection);
+            nearest = Register::max(nearest, Register::min(t0, t1));
+            farthest = Register::min(farthest, Register::max(t0, t1));
+        };
+        clip(x, packet.originX, packet.directionX);
+        clip(y, packet.originY, packet.directionY);
+        clip(z, packet.originZ, packet.directionZ);
+        auto const hitMask = Register::bits(Register::lessThanOrEqual(nearest, farthest)) & rays.getActiveMask();
+        return batch::makePacketIntersectionResult(packet, hitMask, nearest);
+    }
+}
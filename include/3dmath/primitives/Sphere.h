@@ -1,14 +1,62 @@
 #pragma once
 
 #include "ConvexPrimitive.h"
-#include "../PolarCoordinates.h"
+#include "../Constants.h"
+#include "../Utilities.h"
 #include "Ray.h"
+#include "RayPacket.h"
 #include "../TypeAliases.h"
-#include <tuple>
+#include <cmath>
+#include <memory>
+#include <mutex>
 #include <numbers>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
 
 namespace math3d {
 
+    namespace batch {
+
+        // Lanes of ray-sphere intersection kernels
+        template<unsigned N>
+        struct RaySphereIntersection {
+            typename PacketRegister<N>::Type distance;
+            typename PacketRegister<N>::Mask hits;
+        };
+
+        // Intersect rays with spheres lane by lane, given the vectors from the ray origins to the sphere centers, the
+        // ray directions and the squared radii. The same math serves a packet of rays against one sphere and one ray
+        // against a group of spheres. A ray hits a sphere at the smallest non-negative root of
+        // |origin + t * direction - center|^2 = radius^2, i.e. (projection -/+ sqrt(discriminant)) / |direction|^2,
+        // so rays from inside a sphere hit it where they exit
+        template<unsigned N>
+        RaySphereIntersection<N> intersectRaysWithSpheres(
+                std::array<typename PacketRegister<N>::Type, 3> const& toCenter,
+                std::array<typename PacketRegister<N>::Type, 3> const& direction,
+                typename PacketRegister<N>::Type const& radiusSquared) {
+            using Register = PacketRegister<N>;
+            auto const dot = [](auto const& a, auto const& b) {
+                return Register::add(Register::add(Register::multiply(a[0], b[0]), Register::multiply(a[1], b[1])),
+                                     Register::multiply(a[2], b[2]));
+            };
+            auto const projection = dot(toCenter, direction);
+            auto const directionLengthSquared = dot(direction, direction);
+            auto const discriminant = Register::subtract(
+                Register::multiply(projection, projection),
+                Register::multiply(directionLengthSquared,
+                                   Register::subtract(dot(toCenter, toCenter), radiusSquared)));
+
+            auto const zero = Register::broadcast(0.f);
+            auto const root = Register::sqrt(Register::max(discriminant, zero));
+            auto const nearRoot = Register::divide(Register::subtract(projection, root), directionLengthSquared);
+            auto const farRoot = Register::divide(Register::add(projection, root), directionLengthSquared);
+            auto const distance = Register::select(Register::lessThanOrEqual(zero, nearRoot), nearRoot, farRoot);
+            return {distance, Register::logicalAnd(Register::lessThanOrEqual(zero, discriminant),
+                                                   Register::lessThanOrEqual(zero, distance))};
+        }
+    }
+
     class Sphere : public ConvexPrimitive {
 
     public:
@@ -34,112 +82,21 @@ namespace math3d {
             return resolution;
         }
 
-        // Refer to https://github.com/mdh81/3dmath/blob/master/derivations/Spherical_to_Cartesian.jpg
+        // The vertices are those of a unit sphere with the same resolution, scaled by the radius and offset by the
+        // center. Unit spheres and their triangles only depend on the resolution, so they are generated once per
+        // resolution and shared by all spheres
         void generateGeometry() override {
             if (!vertices.empty()) {
                 std::cerr << "Warning: Skipping geometry generation. Geometry was already generated" << std::endl;
+                return;
             }
 
-            unsigned numCircles = resolution - 1;
-            unsigned numCircleVertices = resolution;
-
-            vertices.reserve((numCircleVertices * numCircles) + 2); // +2 for poles
-
-            // Every pair of circles in the sphere will have resolution number of
-            // quads in them. The two circles that join the poles will have resolution
-            // number of triangles in them. Since we split quads into triangles we count
-            // two faces for each quad
-            unsigned numberOfQuads = resolution * numCircles - 1;
-            unsigned numberOfTris = resolution * 2;
-            tris.reserve((numberOfQuads * 2) + numberOfTris);
-
-            // Generate vertices
-            // We generate resolution number of circles in theta and phi directions. The first and last circles in the phi
-            // direction are poles where the radius is zero. Phi will go from zero to 180 degrees, and theta will be a full
-            // circle
-
-            // Pole 1: At distance of radius from the center along +z
-            vertices.emplace_back(Utilities::asFloat(origin +
-                                  SphericalCoordinates{radius, 0., 0.}.getCartesianCoordinates()));
-
-            // Circles between the two poles
-            // In spherical coordinate system, phi = zero is a singularity, where theta has no influence on
-            // the resulting coordinate. To prevent this, we start with phi at a sensible value given our resolution
-            // constraint.
-            float phiIncrement = constants::oneEightyDegreesInRadians / static_cast<float>(resolution);
-            float thetaIncrement = constants::threeSixtyDegreesInRadians / static_cast<float>(resolution);
-            float phi = phiIncrement, theta = 0.f;
-
-            // Rotation by theta in spherical by convention rotates about the +z-axis. When theta is zero, the projection
-            // of the spherical coordinate on the xy plane is on the +x-axis.
-            // This coordinate (r, 0, phi) is our starting point for each circle. Each value of phi provides a new circle
-            // and as theta varies from 0 to 360 we have new points on the chosen circle. All our circles are parallel
-            // to the xy plane
-            for (unsigned yzCircle = 1; yzCircle <= numCircles; ++yzCircle) {
-                for (unsigned xyCircle = 1; xyCircle <= numCircleVertices; ++xyCircle) {
-                    vertices.emplace_back(Utilities::asFloat(origin +
-                                          SphericalCoordinates{radius, theta, phi}.getCartesianCoordinates()));
-                    theta += thetaIncrement;
-                }
-                theta = 0.f;
-                phi += phiIncrement;
-            }
-
-            // Pole 2: At distance of radius from the center along -z
-            vertices.emplace_back(Utilities::asFloat(origin +
-                                  SphericalCoordinates{radius, 0.f, constants::oneEightyDegreesInRadians}.getCartesianCoordinates()));
-
-            // Generate faces
-            // NOTE: In the two lambdas below, indices are vertex indices
-            // quadNumber is [1, resolution] and it identifies the quadrilateral formed between corresponding segments of
-            // two circles
-            // circle1Index is the vertex index of the vertex on circle 1. circleIndex and circleIndex+1 define a segment on circle 1
-            // circle2Index is the same as circle1Index but for circle 2
-            auto createSplitQuad = [this](unsigned quadNumber, unsigned circle1Index, unsigned circle2Index) {
-                // The quad is created between the pairs (circle1Index, circle1Index+1) and (circle2Index, circle2Index+1)
-                // with consideration for the last segment in the circle, in which case, the second index in these two pairs
-                // is subtracted from resolution to loop back to the first vertex in their respective circles
-                bool isLastSegment = quadNumber == resolution;
-                unsigned a = circle1Index;
-                unsigned b = isLastSegment ? a + 1 - resolution : a + 1;
-                unsigned c = circle2Index;
-                unsigned d = isLastSegment ? c + 1 - resolution : c + 1;
-                this->tris.emplace_back(orientTriangleNormalOutside({a, b, c}));
-                this->tris.emplace_back(orientTriangleNormalOutside({b, c, d}));
-            };
-
-            // triangleNumber is [1...resolution], and it identifies the triangle that's constructed
-            // poleIndex is the vertex index of the vertex at the poles, and it is either 0 or Number of Vertices-1
-            // circleIndex is the vertex index of the vertex on the circle that is being joined with the pole
-            auto createTri = [this](unsigned triangleNumber, unsigned poleIndex, unsigned circleIndex) {
-                bool isLastSegment = triangleNumber == resolution;
-                unsigned a = poleIndex;
-                unsigned b = circleIndex;
-                unsigned c = isLastSegment ? b + 1 - resolution : b + 1;
-                this->tris.emplace_back(orientTriangleNormalOutside({a, b, c}));
-            };
-
-            // Faces between the first pole and circle
-            unsigned nextIndex = 1;
-            for (unsigned triangleNumber = 1; triangleNumber <= resolution; ++triangleNumber, ++nextIndex) {
-                createTri(triangleNumber, 0, nextIndex);
-            }
-
-            // Faces between circles
-            unsigned circle1VertexIndex = 1;
-            unsigned circle2VertexIndex = circle1VertexIndex + resolution;
-            for (unsigned circleNumber = 1; circleNumber < resolution - 1; ++circleNumber) {
-                // Join corresponding edges to form a quad and then split that quad into two triangles
-                for (unsigned quadNumber = 1; quadNumber <= resolution; ++quadNumber, ++circle1VertexIndex, ++circle2VertexIndex) {
-                    createSplitQuad(quadNumber, circle1VertexIndex, circle2VertexIndex);
-                }
-            }
-
-            // Faces between the second pole and final circle
-            nextIndex = static_cast<unsigned>(vertices.size() - 1 - resolution);
-            for (unsigned triangleNumber = 1; triangleNumber <= resolution; ++triangleNumber, ++nextIndex) {
-                createTri(triangleNumber, vertices.size() - 1, nextIndex);
+            auto const& unitSphere = getUnitSphere(resolution);
+            vertices.reserve(unitSphere.points.size());
+            for (auto const& point : unitSphere.points) {
+                vertices.emplace_back(Utilities::asFloat(origin + radius * point));
             }
+            tris = unitSphere.tris;
         }
 
         // Refer to
@@ -202,10 +159,123 @@ namespace math3d {
             return result;
         }
 
+        // Intersect a packet of rays with the sphere. As with intersectWithRay, a ray hits the sphere where it first
+        // crosses it, so rays from inside the sphere hit it where they exit
+        template<unsigned N>
+        [[nodiscard]] PacketIntersectionResult<N> intersectWithRays(RayPacket<N> const& rays) const {
+            using Register = batch::PacketRegister<N>;
+            batch::PacketRays<N> const packet(rays);
+            Vector3<float> const center = getCenter();
+            auto const intersection = batch::intersectRaysWithSpheres<N>(
+                {Register::subtract(Register::broadcast(center.x), packet.originX),
+                 Register::subtract(Register::broadcast(center.y), packet.originY),
+                 Register::subtract(Register::broadcast(center.z), packet.originZ)},
+                {packet.directionX, packet.directionY, packet.directionZ},
+                Register::broadcast(static_cast<float>(radius * radius)));
+            return batch::makePacketIntersectionResult(
+                packet, Register::bits(intersection.hits) & rays.getActiveMask(), intersection.distance);
+        }
+
     protected:
         double const radius;
         unsigned const resolution;
 
+    private:
+        struct UnitSphere {
+            std::vector<types::Point3D> points;
+            types::Tris tris;
+        };
+
+        // Refer to https://github.com/mdh81/3dmath/blob/master/derivations/Spherical_to_Cartesian.jpg
+        static UnitSphere generateUnitSphere(unsigned const resolution) {
+            // We generate resolution number of circles in theta and phi directions. The first and last circles in the
+            // phi direction are poles where the radius is zero. Phi goes from zero to 180 degrees, and theta is a full
+            // circle. In spherical coordinate system, phi = zero is a singularity, where theta has no influence on the
+            // resulting coordinate. To prevent this, the first circle is at phi = 180 / resolution degrees
+            // Angles are stepped in single precision and their sin and cos computed in double precision, which keeps
+            // vertices identical to those of earlier versions of this method
+            unsigned const numCircles = resolution - 1;
+            float const phiIncrement = constants::oneEightyDegreesInRadians / static_cast<float>(resolution);
+            float const thetaIncrement = constants::threeSixtyDegreesInRadians / static_cast<float>(resolution);
+
+            // Every circle has the same theta values, so their sin and cos are computed once
+            std::vector<double> cosTheta(resolution), sinTheta(resolution);
+            float theta = 0.f;
+            for (unsigned i = 0; i < resolution; ++i, theta += thetaIncrement) {
+                cosTheta[i] = std::cos(static_cast<double>(theta));
+                sinTheta[i] = std::sin(static_cast<double>(theta));
+            }
+
+            UnitSphere unitSphere;
+            auto& points = unitSphere.points;
+            points.reserve(resolution * numCircles + 2);
+            // Pole 1 is on the +z-axis
+            points.push_back({0, 0, 1});
+            // Rotation by theta in spherical by convention rotates about the +z-axis. When theta is zero, the
+            // projection of the spherical coordinate on the xy plane is on the +x-axis. All circles are parallel to
+            // the xy plane
+            float phi = phiIncrement;
+            for (unsigned circle = 0; circle < numCircles; ++circle, phi += phiIncrement) {
+                auto const sinPhi = std::sin(static_cast<double>(phi));
+                auto const cosPhi = std::cos(static_cast<double>(phi));
+                for (unsigned i = 0; i < resolution; ++i) {
+                    points.push_back({sinPhi * cosTheta[i], sinPhi * sinTheta[i], cosPhi});
+                }
+            }
+            // Pole 2 is on the -z-axis
+            points.push_back({0, 0, -1});
+
+            // Triangles are wound so that their normals point out of the sphere. Theta increases counterclockwise
+            // about the +z-axis, and phi increases from pole 1 to pole 2, so a triangle whose vertices are in the
+            // order (phi, theta), (phi + increment, theta), (phi, theta + increment) faces outwards. next(i) is the
+            // index of the vertex that follows vertex i on its circle
+            auto& tris = unitSphere.tris;
+            tris.reserve(2 * resolution * numCircles);
+            unsigned const pole1 = 0;
+            auto const pole2 = static_cast<unsigned>(points.size() - 1);
+            auto const next = [resolution](unsigned const circleStart, unsigned const i) {
+                return circleStart + (i + 1) % resolution;
+            };
+
+            // Faces between the first pole and circle
+            for (unsigned i = 0; i < resolution; ++i) {
+                tris.emplace_back(pole1, 1 + i, next(1, i));
+            }
+
+            // Faces between circles. Corresponding segments of two circles form a quad that is split into two
+            // triangles
+            for (unsigned circle = 0; circle + 1 < numCircles; ++circle) {
+                unsigned const circle1Start = 1 + circle * resolution;
+                unsigned const circle2Start = circle1Start + resolution;
+                for (unsigned i = 0; i < resolution; ++i) {
+                    unsigned const a = circle1Start + i;
+                    unsigned const b = next(circle1Start, i);
+                    unsigned const c = circle2Start + i;
+                    unsigned const d = next(circle2Start, i);
+                    tris.emplace_back(a, c, b);
+                    tris.emplace_back(b, c, d);
+                }
+            }
+
+            // Faces between the second pole and final circle
+            unsigned const lastCircleStart = pole2 - resolution;
+            for (unsigned i = 0; i < resolution; ++i) {
+                tris.emplace_back(pole2, next(lastCircleStart, i), lastCircleStart + i);
+            }
+            return unitSphere;
+        }
+
+        static UnitSphere const& getUnitSphere(unsigned const resolution) {
+            static std::mutex cacheMutex;
+            static std::unordered_map<unsigned, std::unique_ptr<UnitSphere const>> cache;
+            std::scoped_lock lock(cacheMutex);
+            auto& unitSphere = cache[resolution];
+            if (!unitSphere) {
+                unitSphere = std::make_unique<UnitSphere const>(generateUnitSphere(resolution));
+            }
+            return *unitSphere;
+        }
+
     friend std::ostream& operator<<(std::ostream& os, Sphere const&);
     };
 
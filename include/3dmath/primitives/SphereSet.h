@@ -0,0 +1,231 @@
+#pragma once
+
+#include "Sphere.h"
+#include "RayPacket.h"
+#include "../Batch.h"
+#include "../SupportingTypes.h"
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// A set of spheres stored as separate arrays of center coordinates and radii (SoA)
+//
+// Sphere is a polymorphic primitive with its own geometry, which is too heavy for the hundreds of thousands of
+// spheres of particle systems or collision proxies. A sphere set stores just the centers and radii in single
+// precision and answers queries against all of its spheres at once, a group of spheres per vector register. Queries
+// use the same math as Sphere, so their results agree with those of the individual spheres.
+
+namespace math3d {
+
+    class SphereSet {
+    public:
+        // Spheres are processed in groups of this many, one per register lane
+        static constexpr unsigned groupSize = 8;
+
+        // Closest sphere hit by a ray
+        struct RayHit {
+            size_t sphere;
+            // Distance from the ray origin in units of the ray direction's length
+            float distance;
+        };
+
+        SphereSet() = default;
+
+        explicit SphereSet(std::span<Sphere const> spheres) {
+            reserve(spheres.size());
+            for (auto const& sphere : spheres) {
+                add(sphere);
+            }
+        }
+
+        // Returns the index of the new sphere
+        size_t add(Vector3<float> const& center, float const radius) {
+            if (numberOfSpheres % groupSize == 0) {
+                // Start a new group. Lanes past the last sphere have NaN coordinates, so every comparison involving
+                // them is false and they never hit, contain or overlap anything
+                for (auto* array : {&centerX, &centerY, &centerZ, &radii}) {
+                    array->resize(array->size() + groupSize, std::numeric_limits<float>::quiet_NaN());
+                }
+            }
+            centerX[numberOfSpheres] = center.x;
+            centerY[numberOfSpheres] = center.y;
+            centerZ[numberOfSpheres] = center.z;
+            radii[numberOfSpheres] = validateRadius(radius);
+            return numberOfSpheres++;
+        }
+
+        size_t add(Sphere const& sphere) {
+            return add(sphere.getCenter(), static_cast<float>(sphere.getRadius()));
+        }
+
+        void reserve(size_t const capacity) {
+            auto const paddedCapacity = getPaddedSize(capacity);
+            for (auto* array : {&centerX, &centerY, &centerZ, &radii}) {
+                array->reserve(paddedCapacity);
+            }
+        }
+
+        [[nodiscard]]
+        size_t size() const {
+            return numberOfSpheres;
+        }
+
+        [[nodiscard]]
+        Vector3<float> getCenter(size_t const sphere) const {
+            validateIndex(sphere);
+            return {centerX[sphere], centerY[sphere], centerZ[sphere]};
+        }
+
+        [[nodiscard]]
+        float getRadius(size_t const sphere) const {
+            validateIndex(sphere);
+            return radii[sphere];
+        }
+
+        // Closest sphere hit by the ray. As with Sphere::intersectWithRay, a ray hits a sphere where it first
+        // crosses it, so rays from inside a sphere hit it where they exit
+        [[nodiscard]]
+        std::optional<RayHit> getClosestHit(Vector3<float> const& origin, Vector3<float> const& direction) const {
+            std::array<Register::Type, 3> const rayOrigin {
+                Register::broadcast(origin.x), Register::broadcast(origin.y), Register::broadcast(origin.z)};
+            std::array<Register::Type, 3> const rayDirection {
+                Register::broadcast(direction.x), Register::broadcast(direction.y), Register::broadcast(direction.z)};
+
+            std::optional<RayHit> closestHit;
+            auto closestDistance = Register::broadcast(std::numeric_limits<float>::infinity());
+            for (size_t first = 0; first < numberOfSpheres; first += groupSize) {
+                auto const intersection = batch::intersectRaysWithSpheres<groupSize>(
+                    {Register::subtract(Register::load(&centerX[first]), rayOrigin[0]),
+                     Register::subtract(Register::load(&centerY[first]), rayOrigin[1]),
+                     Register::subtract(Register::load(&centerZ[first]), rayOrigin[2])},
+                    rayDirection, getRadiusSquared(first));
+                auto hits = Register::bits(Register::logicalAnd(
+                    intersection.hits, Register::lessThan(intersection.distance, closestDistance)));
+                if (!hits) continue;
+
+                // Most groups have no closer hit, so finding the closest lane of those that do needn't be vectorized
+                std::array<float, groupSize> distances;
+                Register::store(distances.data(), intersection.distance);
+                for (unsigned lane = 0; hits; ++lane, hits >>= 1) {
+                    if ((hits & 1) && (!closestHit || distances[lane] < closestHit->distance)) {
+                        closestHit = RayHit{first + lane, distances[lane]};
+                    }
+                }
+                closestDistance = Register::broadcast(closestHit->distance);
+            }
+            return closestHit;
+        }
+
+        [[nodiscard]]
+        std::optional<RayHit> getClosestHit(Ray const& ray) const {
+            return getClosestHit(ray.getOrigin(), ray.getDirection());
+        }
+
+        // Closest hits of many rays. hits[i] is the closest hit of rays[i]
+        void getClosestHits(std::span<Ray const> rays, std::span<std::optional<RayHit>> hits,
+                            Execution const execution = Execution::Sequential) const {
+            if (rays.size() != hits.size()) {
+                throw std::invalid_argument("Number of rays and hits are different. There are " +
+                                            std::to_string(rays.size()) + " rays and " +
+                                            std::to_string(hits.size()) + " hits");
+            }
+            // Work is counted in sphere groups rather than rays, since each ray is tested against every group. Ray i
+            // goes to the range that contains its first group, i * groupsPerRay
+            auto const groupsPerRay = std::max<size_t>(1, numberOfSpheres / groupSize);
+            batch::forEachRange(rays.size() * groupsPerRay, execution, [&](size_t const begin, size_t const end) {
+                auto const lastRay = std::min(rays.size(), (end + groupsPerRay - 1) / groupsPerRay);
+                for (auto ray = (begin + groupsPerRay - 1) / groupsPerRay; ray < lastRay; ++ray) {
+                    hits[ray] = getClosestHit(rays[ray]);
+                }
+            });
+        }
+
+        // Indices of the spheres that contain the point, including those that have it on their surface
+        [[nodiscard]]
+        std::vector<size_t> getSpheresContainingPoint(Vector3<float> const& point) const {
+            auto const x = Register::broadcast(point.x);
+            auto const y = Register::broadcast(point.y);
+            auto const z = Register::broadcast(point.z);
+            return select([&](size_t const first) {
+                auto const dx = Register::subtract(Register::load(&centerX[first]), x);
+                auto const dy = Register::subtract(Register::load(&centerY[first]), y);
+                auto const dz = Register::subtract(Register::load(&centerZ[first]), z);
+                auto const distanceSquared = Register::add(
+                    Register::add(Register::multiply(dx, dx), Register::multiply(dy, dy)), Register::multiply(dz, dz));
+                return Register::lessThanOrEqual(distanceSquared, getRadiusSquared(first));
+            });
+        }
+
+        // Indices of the spheres that overlap the box, i.e. whose center is at most a radius away from the closest
+        // point of the box. Spheres that touch the box or contain it overlap it
+        [[nodiscard]]
+        std::vector<size_t> getSpheresOverlappingBounds(Bounds3D<float> const& bounds) const {
+            auto const zero = Register::broadcast(0.f);
+            // Distance from a center coordinate to the box's extent on that axis, which is zero inside the extent
+            auto const distanceToExtent = [&zero](Register::Type const& center, Extent<float> const& extent) {
+                return Register::max(Register::max(Register::subtract(Register::broadcast(extent.min), center),
+                                                   Register::subtract(center, Register::broadcast(extent.max))),
+                                     zero);
+            };
+            return select([&](size_t const first) {
+                auto const dx = distanceToExtent(Register::load(&centerX[first]), bounds.x);
+                auto const dy = distanceToExtent(Register::load(&centerY[first]), bounds.y);
+                auto const dz = distanceToExtent(Register::load(&centerZ[first]), bounds.z);
+                auto const distanceSquared = Register::add(
+                    Register::add(Register::multiply(dx, dx), Register::multiply(dy, dy)), Register::multiply(dz, dz));
+                return Register::lessThanOrEqual(distanceSquared, getRadiusSquared(first));
+            });
+        }
+
+    private:
+        using Register = batch::PacketRegister<groupSize>;
+
+        static size_t getPaddedSize(size_t const size) {
+            return (size + groupSize - 1) / groupSize * groupSize;
+        }
+
+        static float validateRadius(float const radius) {
+            if (radius < 0.f) {
+                throw std::invalid_argument("Sphere radius cannot be negative. Radius is " + std::to_string(radius));
+            }
+            return radius;
+        }
+
+        void validateIndex(size_t const sphere) const {
+            if (sphere >= numberOfSpheres) {
+                throw std::out_of_range("Sphere " + std::to_string(sphere) + " is out of bounds for a set of " +
+                                        std::to_string(numberOfSpheres) + " spheres");
+            }
+        }
+
+        [[nodiscard]]
+        Register::Type getRadiusSquared(size_t const first) const {
+            auto const groupRadius = Register::load(&radii[first]);
+            return Register::multiply(groupRadius, groupRadius);
+        }
+
+        // Indices of the spheres for which test(first) sets the lane in the mask of the group that starts at first
+        template<typename Test>
+        std::vector<size_t> select(Test&& test) const {
+            std::vector<size_t> result;
+            for (size_t first = 0; first < numberOfSpheres; first += groupSize) {
+                for (auto lanes = Register::bits(test(first)); lanes; lanes &= lanes - 1) {
+                    result.push_back(first + static_cast<size_t>(std::countr_zero(lanes)));
+                }
+            }
+            return result;
+        }
+
+        std::vector<float> centerX;
+        std::vector<float> centerY;
+        std::vector<float> centerZ;
+        std::vector<float> radii;
+        size_t numberOfSpheres = 0;
+    };
+}
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "Plane.h"
+#include "../TriangleKernels.h"
+#include <limits>
+#include <optional>
 
 namespace math3d {
 
@@ -17,9 +20,18 @@ namespace math3d {
             : Plane(
                 vertices[0],
                 (vertices[1] - vertices[0]) * (vertices[2] - vertices[1]))
-            , vertices(vertices) {
+            , vertices(vertices)
+            , edge1(vertices[1] - vertices[0])
+            , edge2(vertices[2] - vertices[0])
+            , edgeProducts(edge1, edge2) {
         }
 
+        // Distance along a ray to the point where it hits the triangle, and the barycentric coordinates of that point
+        struct RayHit {
+            double distance;
+            Point3D barycentricCoordinates;
+        };
+
         Points const& getPoints() const {
             return vertices;
         }
@@ -31,24 +43,116 @@ namespace math3d {
             return 0.5 * (ab * ac).length();
         }
 
+        // Weights of the three vertices, in order, at the projection of the point onto the plane of the triangle.
+        // Weights sum to one and are negative for points outside the triangle
         [[nodiscard]]
         Point3D getBarycentricCoordinates(Point3D const& pointInSpace) const {
-            auto area = getArea();
-            Triangle a {vertices[0], pointInSpace, vertices[1] };
-            Triangle b {vertices[1], pointInSpace, vertices[2] };
-            Triangle c {vertices[2], pointInSpace, vertices[0] };
-            return { a.getArea() / area, b.getArea() / area, c.getArea() / area };
+            return kernels::barycentricCoordinates(pointInSpace, vertices[0], edge1, edge2, edgeProducts);
+        }
+
+        // Nearest hit of a ray within maxDistance, found with the Möller–Trumbore algorithm. Hits behind the ray
+        // origin don't count, and rays parallel to the triangle miss it. The distance is in units of the length of
+        // the direction
+        [[nodiscard]]
+        std::optional<RayHit> getRayHit(Point3D const& origin, types::Vector3D const& direction,
+                                        double const maxDistance = std::numeric_limits<double>::infinity()) const {
+            kernels::RayTriangleHit<double> hit{maxDistance, 0, 0};
+            if (!kernels::intersectRayTriangle(origin, direction, vertices[0], edge1, edge2, hit)) {
+                return std::nullopt;
+            }
+            return RayHit{hit.distance, hit.getBarycentricCoordinates()};
+        }
+
+        [[nodiscard]]
+        std::optional<RayHit> getRayHit(Ray const& ray,
+                                        double const maxDistance = std::numeric_limits<double>::infinity()) const {
+            return getRayHit(ray.getOrigin(), ray.getDirection(), maxDistance);
+        }
+
+        // Unlike the plane of the triangle, the triangle is only hit inside its edges and in front of the ray origin
+        IntersectionResult intersectWithRay(Ray const& ray) override {
+            IntersectionResult result{IntersectionStatus::NoIntersection, {}};
+            if (auto const hit = getRayHit(ray)) {
+                result.status = IntersectionStatus::Intersects;
+                result.intersectionPoint = ray.getOrigin() + hit->distance * ray.getDirection();
+            }
+            return result;
+        }
+
+        // Intersect a packet of rays with the triangle using the Möller–Trumbore algorithm. As with intersectWithRay,
+        // hits behind the ray origins don't count and rays parallel to the triangle miss it
+        template<unsigned N>
+        [[nodiscard]] PacketIntersectionResult<N> intersectWithRays(RayPacket<N> const& rays) const {
+            using Register = batch::PacketRegister<N>;
+            using Lanes = typename Register::Type;
+            batch::PacketRays<N> const packet(rays);
+            Vector3<float> const vertex = vertices[0];
+            Vector3<float> const edge1 = this->edge1;
+            Vector3<float> const edge2 = this->edge2;
+
+            // Cross products of N vectors with one vector
+            struct Lanes3 {
+                Lanes x, y, z;
+            };
+            auto const cross = [](Lanes3 const& a, Vector3<float> const& b) {
+                auto const bX = Register::broadcast(b.x);
+                auto const bY = Register::broadcast(b.y);
+                auto const bZ = Register::broadcast(b.z);
+                return Lanes3{Register::subtract(Register::multiply(a.y, bZ), Register::multiply(a.z, bY)),
+                              Register::subtract(Register::multiply(a.z, bX), Register::multiply(a.x, bZ)),
+                              Register::subtract(Register::multiply(a.x, bY), Register::multiply(a.y, bX))};
+            };
+            auto const dot = [](Lanes3 const& a, Lanes3 const& b) {
+                return Register::add(Register::add(Register::multiply(a.x, b.x), Register::multiply(a.y, b.y)),
+                                     Register::multiply(a.z, b.z));
+            };
+
+            // p = direction x edge2, s = origin - vertex, q = s x edge1. The barycentric coordinates of the hit are
+            // u = (s . p) / determinant and v = (direction . q) / determinant
+            Lanes3 const direction{packet.directionX, packet.directionY, packet.directionZ};
+            auto const p = cross(direction, edge2);
+            auto const determinant = batch::PacketRays<N>::dot(p.x, p.y, p.z, edge1);
+            auto const inverseDeterminant = Register::divide(Register::broadcast(1.f), determinant);
+            Lanes3 const s{Register::subtract(packet.originX, Register::broadcast(vertex.x)),
+                           Register::subtract(packet.originY, Register::broadcast(vertex.y)),
+                           Register::subtract(packet.originZ, Register::broadcast(vertex.z))};
+            auto const u = Register::multiply(dot(s, p), inverseDeterminant);
+            auto const q = cross(s, edge1);
+            auto const v = Register::multiply(dot(direction, q), inverseDeterminant);
+            auto const distance = Register::multiply(batch::PacketRays<N>::dot(q.x, q.y, q.z, edge2),
+                                                     inverseDeterminant);
+
+            // Same parallel ray test as kernels::isDeterminantSignificant, so packets and single rays agree
+            constexpr float squaredEpsilon =
+                std::numeric_limits<float>::epsilon() * std::numeric_limits<float>::epsilon();
+            auto const threshold = Register::multiply(
+                Register::broadcast(squaredEpsilon * edge1.dot(edge1) * edge2.dot(edge2)), dot(direction, direction));
+            auto const zero = Register::broadcast(0.f);
+            auto hits = Register::lessThan(threshold, Register::multiply(determinant, determinant));
+            hits = Register::logicalAnd(hits, Register::lessThanOrEqual(zero, u));
+            hits = Register::logicalAnd(hits, Register::lessThanOrEqual(zero, v));
+            hits = Register::logicalAnd(hits, Register::lessThanOrEqual(Register::add(u, v), Register::broadcast(1.f)));
+            hits = Register::logicalAnd(hits, Register::lessThanOrEqual(zero, distance));
+            return batch::makePacketIntersectionResult(packet, Register::bits(hits) & rays.getActiveMask(), distance);
         }
 
+        // Points on the plane of the triangle, within tolerance, with no negative barycentric coordinate
         [[nodiscard]]
         bool isPointInTriangle(Point3D const& pointInSpace) const {
-            auto barycentricCoordinates = getBarycentricCoordinates(pointInSpace);
-            return fabs(barycentricCoordinates.x + barycentricCoordinates.y + barycentricCoordinates.z - 1) <
-                constants::tolerance;
+            if (!Utilities::isZero(getDistanceToPoint(pointInSpace))) return false;
+            auto const barycentricCoordinates = getBarycentricCoordinates(pointInSpace);
+            return barycentricCoordinates.x > -constants::tolerance &&
+                   barycentricCoordinates.y > -constants::tolerance &&
+                   barycentricCoordinates.z > -constants::tolerance;
         }
 
     private:
         Points vertices;
+        // Edges from the first vertex to the other two, and their dot products, for ray hits and barycentric
+        // coordinates
+        types::Vector3D edge1;
+        types::Vector3D edge2;
+        kernels::TriangleEdgeProducts<double> edgeProducts;
     };
 
 }
\ No newline at end of file
@@ -22,13 +22,16 @@ void bind_Matrix(py::module_ const& module, char const* className) {
         }
         return matrix{dataAsVec, order};
     }))
+    // Subscript operators don't validate indices in release builds, so indices from python are validated here
     .def("__getitem__", [](matrix const& matrix, uint32_t const index) {
+        if (index >= Cols) throw py::index_error("Invalid column index " + std::to_string(index));
         return matrix.operator[](index);
     })
     .def("__getitem__", [](matrix const& matrix, std::pair<uint32_t, uint32_t> const& index_pair) {
-        return matrix.operator()(index_pair.first, index_pair.second);
+        return matrix.at(index_pair.first, index_pair.second);
     })
     .def("row", [](matrix const& matrix, uint32_t row) {
+        if (row >= Rows) throw py::index_error("Invalid row index " + std::to_string(row));
         return matrix.operator()(row);
     })
     .def(py::self * py::self)
@@ -26,12 +26,13 @@ void bind_Vector(py::module_ const& module, char const* className) {
             return util::convertSpaceToNewLine(v.asString());
         })
         // Operations
-        .def(py::self + py::self)
-        .def(py::self - py::self)
-        .def(py::self * T{})
-        .def(T{} * py::self)
-        .def(py::self / T{})
-        .def("dot", &vector::dot)
+        // Arithmetic operators return lazily evaluated expressions, so results are evaluated to vectors here
+        .def("__add__", [](vector const& a, vector const& b) -> vector { return a + b; }, py::is_operator())
+        .def("__sub__", [](vector const& a, vector const& b) -> vector { return a - b; }, py::is_operator())
+        .def("__mul__", [](vector const& v, T scalar) -> vector { return v * scalar; }, py::is_operator())
+        .def("__rmul__", [](vector const& v, T scalar) -> vector { return scalar * v; }, py::is_operator())
+        .def("__truediv__", [](vector const& v, T scalar) -> vector { return v / scalar; }, py::is_operator())
+        .def("dot", [](vector const& self, vector const& another) { return self.dot(another); })
         .def("normalize", [](vector& v) { v.normalize(); return v; })
         .def("length", [](vector const& v) { return v.length(); })
         .def("length_sqr", [](vector const& v) { return v.lengthSquared(); })
@@ -44,7 +45,7 @@ void bind_Vector(py::module_ const& module, char const* className) {
         .def(py::init([](T x, T y, T z) {
             return vector({x, y, z});
         }))
-        .def(py::self * py::self);
+        .def("__mul__", [](vector const& a, vector const& b) -> vector { return a * b; }, py::is_operator());
     }
     if constexpr (Size == 4) {
         pyVecClass
@@ -58,12 +59,11 @@ void bind_Vector(py::module_ const& module, char const* className) {
     }
 
     // Convenience member access (x, y, z, w)
-    // .x, .y, .z, .w are Vector<T, N>::Proxy and its conversion operator has to be invoked to get the raw value
-    // hence the static cast
+    // .x, .y, .z, .w are plain members that alias the vector's elements
     if constexpr (Size >= 2 && Size <= 4) {
         pyVecClass.def_property("x",
             [](vector const& self) {
-                    return static_cast<T>(self.x);
+                    return self.x;
                 },
             [](vector& self, T value) {
                     self.x = value;
@@ -71,7 +71,7 @@ void bind_Vector(py::module_ const& module, char const* className) {
         )
         .def_property("y",
             [](vector const& self) {
-                    return static_cast<T>(self.y);
+                    return self.y;
                 },
             [](vector& self, T value) {
                     self.y = value;
@@ -81,7 +81,7 @@ void bind_Vector(py::module_ const& module, char const* className) {
     if constexpr (Size == 3 || Size == 4 ) {
         pyVecClass.def_property("z",
             [](vector const& self) {
-                    return static_cast<T>(self.z);
+                    return self.z;
                 },
             [](vector& self, T value) {
                     self.z = value;
@@ -91,7 +91,7 @@ void bind_Vector(py::module_ const& module, char const* className) {
     if constexpr (Size == 4) {
         pyVecClass.def_property("w",
             [](vector const& self) {
-                    return static_cast<T>(self.w);
+                    return self.w;
                 },
             [](vector& self, T value) {
                     self.w = value;
@@ -0,0 +1,181 @@
+#include "gtest/gtest.h"
+#include "3dmath/BatchLinearSystems.h"
+#include "3dmath/LinearSystem.h"
+#include <cmath>
+#include <memory>
+#include <random>
+#include <vector>
+using namespace math3d;
+
+namespace {
+    // Structure of arrays storage for count N x N systems and their solutions
+    template<unsigned N>
+    struct Systems {
+        explicit Systems(size_t const count)
+        : count(count)
+        , coefficients(N * N, std::vector<float>(count))
+        , rightHandSides(N, std::vector<float>(count))
+        , solutions(N, std::vector<float>(count))
+        , singular(std::make_unique<bool[]>(count)) {
+        }
+
+        LinearSystemSpans<float, N> spans() {
+            LinearSystemSpans<float, N> result;
+            for (unsigned i = 0; i < N * N; ++i) result.coefficients[i] = coefficients[i];
+            for (unsigned i = 0; i < N; ++i) result.rightHandSides[i] = rightHandSides[i];
+            return result;
+        }
+
+        std::array<std::span<float>, N> solutionSpans() {
+            std::array<std::span<float>, N> result;
+            for (unsigned i = 0; i < N; ++i) result[i] = solutions[i];
+            return result;
+        }
+
+        std::span<bool> singularFlags() {
+            return {singular.get(), count};
+        }
+
+        float& coefficient(size_t const system, unsigned const row, unsigned const col) {
+            return coefficients[col * N + row][system];
+        }
+
+        size_t count;
+        std::vector<std::vector<float>> coefficients;
+        std::vector<std::vector<float>> rightHandSides;
+        std::vector<std::vector<float>> solutions;
+        std::unique_ptr<bool[]> singular;
+    };
+
+    template<unsigned N>
+    Systems<N> randomSystems(size_t const count) {
+        std::mt19937 generator(count);
+        std::uniform_real_distribution<float> distribution(-10, 10);
+        Systems<N> systems(count);
+        for (auto& coefficient : systems.coefficients) {
+            for (auto& value : coefficient) value = distribution(generator);
+        }
+        for (auto& rightHandSide : systems.rightHandSides) {
+            for (auto& value : rightHandSide) value = distribution(generator);
+        }
+        return systems;
+    }
+
+    // Partial pivoting is backward stable, so the residual is small relative to the magnitudes of A and x
+    template<unsigned N>
+    void validateSolutions(Systems<N>& systems) {
+        for (size_t system = 0; system < systems.count; ++system) {
+            ASSERT_FALSE(systems.singular[system]) << system;
+            float largestSolution = 0, largestCoefficient = 0;
+            for (unsigned row = 0; row < N; ++row) {
+                largestSolution = std::max(largestSolution, std::fabs(systems.solutions[row][system]));
+                for (unsigned col = 0; col < N; ++col) {
+                    largestCoefficient = std::max(largestCoefficient, std::fabs(systems.coefficient(system, row, col)));
+                }
+            }
+            for (unsigned row = 0; row < N; ++row) {
+                double residual = -systems.rightHandSides[row][system];
+                for (unsigned col = 0; col < N; ++col) {
+                    residual += double{systems.coefficient(system, row, col)} * systems.solutions[col][system];
+                }
+                ASSERT_LE(std::fabs(residual), 1e-5 * N * largestCoefficient * largestSolution + 1e-5) << system;
+            }
+        }
+    }
+
+    template<unsigned N, unsigned lanes>
+    void testSolve(size_t const count, Execution const execution = Execution::Sequential) {
+        auto systems = randomSystems<N>(count);
+        batch::solveLinearSystems<N, lanes>(systems.spans(), systems.solutionSpans(), systems.singularFlags(),
+                                            execution);
+        validateSolutions(systems);
+    }
+}
+
+TEST(BatchLinearSystems, Solve) {
+    // Counts that fill packets exactly and that leave a partial packet
+    for (size_t const count : {1, 7, 16, 1003}) {
+        testSolve<2, 4>(count);
+        testSolve<3, 4>(count);
+        testSolve<3, 8>(count);
+        testSolve<3, 16>(count);
+        testSolve<4, 8>(count);
+        testSolve<4, 16>(count);
+        testSolve<6, 8>(count);
+    }
+}
+
+TEST(BatchLinearSystems, MatchesLinearSystem) {
+    auto systems = randomSystems<3>(100);
+    batch::solveLinearSystems<3>(systems.spans(), systems.solutionSpans(), systems.singularFlags());
+    for (size_t system = 0; system < systems.count; ++system) {
+        Matrix<double, 3, 3> a;
+        Vector<double, 3> b;
+        for (unsigned row = 0; row < 3; ++row) {
+            for (unsigned col = 0; col < 3; ++col) {
+                a(row, col) = systems.coefficient(system, row, col);
+            }
+            b[row] = systems.rightHandSides[row][system];
+        }
+        auto const expected = LinearSystem<double, 3>::solveLinearSystem(a, b);
+        for (unsigned row = 0; row < 3; ++row) {
+            ASSERT_NEAR(systems.solutions[row][system], expected[row], 1e-3 * std::max(1., std::fabs(expected[row])));
+        }
+    }
+}
+
+TEST(BatchLinearSystems, Pivoting) {
+    // Systems whose diagonal is zero can only be solved by swapping rows, and different systems need different swaps
+    Systems<3> systems(3);
+    std::array<std::array<unsigned, 3>, 3> const permutations{{{1, 2, 0}, {2, 0, 1}, {0, 2, 1}}};
+    for (size_t system = 0; system < 3; ++system) {
+        for (unsigned row = 0; row < 3; ++row) {
+            // Row row has a single non-zero coefficient, in column permutations[system][row]
+            systems.coefficient(system, row, permutations[system][row]) = static_cast<float>(row + 1);
+            systems.rightHandSides[row][system] = static_cast<float>(row + 1) * 10.f * (permutations[system][row] + 1);
+        }
+    }
+    batch::solveLinearSystems<3>(systems.spans(), systems.solutionSpans(), systems.singularFlags());
+    for (size_t system = 0; system < 3; ++system) {
+        ASSERT_FALSE(systems.singular[system]);
+        for (unsigned row = 0; row < 3; ++row) {
+            ASSERT_FLOAT_EQ(systems.solutions[row][system], 10.f * (row + 1));
+        }
+    }
+}
+
+TEST(BatchLinearSystems, Singular) {
+    auto systems = randomSystems<3>(20);
+    // A zero matrix, a matrix with two equal rows and a matrix with a zero column
+    for (unsigned i = 0; i < 9; ++i) systems.coefficients[i][3] = 0;
+    for (unsigned col = 0; col < 3; ++col) systems.coefficient(10, 2, col) = systems.coefficient(10, 0, col);
+    for (unsigned row = 0; row < 3; ++row) systems.coefficient(17, row, 1) = 0;
+    batch::solveLinearSystems<3>(systems.spans(), systems.solutionSpans(), systems.singularFlags());
+    for (size_t system = 0; system < systems.count; ++system) {
+        auto const isSingular = system == 3 || system == 10 || system == 17;
+        ASSERT_EQ(systems.singular[system], isSingular) << system;
+        for (unsigned row = 0; row < 3; ++row) {
+            ASSERT_EQ(std::isnan(systems.solutions[row][system]), isSingular) << system;
+        }
+    }
+}
+
+TEST(BatchLinearSystems, Parallel) {
+    constexpr size_t count = 200'003;
+    auto sequential = randomSystems<4>(count);
+    auto parallel = randomSystems<4>(count);
+    batch::solveLinearSystems<4>(sequential.spans(), sequential.solutionSpans(), sequential.singularFlags());
+    batch::solveLinearSystems<4>(parallel.spans(), parallel.solutionSpans(), parallel.singularFlags(),
+                                 Execution::Parallel);
+    ASSERT_EQ(sequential.solutions, parallel.solutions);
+}
+
+TEST(BatchLinearSystems, SizeMismatch) {
+    auto systems = randomSystems<3>(10);
+    auto spans = systems.spans();
+    spans.rightHandSides[1] = spans.rightHandSides[1].first(9);
+    ASSERT_THROW(batch::solveLinearSystems<3>(spans, systems.solutionSpans(), systems.singularFlags()),
+                 std::invalid_argument);
+    ASSERT_THROW(batch::solveLinearSystems<3>(systems.spans(), systems.solutionSpans(),
+                                              systems.singularFlags().first(5)), std::invalid_argument);
+}
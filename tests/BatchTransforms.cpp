@@ -0,0 +1,152 @@
+#include "gtest/gtest.h"
+#include "3dmath/BatchTransforms.h"
+#include "3dmath/MatrixOperations.h"
+#include "3dmath/SupportingTypes.h"
+#include <limits>
+#include <random>
+#include <vector>
+using namespace math3d;
+
+namespace {
+    // Random affine transform
+    template<typename T>
+    Matrix<T, 4, 4> randomTransform(std::mt19937& generator) {
+        std::uniform_real_distribution<T> distribution(-10, 10);
+        Matrix<T, 4, 4> transform;
+        for (unsigned row = 0; row < 3; ++row) {
+            for (unsigned column = 0; column < 4; ++column) {
+                transform(row, column) = distribution(generator);
+            }
+        }
+        transform(3, 3) = T{1};
+        return transform;
+    }
+
+    template<typename T>
+    std::vector<Vector3<T>> randomPoints(std::mt19937& generator, size_t const count) {
+        std::uniform_real_distribution<T> distribution(-100, 100);
+        std::vector<Vector3<T>> points(count);
+        for (auto& point : points) {
+            point = {distribution(generator), distribution(generator), distribution(generator)};
+        }
+        return points;
+    }
+
+    template<typename T>
+    void expectTransformed(Matrix<T, 4, 4> const& transform, Vector3<T> const& input, Vector3<T> const& actual,
+                           T const w) {
+        // Products of elements are in the thousands, so cancellation errors are relative to that magnitude
+        auto const tolerance = std::numeric_limits<T>::epsilon() * T{1e4};
+        auto const expected = transform * Vector4<T>(input, w);
+        for (unsigned i = 0; i < 3; ++i) {
+            ASSERT_NEAR(expected[i], actual[i], tolerance);
+        }
+    }
+
+    template<typename T>
+    void testArraysOfVectors(size_t const count, Execution const execution) {
+        std::mt19937 generator(42);
+        auto const transform = randomTransform<T>(generator);
+        auto const points = randomPoints<T>(generator, count);
+
+        std::vector<Vector3<T>> transformed(count);
+        transformPoints(transform, points, transformed, execution);
+        for (size_t i = 0; i < count; ++i) {
+            expectTransformed(transform, points[i], transformed[i], T{1});
+        }
+
+        transformDirections(transform, points, transformed, execution);
+        for (size_t i = 0; i < count; ++i) {
+            expectTransformed(transform, points[i], transformed[i], T{0});
+        }
+
+        transformed = points;
+        transformPoints(transform, transformed, execution);
+        for (size_t i = 0; i < count; ++i) {
+            expectTransformed(transform, points[i], transformed[i], T{1});
+        }
+    }
+
+    template<typename T>
+    void testSeparateCoordinates(size_t const count, Execution const execution) {
+        std::mt19937 generator(7);
+        auto const transform = randomTransform<T>(generator);
+        auto const points = randomPoints<T>(generator, count);
+
+        std::vector<T> x(count), y(count), z(count);
+        for (size_t i = 0; i < count; ++i) {
+            x[i] = points[i].x;
+            y[i] = points[i].y;
+            z[i] = points[i].z;
+        }
+        std::vector<T> outX(count), outY(count), outZ(count);
+        transformPoints(transform, CoordinateSpans<T const>{x, y, z}, CoordinateSpans<T>{outX, outY, outZ},
+                        execution);
+        for (size_t i = 0; i < count; ++i) {
+            expectTransformed(transform, points[i], {outX[i], outY[i], outZ[i]}, T{1});
+        }
+
+        transformDirections(transform, CoordinateSpans<T>{x, y, z}, execution);
+        for (size_t i = 0; i < count; ++i) {
+            expectTransformed(transform, points[i], {x[i], y[i], z[i]}, T{0});
+        }
+    }
+}
+
+TEST(BatchTransforms, ArraysOfVectors) {
+    // Sizes that aren't multiples of the vector width exercise the scalar tail
+    for (size_t count : {0, 1, 3, 4, 5, 17, 1000}) {
+        testArraysOfVectors<float>(count, Execution::Sequential);
+        testArraysOfVectors<double>(count, Execution::Sequential);
+    }
+}
+
+TEST(BatchTransforms, SeparateCoordinates) {
+    for (size_t count : {0, 1, 3, 4, 5, 17, 1000}) {
+        testSeparateCoordinates<float>(count, Execution::Sequential);
+        testSeparateCoordinates<double>(count, Execution::Sequential);
+    }
+}
+
+TEST(BatchTransforms, ParallelExecution) {
+    // Large enough to be split across threads, with a remainder that isn't a multiple of four
+    size_t const count = batch::minimumElementsPerThread * 3 + 7;
+    testArraysOfVectors<float>(count, Execution::Parallel);
+    testArraysOfVectors<double>(count, Execution::Parallel);
+    testSeparateCoordinates<float>(count, Execution::Parallel);
+}
+
+TEST(BatchTransforms, SizeMismatch) {
+    std::vector<Vector3<float>> in(4), out(3);
+    EXPECT_THROW(transformPoints(Matrix<float, 4, 4>{}, in, out), std::invalid_argument);
+    std::vector<float> x(4), y(4), z(3);
+    EXPECT_THROW(transformPoints(Matrix<float, 4, 4>{}, CoordinateSpans<float>{x, y, z}), std::invalid_argument);
+}
+
+TEST(BatchTransforms, Remapper) {
+    Bounds3D<float> const source{{-1, -1, -1}, {1, 1, 1}};
+    Bounds3D<float> const destination{{0, 0, 0}, {10, 20, 30}};
+    Remapper const remapper{source, destination};
+    std::mt19937 generator(3);
+    auto const points = randomPoints<float>(generator, 33);
+    std::vector<Vector3<float>> remapped(points.size());
+    remapper(points, remapped);
+    for (size_t i = 0; i < points.size(); ++i) {
+        auto const expected = remapper(points[i]);
+        for (unsigned j = 0; j < 3; ++j) {
+            ASSERT_NEAR(expected[j], remapped[i][j], 1e-3);
+        }
+    }
+}
+
+TEST(BatchTransforms, RemapperInverse) {
+    // Remapping a large box to the unit box scales by 1e-3, which must not be mistaken for a singular transform
+    Bounds3D<float> const source{{0, 0, 0}, {1000, 1000, 1000}};
+    Bounds3D<float> const destination{{0, 0, 0}, {1, 1, 1}};
+    Remapper remapper{source, destination};
+    auto const inverse = remapper.getInverseTransform();
+    auto const restored = inverse * Vector4<float>(remapper({250, 500, 1000}), 1);
+    ASSERT_NEAR(restored.x, 250, 1e-3);
+    ASSERT_NEAR(restored.y, 500, 1e-3);
+    ASSERT_NEAR(restored.z, 1000, 1e-3);
+}
@@ -0,0 +1,168 @@
+#include "gtest/gtest.h"
+#include "3dmath/BoundingVolumeHierarchy.h"
+#include "3dmath/primitives/Sphere.h"
+#include <optional>
+#include <random>
+using namespace math3d;
+using namespace math3d::types;
+
+namespace {
+    // Random triangles with sides of about unit length scattered in a 20x20x20 box
+    std::pair<Vertices, Tris> randomTriangles(unsigned const count, std::mt19937& generator) {
+        std::uniform_real_distribution<float> position(-10, 10);
+        std::uniform_real_distribution<float> offset(-1, 1);
+        Vertices vertices;
+        Tris tris;
+        for (unsigned i = 0; i < count; ++i) {
+            Vertex const a{position(generator), position(generator), position(generator)};
+            vertices.push_back(a);
+            vertices.push_back(a + Vertex{offset(generator), offset(generator), offset(generator)});
+            vertices.push_back(a + Vertex{offset(generator), offset(generator), offset(generator)});
+            tris.emplace_back(3 * i, 3 * i + 1, 3 * i + 2);
+        }
+        return {vertices, tris};
+    }
+
+    Vector3D asDouble(Vertex const& vertex) {
+        return {vertex.x, vertex.y, vertex.z};
+    }
+
+    // Reference for the hierarchy: intersect every triangle in double precision and keep the nearest hit
+    std::optional<double> closestHitByLinearScan(Vertices const& vertices, Tris const& tris,
+                                                 Vector3D const& origin, Vector3D const& direction) {
+        std::optional<double> closest;
+        for (auto const& tri : tris) {
+            Vector3D const a = asDouble(vertices[tri[0]]);
+            Vector3D const ab = asDouble(vertices[tri[1]]) - a;
+            Vector3D const ac = asDouble(vertices[tri[2]]) - a;
+            auto const p = direction * ac;
+            auto const determinant = ab.dot(p);
+            if (std::abs(determinant) < 1e-12) continue;
+            Vector3D const s = origin - a;
+            auto const u = s.dot(p) / determinant;
+            auto const q = s * ab;
+            auto const v = direction.dot(q) / determinant;
+            auto const t = ac.dot(q) / determinant;
+            if (u >= 0 && v >= 0 && u + v <= 1 && t >= 0 && (!closest || t < *closest)) {
+                closest = t;
+            }
+        }
+        return closest;
+    }
+
+    void testAgainstLinearScan(Vertices const& vertices, Tris const& tris, std::mt19937& generator) {
+        BoundingVolumeHierarchy const hierarchy(vertices, tris);
+        ASSERT_EQ(hierarchy.getNumberOfTriangles(), tris.size());
+
+        std::uniform_real_distribution<double> coordinate(-1, 1);
+        std::uniform_real_distribution<double> target(-10, 10);
+        unsigned numberOfHits = 0;
+        for (unsigned i = 0; i < 500; ++i) {
+            // Rays start outside the geometry and are aimed at random points inside it
+            Vector3D origin{coordinate(generator), coordinate(generator), coordinate(generator)};
+            origin = 30. * origin.normalize();
+            Vector3D direction = Vector3D{target(generator), target(generator), target(generator)} - origin;
+            direction.normalize();
+
+            auto const expected = closestHitByLinearScan(vertices, tris, origin, direction);
+            auto const actual = hierarchy.closestHit(Ray{origin, direction});
+            ASSERT_EQ(expected.has_value(), actual.has_value()) << "Ray " << i;
+            ASSERT_EQ(expected.has_value(), hierarchy.anyHit(Ray{origin, direction}).has_value()) << "Ray " << i;
+            if (!expected) continue;
+            ++numberOfHits;
+
+            ASSERT_NEAR(*expected, actual->distance, 1e-3) << "Ray " << i;
+
+            // The barycentric coordinates of the hit must reproduce the hit point
+            auto const& tri = tris[actual->triangleIndex];
+            auto const& weights = actual->barycentricCoordinates;
+            Vertex const pointFromWeights =
+                weights.x * vertices[tri[0]] + weights.y * vertices[tri[1]] + weights.z * vertices[tri[2]];
+            Vertex const pointOnRay = Utilities::asFloat(origin + actual->distance * direction);
+            ASSERT_NEAR((pointFromWeights - pointOnRay).length(), 0, 1e-3) << "Ray " << i;
+            ASSERT_NEAR(weights.x + weights.y + weights.z, 1, 1e-5);
+        }
+        ASSERT_GT(numberOfHits, 0);
+    }
+}
+
+TEST(BoundingVolumeHierarchy, RandomTriangles) {
+    std::mt19937 generator(1);
+    auto const [vertices, tris] = randomTriangles(5000, generator);
+    testAgainstLinearScan(vertices, tris, generator);
+}
+
+TEST(BoundingVolumeHierarchy, SphereMesh) {
+    Sphere sphere({1, 2, 3}, 8, 64);
+    sphere.generateGeometry();
+    std::mt19937 generator(2);
+    testAgainstLinearScan(sphere.getVertices(), sphere.getTris(), generator);
+
+    // A ray from the center hits the sphere about a radius away
+    BoundingVolumeHierarchy const hierarchy(sphere.getVertices(), sphere.getTris());
+    auto const hit = hierarchy.closestHit({1, 2, 3}, {1, 0, 0});
+    ASSERT_TRUE(hit.has_value());
+    ASSERT_NEAR(hit->distance, 8, 0.1);
+    ASSERT_TRUE(hierarchy.getBounds().contains({9, 2, 3}));
+}
+
+TEST(BoundingVolumeHierarchy, ParallelBuild) {
+    // Large enough for the top of the hierarchy to be split into subtrees that are built on separate threads
+    Sphere sphere({0, 0, 0}, 10, 256);
+    sphere.generateGeometry();
+    BoundingVolumeHierarchy const sequential(sphere.getVertices(), sphere.getTris());
+    BoundingVolumeHierarchy const parallel(sphere.getVertices(), sphere.getTris(), Execution::Parallel);
+    ASSERT_EQ(sequential.getNumberOfNodes(), parallel.getNumberOfNodes());
+
+    std::mt19937 generator(3);
+    std::uniform_real_distribution<float> coordinate(-1, 1);
+    for (unsigned i = 0; i < 1000; ++i) {
+        Vertex const origin{5 * coordinate(generator), 5 * coordinate(generator), 5 * coordinate(generator)};
+        Vertex const direction = Vertex{coordinate(generator), coordinate(generator), coordinate(generator)}.normalize();
+        auto const expected = sequential.closestHit(origin, direction);
+        auto const actual = parallel.closestHit(origin, direction);
+        ASSERT_EQ(expected.has_value(), actual.has_value()) << "Ray " << i;
+        if (!expected) continue;
+        ASSERT_EQ(expected->triangleIndex, actual->triangleIndex) << "Ray " << i;
+        ASSERT_FLOAT_EQ(expected->distance, actual->distance) << "Ray " << i;
+    }
+}
+
+TEST(BoundingVolumeHierarchy, MaxDistance) {
+    Vertices const vertices{{-1, -1, 5}, {1, -1, 5}, {0, 1, 5}};
+    Tris const tris{{0, 1, 2}};
+    BoundingVolumeHierarchy const hierarchy(vertices, tris);
+
+    auto const hit = hierarchy.closestHit({0, 0, 0}, {0, 0, 1});
+    ASSERT_TRUE(hit.has_value());
+    ASSERT_EQ(hit->triangleIndex, 0);
+    ASSERT_FLOAT_EQ(hit->distance, 5);
+    ASSERT_FALSE(hierarchy.closestHit({0, 0, 0}, {0, 0, 1}, 4.f).has_value());
+    ASSERT_FALSE(hierarchy.anyHit({0, 0, 0}, {0, 0, 1}, 4.f).has_value());
+    ASSERT_TRUE(hierarchy.anyHit({0, 0, 0}, {0, 0, 1}, 6.f).has_value());
+
+    // Triangles behind the ray origin are not hit
+    ASSERT_FALSE(hierarchy.closestHit({0, 0, 0}, {0, 0, -1}).has_value());
+}
+
+TEST(BoundingVolumeHierarchy, SmallTriangles) {
+    // A right triangle with legs of 1e-4 is hit by a unit ray through its interior
+    Vertices const vertices{{0, 0, 1}, {1e-4f, 0, 1}, {0, 1e-4f, 1}};
+    Tris const tris{{0, 1, 2}};
+    BoundingVolumeHierarchy const hierarchy(vertices, tris);
+    auto const hit = hierarchy.closestHit({2.5e-5f, 2.5e-5f, 0}, {0, 0, 1});
+    ASSERT_TRUE(hit.has_value());
+    ASSERT_FLOAT_EQ(hit->distance, 1);
+    ASSERT_TRUE(hierarchy.anyHit({2.5e-5f, 2.5e-5f, 0}, {0, 0, 1}).has_value());
+}
+
+TEST(BoundingVolumeHierarchy, EmptyAndInvalidMeshes) {
+    BoundingVolumeHierarchy const empty(Vertices{}, Tris{});
+    ASSERT_FALSE(empty.closestHit({0, 0, 0}, {0, 0, 1}).has_value());
+    ASSERT_FALSE(empty.getBounds().isValid());
+    ASSERT_EQ(empty.getNumberOfNodes(), 0);
+
+    Vertices const vertices{{0, 0, 0}, {1, 0, 0}};
+    Tris const tris{{0, 1, 2}};
+    ASSERT_THROW(BoundingVolumeHierarchy(vertices, tris), std::invalid_argument);
+}
@@ -0,0 +1,79 @@
+#include "gtest/gtest.h"
+#include "3dmath/CholeskyDecomposition.h"
+#include "3dmath/LinearSystem.h"
+#include "3dmath/MatrixOperations.h"
+#include "TestSupport.h"
+#include <random>
+using namespace math3d;
+
+namespace {
+    // B^T B + I is symmetric positive definite for any B
+    template<typename T, unsigned N>
+    Matrix<T, N, N> randomPositiveDefiniteMatrix(std::mt19937& generator) {
+        auto const b = test::TestSupport::randomMatrix<T, N>(generator);
+        Matrix<T, N, N> result = b.transpose() * b;
+        for (unsigned i = 0; i < N; ++i) {
+            result(i, i) += 1;
+        }
+        return result;
+    }
+}
+
+TEST(CholeskyDecomposition, Factor) {
+    std::mt19937 generator(1);
+    auto const a = randomPositiveDefiniteMatrix<double, 6>(generator);
+    CholeskyDecomposition<double, 6> const cholesky(a);
+    ASSERT_TRUE(cholesky.isPositiveDefinite());
+
+    // A = L L^T, with L lower triangular and a positive diagonal
+    auto const lower = cholesky.getLower();
+    auto const product = lower * lower.transpose();
+    for (unsigned row = 0; row < 6; ++row) {
+        ASSERT_GT(lower(row, row), 0);
+        for (unsigned col = 0; col < 6; ++col) {
+            if (col > row) {
+                ASSERT_EQ(lower(row, col), 0);
+            }
+            ASSERT_NEAR(product(row, col), a(row, col), 1e-10 * std::fabs(a(row, row)));
+        }
+    }
+    ASSERT_NEAR(cholesky.determinant(), a.determinant(), 1e-9 * std::fabs(a.determinant()));
+}
+
+TEST(CholeskyDecomposition, Solve) {
+    std::mt19937 generator(2);
+    Matrix<float, 3, 3> const a{{4, 2, 0.4f}, {2, 5, 1}, {0.4f, 1, 3}};
+    Vector<float, 3> const b{1, -2, 3};
+    auto const expected = LinearSystem<float, 3>::solveLinearSystem(a, b);
+    auto const solution = CholeskyDecomposition<float, 3>(a).solve(b);
+    for (unsigned i = 0; i < 3; ++i) {
+        ASSERT_NEAR(solution[i], expected[i], 1e-5);
+    }
+
+    auto const large = randomPositiveDefiniteMatrix<double, 16>(generator);
+    CholeskyDecomposition<double, 16> const cholesky(large);
+    Matrix<double, 16, 2> rightHandSides;
+    for (unsigned row = 0; row < 16; ++row) {
+        rightHandSides(row, 0) = row;
+        rightHandSides(row, 1) = 1;
+    }
+    auto const solutions = cholesky.solve(rightHandSides);
+    auto const residual = large * solutions;
+    for (unsigned row = 0; row < 16; ++row) {
+        ASSERT_NEAR(residual(row, 0), row, 1e-9);
+        ASSERT_NEAR(residual(row, 1), 1, 1e-9);
+    }
+}
+
+TEST(CholeskyDecomposition, NotPositiveDefinite) {
+    // Symmetric, but with eigenvalues 3 and -1
+    Matrix<double, 2, 2> const indefinite{{1, 2}, {2, 1}};
+    CholeskyDecomposition<double, 2> const cholesky(indefinite);
+    ASSERT_FALSE(cholesky.isPositiveDefinite());
+    ASSERT_THROW(static_cast<void>(cholesky.solve(Vector<double, 2>{1, 1})), std::runtime_error);
+    ASSERT_THROW(static_cast<void>(cholesky.determinant()), std::runtime_error);
+    ASSERT_THROW(static_cast<void>(cholesky.getLower()), std::runtime_error);
+
+    Matrix<double, 3, 3> const semidefinite{{1, 1, 0}, {1, 1, 0}, {0, 0, 1}};
+    ASSERT_FALSE((CholeskyDecomposition<double, 3>(semidefinite).isPositiveDefinite()));
+}
@@ -0,0 +1,193 @@
+#include "gtest/gtest.h"
+#include "3dmath/DynamicMatrix.h"
+#include "3dmath/MatrixOperations.h"
+#include "TestSupport.h"
+#include <random>
+#include <vector>
+using namespace math3d;
+
+namespace {
+    // Integer elements keep products exact, so they can be compared with the naive product for equality
+    template<typename T>
+    DynamicMatrix<T> randomMatrix(unsigned const numRows, unsigned const numCols, std::mt19937& generator) {
+        DynamicMatrix<T> matrix(numRows, numCols);
+        test::TestSupport::randomize(matrix, generator, -8, 8);
+        return matrix;
+    }
+
+    // Textbook triple loop
+    template<typename T>
+    DynamicMatrix<T> multiplyNaive(DynamicMatrix<T> const& a, DynamicMatrix<T> const& b) {
+        DynamicMatrix<T> result(a.getNumberOfRows(), b.getNumberOfColumns());
+        for (unsigned row = 0; row < a.getNumberOfRows(); ++row) {
+            for (unsigned col = 0; col < b.getNumberOfColumns(); ++col) {
+                T sum {};
+                for (unsigned k = 0; k < a.getNumberOfColumns(); ++k) {
+                    sum += a(row, k) * b(k, col);
+                }
+                result(row, col) = sum;
+            }
+        }
+        return result;
+    }
+
+    // Products of small integers are exact in every element type, so results are compared exactly
+    template<typename T>
+    void testProduct(unsigned const numRows, unsigned const depth, unsigned const numCols,
+                     Execution const execution = Execution::Sequential) {
+        std::mt19937 generator(numRows * depth * numCols);
+        auto const a = randomMatrix<T>(numRows, depth, generator);
+        auto const b = randomMatrix<T>(depth, numCols, generator);
+        auto const product = a.multiply(b, execution);
+        auto const expected = multiplyNaive(a, b);
+        ASSERT_EQ(product.getNumberOfRows(), numRows);
+        ASSERT_EQ(product.getNumberOfColumns(), numCols);
+        for (unsigned col = 0; col < numCols; ++col) {
+            for (unsigned row = 0; row < numRows; ++row) {
+                ASSERT_EQ(product(row, col), expected(row, col)) << numRows << 'x' << depth << 'x' << numCols <<
+                                                                    " [" << row << ',' << col << ']';
+            }
+        }
+    }
+}
+
+TEST(DynamicMatrix, Construction) {
+    DynamicMatrix<float> const zeros(3, 5);
+    ASSERT_EQ(zeros.getNumberOfRows(), 3);
+    ASSERT_EQ(zeros.getNumberOfColumns(), 5);
+    for (unsigned i = 0; i < 15; ++i) {
+        ASSERT_EQ(zeros.getData()[i], 0);
+    }
+
+    DynamicMatrix<int> const rowMajor{{1, 2, 3}, {4, 5, 6}};
+    ASSERT_EQ(rowMajor.getNumberOfRows(), 2);
+    ASSERT_EQ(rowMajor.getNumberOfColumns(), 3);
+    std::vector<int> const columnMajorData{1, 4, 2, 5, 3, 6};
+    ASSERT_TRUE(std::equal(columnMajorData.begin(), columnMajorData.end(), rowMajor.getData()));
+
+    DynamicMatrix<int> const columnMajor({{1, 4}, {2, 5}, {3, 6}}, Order::ColumnMajor);
+    ASSERT_EQ(columnMajor.getNumberOfRows(), 2);
+    ASSERT_TRUE(std::equal(columnMajorData.begin(), columnMajorData.end(), columnMajor.getData()));
+
+    ASSERT_THROW((DynamicMatrix<int>{{1, 2}, {3}}), std::invalid_argument);
+
+    auto const identity = DynamicMatrix<double>::identity(4);
+    for (unsigned row = 0; row < 4; ++row) {
+        for (unsigned col = 0; col < 4; ++col) {
+            ASSERT_EQ(identity(row, col), row == col ? 1 : 0);
+        }
+    }
+}
+
+TEST(DynamicMatrix, ElementAccess) {
+    DynamicMatrix<double> m(2, 3);
+    m(1, 2) = 5;
+    m.at(0, 1) = 3;
+    ASSERT_EQ(m.getData()[5], 5);
+    ASSERT_EQ(m.getData()[2], 3);
+    ASSERT_THROW(m.at(2, 0), std::runtime_error);
+    ASSERT_THROW(m.at(0, 3), std::runtime_error);
+    ASSERT_EQ(m.getColumn(2).size(), 2);
+    ASSERT_EQ(m.getColumn(2)[1], 5);
+    ASSERT_THROW(m.getColumn(3), std::runtime_error);
+}
+
+TEST(DynamicMatrix, Blocks) {
+    Matrix<float, 3, 2> const block{{1, 2}, {3, 4}, {5, 6}};
+    DynamicMatrix<float> m(5, 4);
+    m.setBlock(2, 1, block);
+    for (unsigned row = 0; row < 3; ++row) {
+        for (unsigned col = 0; col < 2; ++col) {
+            ASSERT_EQ(m(row + 2, col + 1), block(row, col));
+        }
+    }
+    ASSERT_EQ(m(1, 1), 0);
+    ASSERT_EQ(m(2, 0), 0);
+
+    auto const extracted = m.getBlock<2, 2>(3, 1);
+    ASSERT_EQ(extracted(0, 0), 3);
+    ASSERT_EQ(extracted(1, 1), 6);
+
+    ASSERT_THROW(m.setBlock(3, 1, block), std::runtime_error);
+    ASSERT_THROW(static_cast<void>(m.getBlock<2, 2>(4, 0)), std::runtime_error);
+
+    // Round trip through a fixed-size matrix
+    Matrix<double, 4, 4> const fixed{{1, 2, 3, 4}, {5, 6, 7, 8}, {9, 10, 11, 12}, {13, 14, 15, 16}};
+    DynamicMatrix<double> const dynamic(fixed);
+    auto const copy = dynamic.getBlock<4, 4>();
+    for (unsigned i = 0; i < 16; ++i) {
+        ASSERT_EQ(copy.getData()[i], fixed.getData()[i]);
+    }
+}
+
+TEST(DynamicMatrix, MatchesFixedSizeProduct) {
+    Matrix<double, 4, 4> const a{{1, 2, 3, 4}, {5, 6, 7, 8}, {9, 10, 11, 12}, {13, 14, 15, 16}};
+    Matrix<double, 4, 4> const b{{2, 0, 1, 0}, {0, 3, 0, 1}, {1, 0, 4, 0}, {0, 1, 0, 5}};
+    auto const expected = a * b;
+    auto const product = DynamicMatrix<double>(a) * DynamicMatrix<double>(b);
+    auto const result = product.getBlock<4, 4>();
+    for (unsigned i = 0; i < 16; ++i) {
+        ASSERT_EQ(result.getData()[i], expected.getData()[i]);
+    }
+
+    Vector<double, 4> const v{1, -2, 3, -4};
+    auto const expectedVector = a * v;
+    auto const productVector = DynamicMatrix<double>(a) * std::vector<double>{1, -2, 3, -4};
+    for (unsigned i = 0; i < 4; ++i) {
+        ASSERT_EQ(productVector[i], expectedVector[i]);
+    }
+}
+
+TEST(DynamicMatrix, Product) {
+    // Sizes that are smaller than a tile, that leave partial tiles and that span several blocks
+    for (auto const& [numRows, depth, numCols] : std::vector<std::array<unsigned, 3>>{
+            {1, 1, 1}, {3, 5, 7}, {16, 8, 4}, {37, 53, 29}, {130, 260, 9}, {257, 300, 1030}}) {
+        testProduct<float>(numRows, depth, numCols);
+        testProduct<double>(numRows, depth, numCols);
+    }
+    testProduct<int>(37, 53, 29);
+    testProduct<long double>(37, 53, 29);
+
+    ASSERT_THROW(DynamicMatrix<float>(2, 3) * DynamicMatrix<float>(2, 3), std::invalid_argument);
+    ASSERT_THROW(DynamicMatrix<float>(2, 3) * std::vector<float>(2), std::invalid_argument);
+
+    // Empty products
+    auto const empty = DynamicMatrix<float>(4, 0) * DynamicMatrix<float>(0, 5);
+    ASSERT_EQ(empty.getNumberOfRows(), 4);
+    ASSERT_EQ(empty.getNumberOfColumns(), 5);
+    ASSERT_EQ(empty(3, 4), 0);
+}
+
+TEST(DynamicMatrix, ParallelProduct) {
+    testProduct<float>(300, 300, 500, Execution::Parallel);
+    testProduct<double>(129, 513, 401, Execution::Parallel);
+}
+
+TEST(DynamicMatrix, Transpose) {
+    std::mt19937 generator(1);
+    auto const m = randomMatrix<double>(45, 70, generator);
+    auto const transpose = m.transpose();
+    ASSERT_EQ(transpose.getNumberOfRows(), 70);
+    ASSERT_EQ(transpose.getNumberOfColumns(), 45);
+    for (unsigned row = 0; row < 45; ++row) {
+        for (unsigned col = 0; col < 70; ++col) {
+            ASSERT_EQ(transpose(col, row), m(row, col));
+        }
+    }
+}
+
+TEST(DynamicMatrix, ElementWiseArithmetic) {
+    DynamicMatrix<int> const a{{1, 2}, {3, 4}};
+    DynamicMatrix<int> const b{{5, 6}, {7, 8}};
+    auto const sum = a + b;
+    auto const difference = b - a;
+    auto const scaled = 2 * a;
+    for (unsigned row = 0; row < 2; ++row) {
+        for (unsigned col = 0; col < 2; ++col) {
+            ASSERT_EQ(sum(row, col), a(row, col) + b(row, col));
+            ASSERT_EQ(difference(row, col), 4);
+            ASSERT_EQ(scaled(row, col), 2 * a(row, col));
+        }
+    }
+    ASSERT_THROW(a + DynamicMatrix<int>(2, 3), std::invalid_argument);
+}
@@ -0,0 +1,173 @@
+#include "gtest/gtest.h"
+#include "3dmath/IterativeSolvers.h"
+#include "3dmath/LinearSystem.h"
+#include <cmath>
+#include <random>
+#include <vector>
+using namespace math3d;
+
+namespace {
+    types::Tris gridTriangles(unsigned const gridSize) {
+        types::Tris tris;
+        for (unsigned row = 0; row + 1 < gridSize; ++row) {
+            for (unsigned col = 0; col + 1 < gridSize; ++col) {
+                auto const vertex = row * gridSize + col;
+                tris.emplace_back(vertex, vertex + 1, vertex + gridSize + 1);
+                tris.emplace_back(vertex, vertex + gridSize + 1, vertex + gridSize);
+            }
+        }
+        return tris;
+    }
+
+    // I + t L, the system of an implicit smoothing step on a grid mesh
+    template<typename T>
+    SparseMatrix<T> smoothingSystem(unsigned const gridSize, T const t) {
+        auto const laplacian = buildGraphLaplacian<T>(gridSize * gridSize, gridTriangles(gridSize));
+        std::vector<typename SparseMatrix<T>::Element> elements;
+        for (unsigned row = 0; row < laplacian.getNumberOfRows(); ++row) {
+            elements.push_back({row, row, 1});
+            for (auto i = laplacian.getRowOffsets()[row]; i < laplacian.getRowOffsets()[row + 1]; ++i) {
+                elements.push_back({row, laplacian.getColumnIndices()[i], t * laplacian.getValues()[i]});
+            }
+        }
+        return {laplacian.getNumberOfRows(), laplacian.getNumberOfColumns(), elements};
+    }
+
+    template<typename T>
+    std::vector<T> randomVector(size_t const size, std::mt19937& generator) {
+        std::uniform_real_distribution<T> distribution(-1, 1);
+        std::vector<T> vector(size);
+        for (auto& element : vector) {
+            element = distribution(generator);
+        }
+        return vector;
+    }
+
+    template<typename T>
+    double relativeResidual(SparseMatrix<T> const& a, std::vector<T> const& b, std::vector<T> const& x) {
+        auto const product = a * x;
+        double residual = 0, normB = 0;
+        for (size_t i = 0; i < b.size(); ++i) {
+            residual += (b[i] - product[i]) * (b[i] - product[i]);
+            normB += b[i] * b[i];
+        }
+        return std::sqrt(residual / normB);
+    }
+}
+
+TEST(IterativeSolvers, ConjugateGradient) {
+    auto const a = smoothingSystem<double>(40, 10);
+    std::mt19937 generator(1);
+    auto const b = randomVector<double>(a.getNumberOfRows(), generator);
+
+    unsigned jacobiIterations = 0;
+    for (auto const preconditioner : {Preconditioner::None, Preconditioner::Jacobi,
+                                      Preconditioner::IncompleteCholesky}) {
+        std::vector<double> x(b.size());
+        auto const result = solveConjugateGradient(a, b, x, {.tolerance = 1e-10, .preconditioner = preconditioner});
+        ASSERT_TRUE(result.converged);
+        ASSERT_LE(result.relativeResidual, 1e-10);
+        ASSERT_LE(relativeResidual(a, b, x), 1e-9);
+        if (preconditioner == Preconditioner::Jacobi) {
+            jacobiIterations = result.iterations;
+        } else if (preconditioner == Preconditioner::IncompleteCholesky) {
+            ASSERT_LT(result.iterations, jacobiIterations);
+        }
+    }
+
+    // Starting from the solution takes no iterations
+    std::vector<double> x(b.size());
+    static_cast<void>(solveConjugateGradient(a, b, x, {.tolerance = 1e-12}));
+    auto const result = solveConjugateGradient(a, b, x, {.tolerance = 1e-6});
+    ASSERT_TRUE(result.converged);
+    ASSERT_EQ(result.iterations, 0);
+}
+
+TEST(IterativeSolvers, ParallelConjugateGradient) {
+    auto const a = smoothingSystem<double>(300, 1);
+    std::mt19937 generator(2);
+    auto const b = randomVector<double>(a.getNumberOfRows(), generator);
+    std::vector<double> sequential(b.size()), parallel(b.size());
+    auto const sequentialResult = solveConjugateGradient(a, b, sequential);
+    auto const parallelResult = solveConjugateGradient(a, b, parallel, {.execution = Execution::Parallel});
+    ASSERT_TRUE(parallelResult.converged);
+    ASSERT_EQ(parallelResult.iterations, sequentialResult.iterations);
+    ASSERT_LE(relativeResidual(a, b, parallel), 1e-7);
+}
+
+TEST(IterativeSolvers, SinglePrecision) {
+    auto const a = smoothingSystem<float>(30, 5);
+    std::mt19937 generator(3);
+    auto const b = randomVector<float>(a.getNumberOfRows(), generator);
+    std::vector<float> x(b.size());
+    auto const result = solveConjugateGradient(a, b, x, {.tolerance = 1e-5,
+                                                         .preconditioner = Preconditioner::IncompleteCholesky});
+    ASSERT_TRUE(result.converged);
+    ASSERT_LE(relativeResidual(a, b, x), 1e-4);
+}
+
+TEST(IterativeSolvers, BiconjugateGradientStabilized) {
+    // Convection-diffusion on a line: the convection term makes the system non-symmetric
+    constexpr unsigned size = 2000;
+    std::vector<SparseMatrix<double>::Element> elements;
+    for (unsigned i = 0; i < size; ++i) {
+        elements.push_back({i, i, 2.5});
+        if (i > 0) elements.push_back({i, i - 1, -1.5});
+        if (i + 1 < size) elements.push_back({i, i + 1, -0.5});
+    }
+    SparseMatrix<double> const a(size, size, elements);
+    std::mt19937 generator(4);
+    auto const b = randomVector<double>(size, generator);
+
+    for (auto const preconditioner : {Preconditioner::None, Preconditioner::Jacobi}) {
+        std::vector<double> x(size);
+        auto const result = solveBiconjugateGradientStabilized(a, b, x, {.tolerance = 1e-10,
+                                                                         .preconditioner = preconditioner});
+        ASSERT_TRUE(result.converged);
+        ASSERT_LE(relativeResidual(a, b, x), 1e-9);
+    }
+
+    std::vector<double> x(size);
+    ASSERT_THROW(static_cast<void>(solveBiconjugateGradientStabilized(
+        a, b, x, {.preconditioner = Preconditioner::IncompleteCholesky})), std::invalid_argument);
+}
+
+TEST(IterativeSolvers, FixedSizeVectors) {
+    using Element = SparseMatrix<double>::Element;
+    SparseMatrix<double> const a(3, 3, std::vector<Element>{{0, 0, 4}, {0, 1, 1}, {1, 0, 1}, {1, 1, 3},
+                                                            {1, 2, 1}, {2, 1, 1}, {2, 2, 2}});
+    Vector<double, 3> const b{1, 2, 3};
+    Matrix<double, 3, 3> const dense{{4, 1, 0}, {1, 3, 1}, {0, 1, 2}};
+    auto const expected = LinearSystem<double, 3>::solveLinearSystem(dense, b);
+
+    Vector<double, 3> x;
+    ASSERT_TRUE(solveConjugateGradient(a, b, x, {.tolerance = 1e-12}).converged);
+    Vector<double, 3> y;
+    ASSERT_TRUE(solveBiconjugateGradientStabilized(a, b, y, {.tolerance = 1e-12}).converged);
+    for (unsigned i = 0; i < 3; ++i) {
+        ASSERT_NEAR(x[i], expected[i], 1e-10);
+        ASSERT_NEAR(y[i], expected[i], 1e-10);
+    }
+}
+
+TEST(IterativeSolvers, Errors) {
+    auto const a = smoothingSystem<double>(4, 1);
+    std::vector<double> b(16, 1), x(15);
+    ASSERT_THROW(static_cast<void>(solveConjugateGradient(a, b, x)), std::invalid_argument);
+
+    // Zero right-hand side gives the zero solution
+    std::vector<double> const zero(16);
+    std::vector<double> solution(16, 1);
+    auto const result = solveConjugateGradient(a, zero, solution);
+    ASSERT_TRUE(result.converged);
+    ASSERT_EQ(solution, zero);
+
+    // Indefinite matrices break the incomplete Cholesky factorization, and zero diagonals break Jacobi
+    using Element = SparseMatrix<double>::Element;
+    SparseMatrix<double> const indefinite(2, 2, std::vector<Element>{{0, 0, 1}, {0, 1, 2}, {1, 0, 2}, {1, 1, 1}});
+    std::vector<double> b2{1, 1}, x2(2);
+    ASSERT_THROW(static_cast<void>(solveConjugateGradient(indefinite, b2, x2,
+                                   {.preconditioner = Preconditioner::IncompleteCholesky})), std::runtime_error);
+    SparseMatrix<double> const zeroDiagonal(2, 2, std::vector<Element>{{0, 1, 1}, {1, 0, 1}});
+    ASSERT_THROW(static_cast<void>(solveConjugateGradient(zeroDiagonal, b2, x2)), std::runtime_error);
+}
@@ -0,0 +1,132 @@
+#include "gtest/gtest.h"
+#include "3dmath/LUDecomposition.h"
+#include "3dmath/LinearSystem.h"
+#include "3dmath/MatrixOperations.h"
+#include "TestSupport.h"
+#include <random>
+#include <vector>
+using namespace math3d;
+
+TEST(LUDecomposition, Factors) {
+    std::mt19937 generator(1);
+    auto const a = test::TestSupport::randomMatrix<double, 6>(generator);
+    LUDecomposition<double, 6> const lu(a);
+    ASSERT_FALSE(lu.isSingular());
+
+    // PA = LU
+    auto const product = lu.getLower() * lu.getUpper();
+    auto const& permutation = lu.getPermutation();
+    for (unsigned row = 0; row < 6; ++row) {
+        for (unsigned col = 0; col < 6; ++col) {
+            ASSERT_NEAR(product(row, col), a(permutation[row], col), 1e-12);
+            if (col > row) {
+                ASSERT_EQ(lu.getLower()(row, col), 0);
+            }
+            if (col < row) {
+                ASSERT_EQ(lu.getUpper()(row, col), 0);
+            }
+        }
+        // Partial pivoting keeps multipliers at most one in magnitude
+        for (unsigned col = 0; col < row; ++col) {
+            ASSERT_LE(std::fabs(lu.getLower()(row, col)), 1);
+        }
+    }
+}
+
+TEST(LUDecomposition, Solve) {
+    Matrix<float, 3, 3> const a {
+        {0.4165,   0.9501,   0.1960},
+        {0.2203,   0.4414,   0.6924},
+        {0.9187,   0.4295,   0.6804}
+    };
+    auto const x = LUDecomposition<float, 3>(a).solve(Vector<float, 3>{0.151307, 0.073879, 0.788695});
+    ASSERT_NEAR(x[0], +1.01808, 1e-4);
+    ASSERT_NEAR(x[1], -0.278914, 1e-4);
+    ASSERT_NEAR(x[2], -0.0394141, 1e-4);
+
+    // Matches Gaussian elimination
+    std::mt19937 generator(2);
+    auto const b = test::TestSupport::randomMatrix<double, 8>(generator);
+    LUDecomposition<double, 8> const lu(b);
+    for (unsigned i = 0; i < 10; ++i) {
+        auto const rightHandSide = test::TestSupport::randomVector<double, 8>(generator);
+        auto const solution = lu.solve(rightHandSide);
+        auto const expected = LinearSystem<double, 8>::solveLinearSystem(b, rightHandSide);
+        for (unsigned row = 0; row < 8; ++row) {
+            ASSERT_NEAR(solution[row], expected[row], 1e-9);
+        }
+    }
+}
+
+TEST(LUDecomposition, SolveMany) {
+    std::mt19937 generator(3);
+    auto const a = test::TestSupport::randomMatrix<double, 5>(generator);
+    LUDecomposition<double, 5> const lu(a);
+
+    // Columns of a right-hand side matrix
+    auto const rightHandSideMatrix = Matrix<double, 5, 3>{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}, {1, 0, 1}, {0, 1, 0}};
+    auto const solutionMatrix = lu.solve(rightHandSideMatrix);
+    auto const reconstructed = a * solutionMatrix;
+    for (unsigned row = 0; row < 5; ++row) {
+        for (unsigned col = 0; col < 3; ++col) {
+            ASSERT_NEAR(reconstructed(row, col), rightHandSideMatrix(row, col), 1e-12);
+        }
+    }
+
+    // Arrays of right-hand sides, solved in sequence, on threads and in place
+    std::vector<Vector<double, 5>> rightHandSides(100'000);
+    for (auto& rightHandSide : rightHandSides) {
+        rightHandSide = test::TestSupport::randomVector<double, 5>(generator);
+    }
+    std::vector<Vector<double, 5>> solutions(rightHandSides.size());
+    lu.solve(rightHandSides, solutions);
+    std::vector<Vector<double, 5>> parallelSolutions(rightHandSides.size());
+    lu.solve(rightHandSides, parallelSolutions, Execution::Parallel);
+    auto inPlaceSolutions = rightHandSides;
+    lu.solve(inPlaceSolutions, inPlaceSolutions);
+    for (size_t i = 0; i < rightHandSides.size(); i += 997) {
+        auto const expected = lu.solve(rightHandSides[i]);
+        for (unsigned row = 0; row < 5; ++row) {
+            ASSERT_EQ(solutions[i][row], expected[row]);
+            ASSERT_EQ(parallelSolutions[i][row], expected[row]);
+            ASSERT_EQ(inPlaceSolutions[i][row], expected[row]);
+        }
+    }
+    ASSERT_THROW(lu.solve(rightHandSides, std::span(solutions).first(10)), std::invalid_argument);
+}
+
+TEST(LUDecomposition, DeterminantAndInverse) {
+    std::mt19937 generator(4);
+    auto const a = test::TestSupport::randomMatrix<double, 4>(generator);
+    LUDecomposition<double, 4> const lu(a);
+    ASSERT_NEAR(lu.determinant(), a.determinant(), 1e-9 * std::fabs(a.determinant()));
+    auto const inverse = lu.inverse();
+    auto const expected = a.inverse();
+    for (unsigned i = 0; i < 16; ++i) {
+        ASSERT_NEAR(inverse.getData()[i], expected.getData()[i], 1e-12);
+    }
+
+    // Sizes without closed-form expressions
+    auto const b = test::TestSupport::randomMatrix<double, 7>(generator);
+    LUDecomposition<double, 7> const lu7(b);
+    ASSERT_NEAR(lu7.determinant(), b.determinant(), 1e-9 * std::fabs(b.determinant()));
+    auto const identity = b * lu7.inverse();
+    for (unsigned row = 0; row < 7; ++row) {
+        for (unsigned col = 0; col < 7; ++col) {
+            ASSERT_NEAR(identity(row, col), row == col ? 1 : 0, 1e-12);
+        }
+    }
+}
+
+TEST(LUDecomposition, Singular) {
+    Matrix<double, 3, 3> const a {
+        {1, 2, 3},
+        {2, 4, 6},
+        {1, 0, 1}
+    };
+    LUDecomposition<double, 3> const lu(a);
+    ASSERT_TRUE(lu.isSingular());
+    ASSERT_NEAR(lu.determinant(), 0, 1e-12);
+    ASSERT_THROW(static_cast<void>(lu.solve(Vector<double, 3>{1, 2, 3})), std::runtime_error);
+    ASSERT_THROW(static_cast<void>(lu.inverse()), std::runtime_error);
+}
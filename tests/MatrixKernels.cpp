@@ -0,0 +1,84 @@
+#include "gtest/gtest.h"
+#include "3dmath/MatrixKernels.h"
+#include "3dmath/Matrix.h"
+#include <random>
+using namespace math3d;
+
+namespace {
+    template<typename T>
+    std::array<T, 16> randomElements(std::mt19937& generator) {
+        std::uniform_real_distribution<T> distribution(-100, 100);
+        std::array<T, 16> elements;
+        for (auto& element : elements) {
+            element = distribution(generator);
+        }
+        return elements;
+    }
+
+    template<typename T>
+    void testKernelsAgainstScalarReference() {
+        std::mt19937 generator(42);
+        for (auto trial = 0; trial < 100; ++trial) {
+            auto a = randomElements<T>(generator);
+            auto b = randomElements<T>(generator);
+            std::array<T, 16> expected{}, actual{};
+            kernels::multiply4x4Scalar(a.data(), b.data(), expected.data());
+            kernels::multiply4x4(a.data(), b.data(), actual.data());
+            for (auto i = 0u; i < 16; ++i) {
+                ASSERT_NEAR(expected[i], actual[i], std::abs(expected[i]) * 1e-5);
+            }
+            kernels::multiply4x4VectorScalar(a.data(), b.data(), expected.data());
+            kernels::multiply4x4Vector(a.data(), b.data(), actual.data());
+            for (auto i = 0u; i < 4; ++i) {
+                ASSERT_NEAR(expected[i], actual[i], std::abs(expected[i]) * 1e-5);
+            }
+        }
+    }
+}
+
+TEST(MatrixKernels, FloatProductsMatchScalarReference) {
+    testKernelsAgainstScalarReference<float>();
+}
+
+TEST(MatrixKernels, DoubleProductsMatchScalarReference) {
+    testKernelsAgainstScalarReference<double>();
+}
+
+TEST(MatrixKernels, MatrixProduct4x4) {
+    Matrix<double, 4, 4> m1 {
+        {1, 2, 3, 4},
+        {5, 6, 7, 8},
+        {9, 10, 11, 12},
+        {13, 14, 15, 16}
+    };
+    Matrix<double, 4, 4> m2 {
+        {2, 0, 0, 1},
+        {0, 2, 0, 2},
+        {0, 0, 2, 3},
+        {0, 0, 0, 1}
+    };
+    Matrix<double, 4, 4> expected {
+        {2, 4, 6, 18},
+        {10, 12, 14, 46},
+        {18, 20, 22, 74},
+        {26, 28, 30, 102}
+    };
+    auto result = m1 * m2;
+    for (auto row = 0u; row < 4; ++row) {
+        for (auto col = 0u; col < 4; ++col) {
+            ASSERT_DOUBLE_EQ(result(row, col), expected(row, col));
+        }
+    }
+
+    Matrix<float, 4, 4> m3 {
+        {1, 2, 3, 4},
+        {5, 6, 7, 8},
+        {9, 10, 11, 12},
+        {13, 14, 15, 16}
+    };
+    Vector4<float> v = m3 * Vector4<float>{1, 0, -1, 2};
+    ASSERT_FLOAT_EQ(v.x, 6);
+    ASSERT_FLOAT_EQ(v.y, 14);
+    ASSERT_FLOAT_EQ(v.z, 22);
+    ASSERT_FLOAT_EQ(v.w, 30);
+}
@@ -1,5 +1,10 @@
 #include "gtest/gtest.h"
 #include "3dmath/MatrixOperations.h"
+#include "3dmath/RotationMatrix.h"
+#include "3dmath/ScalingMatrix.h"
+#include "3dmath/TranslationMatrix.h"
+#include "TestSupport.h"
+#include <random>
 #include <vector>
 using namespace std;
 using namespace math3d;
@@ -67,7 +72,7 @@ TEST(MatrixOperations, DeterminantOfValidMatrices) {
                                     {-3.f, -1.f, 2.f},
                                     {1.f, 2.f, 4.f}};
     auto result = testMatrix.determinant();
-    ASSERT_TRUE(Utilities::areEqual(-17.000001f, result));
+    ASSERT_TRUE(Utilities::areEqual(-17.f, result));
 
     auto identityMatrix = IdentityMatrix<float, 3, 3>{};
     result = identityMatrix.determinant();
@@ -162,4 +167,116 @@ TEST(MatrixOperations, InverseOfMatrixWithZeroNonPivots) {
             ASSERT_NEAR(expectedVal, actualVal, 1e-6);
         }
     }
-}
\ No newline at end of file
+}
+namespace {
+    template<unsigned size>
+    void testClosedFormInverse(std::mt19937& generator) {
+        auto matrix = test::TestSupport::randomMatrix<double, size>(generator);
+        auto product = matrix * matrix.inverse();
+        for (auto row = 0u; row < size; ++row) {
+            for (auto col = 0u; col < size; ++col) {
+                ASSERT_NEAR(product(row, col), row == col ? 1 : 0, 1e-9);
+            }
+        }
+        auto another = test::TestSupport::randomMatrix<double, size>(generator);
+        auto productOfDeterminants = matrix.determinant() * another.determinant();
+        ASSERT_NEAR((matrix * another).determinant(), productOfDeterminants, 1e-9 * fabs(productOfDeterminants));
+    }
+}
+
+TEST(MatrixOperations, ClosedFormInverseAndDeterminant) {
+    std::mt19937 generator(1);
+    testClosedFormInverse<2>(generator);
+    testClosedFormInverse<3>(generator);
+    testClosedFormInverse<4>(generator);
+
+    // Singularity is detected independent of the scale of the matrix
+    Matrix<double, 3, 3> scaledDown {
+        {1e-3, 0, 0},
+        {0, 1e-3, 0},
+        {0, 0, 1e-3}
+    };
+    ASSERT_NEAR(scaledDown.inverse()(1, 1), 1e3, 1e-9);
+    Matrix<double, 4, 4> rankDeficient {
+        {1, 2, 3, 4},
+        {2, 4, 6, 8},
+        {0, 1, 0, 1},
+        {1, 0, 1, 0}
+    };
+    ASSERT_THROW(rankDeficient.inverse(), std::runtime_error);
+
+    constexpr Matrix<double, 2, 2> constant {
+        {4, 6},
+        {2, 4}
+    };
+    static_assert(constant.determinant() == 4);
+    static_assert(constant.inverse()(0, 1) == -1.5);
+}
+
+TEST(MatrixOperations, InverseOfWellConditionedTransforms) {
+    // Large translations and non-uniform scales make some elements much larger than others without making the
+    // matrix any closer to singular
+    Matrix<float, 4, 4> const translation {
+        {1, 0, 0, 100},
+        {0, 1, 0, 0},
+        {0, 0, 1, 0},
+        {0, 0, 0, 1}
+    };
+    auto const translationInverse = translation.inverse();
+    ASSERT_FLOAT_EQ(translationInverse(0, 3), -100);
+    ASSERT_FLOAT_EQ(translationInverse(0, 0), 1);
+
+    Matrix<float, 3, 3> const scale {
+        {1, 0, 0},
+        {0, 1, 0},
+        {0, 0, 1000}
+    };
+    ASSERT_FLOAT_EQ(scale.inverse()(2, 2), 1e-3f);
+
+    Vector3<double> axis {0, 1, 1};
+    Matrix<double, 4, 4> const camera =
+        TranslationMatrix<double>({-50, 20, -30}) * RotationMatrix<double>(axis.normalize(), 25);
+    auto const product = camera * camera.inverse();
+    for (auto row = 0u; row < 4; ++row) {
+        for (auto col = 0u; col < 4; ++col) {
+            ASSERT_NEAR(product(row, col), row == col ? 1 : 0, 1e-12);
+        }
+    }
+
+    // Columns that are nearly parallel are still detected, whatever their scale
+    Matrix<float, 3, 3> const nearlyParallel {
+        {1000, 1000, 0},
+        {0, 1e-5f, 0},
+        {0, 0, 1}
+    };
+    ASSERT_THROW(static_cast<void>(nearlyParallel.inverse()), std::runtime_error);
+}
+
+TEST(MatrixOperations, AffineAndRigidInverse) {
+    Vector3<double> axis {1, 2, 3};
+    auto rotation = RotationMatrix<double>(axis.normalize(), 40);
+    TranslationMatrix<double> translation({5, -6, 7});
+    ScalingMatrix<double> scaling(2, 3, 4);
+
+    Matrix<double, 4, 4> rigid = translation * rotation;
+    Matrix<double, 4, 4> affine = translation * rotation * scaling;
+    auto rigidInverse = rigid.rigidInverse();
+    auto affineInverse = affine.affineInverse();
+    auto expectedRigidInverse = rigid.inverse();
+    auto expectedAffineInverse = affine.inverse();
+    for (auto row = 0u; row < 4; ++row) {
+        for (auto col = 0u; col < 4; ++col) {
+            ASSERT_NEAR(rigidInverse(row, col), expectedRigidInverse(row, col), 1e-12);
+            ASSERT_NEAR(affineInverse(row, col), expectedAffineInverse(row, col), 1e-12);
+        }
+    }
+
+    auto inverseRotation = rotation.inverse();
+    auto inverseTranslation = translation.inverse();
+    Matrix<double, 4, 4> identity = inverseRotation * inverseTranslation * rigid;
+    for (auto row = 0u; row < 4; ++row) {
+        for (auto col = 0u; col < 4; ++col) {
+            ASSERT_NEAR(identity(row, col), row == col ? 1 : 0, 1e-12);
+        }
+    }
+}
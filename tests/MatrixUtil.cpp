@@ -0,0 +1,102 @@
+#include "gtest/gtest.h"
+#include "3dmath/MatrixUtil.h"
+#include "TestSupport.h"
+#include <fstream>
+#include <vector>
+using namespace math3d;
+
+namespace {
+    using Matrix2f = Matrix<float, 2, 2>;
+    using Matrix2i = Matrix<int, 2, 2>;
+    using Matrix2d = Matrix<double, 2, 2>;
+
+    void writeFile(std::filesystem::path const& file, std::string const& contents) {
+        std::ofstream ofs(file, std::ios::binary);
+        ofs << contents;
+    }
+}
+
+TEST(MatrixUtil, ReadFromFile) {
+    test::TemporaryFile const csvFile("MatrixUtilMatrix.csv");
+    test::TemporaryFile const textFile("MatrixUtilMatrix.txt");
+    writeFile(csvFile, "1,2,3\n"
+                       " -4.5 , +5e1, 6\r\n"
+                       "\n"
+                       "7,8,9");
+    Matrix<float, 3, 3> m;
+    Matrix<float, 3, 3>::readFromFile(csvFile, m);
+    std::vector<float> const expected{1, 2, 3, -4.5, 50, 6, 7, 8, 9};
+    for (unsigned row = 0; row < 3; ++row) {
+        for (unsigned col = 0; col < 3; ++col) {
+            ASSERT_FLOAT_EQ(m(row, col), expected[3 * row + col]);
+        }
+    }
+
+    // Other delimiters
+    writeFile(textFile, "1 2\n3 4\n");
+    Matrix2d m2;
+    Matrix2d::readFromFile(textFile, m2, ' ');
+    ASSERT_DOUBLE_EQ(m2(0, 1), 2);
+    ASSERT_DOUBLE_EQ(m2(1, 0), 3);
+
+    // Rows after the matrix are ignored
+    writeFile(csvFile, "1,2\n3,4\n5,6\n");
+    Matrix2f m3;
+    Matrix2f::readFromFile(csvFile, m3);
+    ASSERT_FLOAT_EQ(m3(1, 1), 4);
+}
+
+TEST(MatrixUtil, ReadFromMalformedFile) {
+    Matrix2f m;
+    ASSERT_THROW(Matrix2f::readFromFile("Missing.csv", m), std::runtime_error);
+    test::TemporaryFile const file("MatrixUtilMalformed.csv");
+    for (auto const* contents : {"1,2\n3\n", "1,2\n3,4,5\n", "1,2\n3,x\n", "1,2\n3;4\n", "1,2\n", ""}) {
+        writeFile(file, contents);
+        ASSERT_THROW(Matrix2f::readFromFile(file, m), std::runtime_error) << contents;
+    }
+}
+
+TEST(MatrixUtil, ReadAllFromFile) {
+    test::TemporaryFile const file("MatrixUtilMatrices.csv");
+    writeFile(file, "1,2\n3,4\n\n5,6\n7,8\n\n\n9,10\n11,12");
+    auto const matrices = Matrix2i::readAllFromFile(file);
+    ASSERT_EQ(matrices.size(), 3);
+    for (unsigned i = 0; i < 3; ++i) {
+        ASSERT_EQ(matrices[i](0, 0), 4 * i + 1);
+        ASSERT_EQ(matrices[i](0, 1), 4 * i + 2);
+        ASSERT_EQ(matrices[i](1, 0), 4 * i + 3);
+        ASSERT_EQ(matrices[i](1, 1), 4 * i + 4);
+    }
+
+    writeFile(file, "");
+    ASSERT_TRUE(Matrix2i::readAllFromFile(file).empty());
+
+    // The last matrix is missing a row
+    writeFile(file, "1,2\n3,4\n5,6\n");
+    ASSERT_THROW(Matrix2i::readAllFromFile(file), std::runtime_error);
+}
+
+TEST(MatrixUtil, BinaryFiles) {
+    std::vector<Matrix<double, 3, 2>> matrices(7);
+    for (unsigned i = 0; i < matrices.size(); ++i) {
+        for (unsigned row = 0; row < 3; ++row) {
+            for (unsigned col = 0; col < 2; ++col) {
+                matrices[i](row, col) = i * 0.1 + row - col * 2.5;
+            }
+        }
+    }
+    test::TemporaryFile const file("MatrixUtilMatrices.bin");
+    Matrix<double, 3, 2>::writeAllToBinaryFile(file, matrices);
+    auto const readMatrices = Matrix<double, 3, 2>::readAllFromBinaryFile(file);
+    ASSERT_EQ(readMatrices.size(), matrices.size());
+    for (unsigned i = 0; i < matrices.size(); ++i) {
+        for (unsigned row = 0; row < 3; ++row) {
+            for (unsigned col = 0; col < 2; ++col) {
+                ASSERT_EQ(readMatrices[i](row, col), matrices[i](row, col));
+            }
+        }
+    }
+
+    // The file doesn't hold a whole number of 2x2 matrices
+    ASSERT_THROW(Matrix2d::readAllFromBinaryFile(file), std::runtime_error);
+}
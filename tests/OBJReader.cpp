@@ -0,0 +1,107 @@
+#include "gtest/gtest.h"
+#include "3dmath/OBJReader.h"
+#include "3dmath/OBJWriter.h"
+#include "3dmath/primitives/Sphere.h"
+#include "TestSupport.h"
+#include <fstream>
+#include <random>
+using namespace math3d;
+using namespace math3d::types;
+
+namespace {
+    void writeFile(std::filesystem::path const& file, std::string const& contents) {
+        std::ofstream ofs(file, std::ios::binary);
+        ofs << contents;
+    }
+}
+
+TEST(OBJReader, Baseline) {
+    auto const baselinePath = std::filesystem::path(__FILE__).parent_path() / "baseline";
+    Sphere sphere({10, 10, 10}, 10, 16);
+    sphere.generateGeometry();
+    auto const mesh = readOBJ(baselinePath / "Sphere.obj");
+    ASSERT_EQ(mesh.tris, sphere.getTris());
+    ASSERT_EQ(mesh.vertices.size(), sphere.getVertices().size());
+    for (size_t i = 0; i < mesh.vertices.size(); ++i) {
+        for (unsigned axis = 0; axis < 3; ++axis) {
+            // The file has six significant digits
+            ASSERT_NEAR(mesh.vertices[i][axis], sphere.getVertices()[i][axis], 1e-4);
+        }
+    }
+
+    // Rays are line segments, which have no triangles
+    auto const ray = readOBJ(baselinePath / "Ray.obj");
+    ASSERT_EQ(ray.vertices.size(), 4);
+    ASSERT_TRUE(ray.tris.empty());
+}
+
+TEST(OBJReader, Statements) {
+    test::TemporaryFile const file("OBJReaderStatements.obj");
+    writeFile(file,
+              "# Comment\r\n"
+              "o quad\r\n"
+              "v 0 0 0\r\n"
+              "v +1.5 0 0 1\r\n"
+              "  v 1.5 2e0 0\r\n"
+              "v\t0 2 -0.25\r\n"
+              "vt 0.5 0.5\r\n"
+              "vn 0 0 1\r\n"
+              "s off\r\n"
+              "f 1/1/1 2/1/1 3/1/1 4/1/1\r\n"
+              "f -4//1 -2//1 -1//1\r\n"
+              "l 1 2");
+    auto const mesh = readOBJ(file);
+    ASSERT_EQ(mesh.vertices.size(), 4);
+    ASSERT_FLOAT_EQ(mesh.vertices[1].x, 1.5f);
+    ASSERT_FLOAT_EQ(mesh.vertices[2].y, 2.f);
+    ASSERT_FLOAT_EQ(mesh.vertices[3].z, -0.25f);
+    // The quad is split into a fan
+    ASSERT_EQ(mesh.tris, (Tris{{0, 1, 2}, {0, 2, 3}, {0, 2, 3}}));
+}
+
+TEST(OBJReader, InvalidFiles) {
+    test::TemporaryFile const file("OBJReaderInvalid.obj");
+    writeFile(file, "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 4\n");
+    ASSERT_THROW(readOBJ(file), std::runtime_error);
+    writeFile(file, "v 0 zero 0\n");
+    ASSERT_THROW(readOBJ(file), std::runtime_error);
+    writeFile(file, "v 0 0 0\nv 1 0 0\nv 0 1 0\nf 1 2 0\n");
+    ASSERT_THROW(readOBJ(file), std::runtime_error);
+}
+
+TEST(OBJReader, Parallel) {
+    // Enough lines to be split into several ranges, with negative indices that refer to vertices of other ranges
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<float> coordinate(-100, 100);
+    std::string contents;
+    unsigned numberOfVertices = 0;
+    for (unsigned i = 0; i < 20'000; ++i) {
+        for (unsigned vertex = 0; vertex < 3; ++vertex, ++numberOfVertices) {
+            contents += "v " + std::to_string(coordinate(generator)) + ' ' + std::to_string(coordinate(generator)) +
+                        ' ' + std::to_string(coordinate(generator)) + '\n';
+        }
+        contents += i % 2 ? "f -1 -2 -3\n" : "f " + std::to_string(numberOfVertices) + " 1 2\n";
+    }
+    test::TemporaryFile const file("OBJReaderParallel.obj");
+    writeFile(file, contents);
+    auto const sequential = readOBJ(file);
+    auto const parallel = readOBJ(file, Execution::Parallel);
+    ASSERT_EQ(sequential.vertices.size(), numberOfVertices);
+    ASSERT_EQ(sequential.tris.size(), 20'000);
+    ASSERT_EQ(sequential.tris.back(), (Tri{numberOfVertices - 1, numberOfVertices - 2, numberOfVertices - 3}));
+    ASSERT_EQ(sequential.tris, parallel.tris);
+    ASSERT_EQ(sequential.vertices.size(), parallel.vertices.size());
+    for (size_t i = 0; i < sequential.vertices.size(); ++i) {
+        for (unsigned axis = 0; axis < 3; ++axis) {
+            ASSERT_EQ(sequential.vertices[i][axis], parallel.vertices[i][axis]);
+        }
+    }
+
+    // Ranges on their own split the file wherever they like, so every line must be parsed exactly once
+    std::span<char const> const text(contents);
+    size_t numberOfParsedVertices = 0;
+    for (size_t begin = 0; begin < text.size(); begin += 1000) {
+        numberOfParsedVertices += obj::parseRange(text, begin, std::min(begin + 1000, text.size())).vertices.size();
+    }
+    ASSERT_EQ(numberOfParsedVertices, numberOfVertices);
+}
@@ -0,0 +1,119 @@
+#include "gtest/gtest.h"
+#include "3dmath/OBJWriter.h"
+#include "3dmath/primitives/Sphere.h"
+#include "TestSupport.h"
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <vector>
+using namespace math3d;
+using namespace math3d::types;
+
+namespace {
+    std::string readFile(std::filesystem::path const& file) {
+        std::ifstream ifs(file, std::ios::binary);
+        return {std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>()};
+    }
+
+    // Vertices whose coordinates span many orders of magnitude, so that both fixed and scientific notation are used
+    Vertices randomVertices(size_t const count) {
+        std::mt19937 generator(1);
+        std::uniform_real_distribution<float> mantissa(-10, 10);
+        std::uniform_int_distribution<int> exponent(-8, 8);
+        Vertices vertices(count);
+        for (auto& vertex : vertices) {
+            for (unsigned axis = 0; axis < 3; ++axis) {
+                vertex[axis] = mantissa(generator) * std::pow(10.f, static_cast<float>(exponent(generator)));
+            }
+        }
+        return vertices;
+    }
+}
+
+TEST(OBJWriter, MatchesStreamFormatting) {
+    auto const vertices = randomVertices(1000);
+    Tris const tris{{0, 1, 2}, {997, 998, 999}};
+    test::TemporaryFile const file("OBJWriterFormatting.obj");
+    {
+        OBJWriter writer(file);
+        writer.write(vertices, tris);
+    }
+    std::ostringstream expected;
+    for (auto const& vertex : vertices) {
+        expected << "v " << vertex.x << ' ' << vertex.y << ' ' << vertex.z << '\n';
+    }
+    expected << "f 1 2 3\nf 998 999 1000\n";
+    ASSERT_EQ(readFile(file), expected.str());
+}
+
+TEST(OBJWriter, Precision) {
+    auto const vertices = randomVertices(100);
+    test::TemporaryFile const file("OBJWriterPrecision.obj");
+    {
+        OBJWriter writer(file, OBJWriter::maximumPrecision);
+        writer.write(vertices, Tris{});
+    }
+    // Nine significant digits identify every single precision value
+    std::istringstream iss(readFile(file));
+    for (auto const& vertex : vertices) {
+        char v;
+        float x, y, z;
+        iss >> v >> x >> y >> z;
+        ASSERT_EQ(x, vertex.x);
+        ASSERT_EQ(y, vertex.y);
+        ASSERT_EQ(z, vertex.z);
+    }
+
+    {
+        OBJWriter writer(file, 3);
+        writer.write(Vertices{{1.23456f, -0.000123456f, 123456.f}}, Tris{});
+    }
+    ASSERT_EQ(readFile(file), "v 1.23 -0.000123 1.23e+05\n");
+
+    ASSERT_THROW(OBJWriter(file, 0), std::invalid_argument);
+    ASSERT_THROW(OBJWriter(file, OBJWriter::maximumPrecision + 1), std::invalid_argument);
+}
+
+TEST(OBJWriter, Meshes) {
+    // Faces of later meshes index their own vertices
+    Sphere sphere({1, 2, 3}, 4, 5);
+    test::TemporaryFile const file("OBJWriterMeshes.obj");
+    OBJWriter writer(file);
+    writer.write(Vertices{{0, 0, 0}, {1, 0, 0}}, std::span<std::array<unsigned, 2> const>{{{0, 1}}});
+    writer.write(sphere);
+    writer.close();
+    ASSERT_THROW(writer.write(sphere), std::runtime_error);
+
+    std::istringstream iss(readFile(file));
+    std::string line;
+    std::vector<std::string> faces;
+    while (std::getline(iss, line)) {
+        if (line.front() == 'f') faces.push_back(line);
+    }
+    ASSERT_EQ(faces.size(), 1 + sphere.getTris().size());
+    ASSERT_EQ(faces.front(), "f 1 2");
+    auto const& lastTri = sphere.getTris().back();
+    ASSERT_EQ(faces.back(), "f " + std::to_string(lastTri[0] + 3) + ' ' + std::to_string(lastTri[1] + 3) + ' ' +
+                            std::to_string(lastTri[2] + 3));
+}
+
+TEST(OBJWriter, Parallel) {
+    // Enough lines to be split across threads
+    auto const vertices = randomVertices(300'000);
+    Tris tris;
+    for (unsigned i = 0; i + 2 < vertices.size(); i += 3) {
+        tris.emplace_back(i, i + 1, i + 2);
+    }
+    test::TemporaryFile const sequentialFile("OBJWriterSequential.obj");
+    test::TemporaryFile const parallelFile("OBJWriterParallel.obj");
+    {
+        OBJWriter writer(sequentialFile);
+        writer.write(vertices, tris);
+    }
+    {
+        OBJWriter writer(parallelFile, OBJWriter::defaultPrecision, Execution::Parallel);
+        writer.write(vertices, tris);
+    }
+    ASSERT_EQ(readFile(sequentialFile), readFile(parallelFile));
+}
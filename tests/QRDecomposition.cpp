@@ -0,0 +1,102 @@
+#include "gtest/gtest.h"
+#include "3dmath/QRDecomposition.h"
+#include "3dmath/LinearSystem.h"
+#include "3dmath/MatrixOperations.h"
+#include "TestSupport.h"
+#include <random>
+using namespace math3d;
+
+namespace {
+    template<typename T, unsigned numRows, unsigned numCols>
+    void testFactors(T const tolerance) {
+        std::mt19937 generator(numRows * numCols);
+        auto const a = test::TestSupport::randomMatrix<T, numRows, numCols>(generator);
+        QRDecomposition<T, numRows, numCols> const qr(a);
+        ASSERT_TRUE(qr.isFullRank());
+        auto const q = qr.getQ();
+        auto const r = qr.getR();
+
+        // Q has orthonormal columns, R is upper triangular with a non-negative diagonal and A = QR
+        auto const gram = q.transpose() * q;
+        for (unsigned row = 0; row < numCols; ++row) {
+            for (unsigned col = 0; col < numCols; ++col) {
+                ASSERT_NEAR(gram(row, col), row == col ? 1 : 0, tolerance);
+                if (row > col) {
+                    ASSERT_EQ(r(row, col), 0);
+                }
+            }
+            ASSERT_GE(r(row, row), 0);
+        }
+        auto const product = q * r;
+        for (unsigned row = 0; row < numRows; ++row) {
+            for (unsigned col = 0; col < numCols; ++col) {
+                ASSERT_NEAR(product(row, col), a(row, col), 10 * tolerance);
+            }
+        }
+    }
+}
+
+TEST(QRDecomposition, Factors) {
+    testFactors<double, 3, 3>(1e-14);
+    testFactors<double, 8, 5>(1e-14);
+    testFactors<float, 4, 4>(1e-5f);
+    testFactors<float, 6, 1>(1e-5f);
+}
+
+TEST(QRDecomposition, OrthonormalizesColumnsInOrder) {
+    // A sheared basis. Gram-Schmidt keeps the direction of the first column and the plane of the first two
+    Matrix<double, 3, 3> const basis{{2, 1, 0.5}, {0, 1, 0.2}, {0, 0, 3}};
+    auto const q = QRDecomposition<double, 3, 3>(basis).getQ();
+    ASSERT_NEAR(q(0, 0), 1, 1e-15);
+    ASSERT_NEAR(q(1, 1), 1, 1e-15);
+    ASSERT_NEAR(q(2, 2), 1, 1e-15);
+}
+
+TEST(QRDecomposition, SolveSquareSystem) {
+    std::mt19937 generator(1);
+    auto const a = test::TestSupport::randomMatrix<double, 5, 5>(generator);
+    Vector<double, 5> const b{1, 2, 3, 4, 5};
+    auto const expected = LinearSystem<double, 5>::solveLinearSystem(a, b);
+    auto const solution = QRDecomposition<double, 5, 5>(a).solve(b);
+    for (unsigned i = 0; i < 5; ++i) {
+        ASSERT_NEAR(solution[i], expected[i], 1e-10);
+    }
+}
+
+TEST(QRDecomposition, LeastSquares) {
+    // Fit y = c0 + c1 x + c2 x^2 to noisy samples of a parabola. The fit must match the solution of the normal
+    // equations, which is accurate enough for a problem this well conditioned
+    constexpr unsigned numSamples = 9;
+    Matrix<double, numSamples, 3> a;
+    Vector<double, numSamples> b;
+    for (unsigned i = 0; i < numSamples; ++i) {
+        double const x = static_cast<double>(i) - 4;
+        a(i, 0) = 1;
+        a(i, 1) = x;
+        a(i, 2) = x * x;
+        b[i] = 2 - 3 * x + 0.5 * x * x + (i % 2 == 0 ? 0.1 : -0.1);
+    }
+    auto const solution = QRDecomposition<double, numSamples, 3>(a).solve(b);
+    auto const aTranspose = a.transpose();
+    auto const normalSolution = LinearSystem<double, 3>::solveLinearSystem(aTranspose * a, aTranspose * b);
+    for (unsigned i = 0; i < 3; ++i) {
+        ASSERT_NEAR(solution[i], normalSolution[i], 1e-10);
+    }
+    ASSERT_NEAR(solution[2], 0.5, 0.05);
+
+    // Noise-free samples are fit exactly
+    for (unsigned i = 0; i < numSamples; ++i) {
+        b[i] = 2 - 3 * a(i, 1) + 0.5 * a(i, 2);
+    }
+    auto const exact = QRDecomposition<double, numSamples, 3>(a).solve(b);
+    ASSERT_NEAR(exact[0], 2, 1e-12);
+    ASSERT_NEAR(exact[1], -3, 1e-12);
+    ASSERT_NEAR(exact[2], 0.5, 1e-12);
+}
+
+TEST(QRDecomposition, RankDeficient) {
+    Matrix<double, 4, 2> const a{{1, 2}, {2, 4}, {3, 6}, {4, 8}};
+    QRDecomposition<double, 4, 2> const qr(a);
+    ASSERT_FALSE(qr.isFullRank());
+    ASSERT_THROW(static_cast<void>(qr.solve(Vector<double, 4>{1, 2, 3, 4})), std::runtime_error);
+}
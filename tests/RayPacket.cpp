@@ -0,0 +1,170 @@
+#include "gtest/gtest.h"
+#include "3dmath/primitives/RayPacket.h"
+#include "3dmath/primitives/Sphere.h"
+#include "3dmath/primitives/Triangle.h"
+#include <array>
+#include <random>
+#include <vector>
+using namespace math3d;
+using namespace math3d::types;
+
+namespace {
+    // Rays from random points in a 20x20x20 box towards random points in a smaller box, so that a good share of
+    // them hit primitives near the center
+    std::vector<Ray> randomRays(std::mt19937& generator, unsigned const count) {
+        std::uniform_real_distribution<double> origin(-10, 10);
+        std::uniform_real_distribution<double> target(-3, 3);
+        std::vector<Ray> rays;
+        rays.reserve(count);
+        for (unsigned i = 0; i < count; ++i) {
+            Point3D const from{origin(generator), origin(generator), origin(generator)};
+            Point3D const to{target(generator), target(generator), target(generator)};
+            rays.emplace_back(from, to - from);
+        }
+        return rays;
+    }
+
+    // Packets are intersected in single precision, so points far from the origin are less accurate
+    void expectSamePoint(Vector3<float> const& actual, Point3D const& expected, unsigned const lane) {
+        for (unsigned i = 0; i < 3; ++i) {
+            ASSERT_NEAR(actual[i], expected[i], 1e-4 * std::max(10., std::abs(expected[i]))) << "Lane " << lane;
+        }
+    }
+
+    // Intersect packets of N rays and compare each lane with expected(ray), which returns the single ray result
+    template<unsigned N, typename Intersect, typename Expected>
+    void testPackets(Intersect&& intersect, Expected&& expected) {
+        std::mt19937 generator(N);
+        auto const rays = randomRays(generator, 100 * N);
+        unsigned numberOfHits = 0;
+        for (size_t first = 0; first < rays.size(); first += N) {
+            RayPacket<N> const packet(std::span<Ray const>(rays).subspan(first, N));
+            auto const result = intersect(packet);
+            for (unsigned lane = 0; lane < N; ++lane) {
+                auto const& ray = rays[first + lane];
+                IntersectionResult const reference = expected(ray);
+                ASSERT_EQ(result.intersects(lane), reference.status == IntersectionStatus::Intersects)
+                    << "Ray " << ray;
+                if (!result.intersects(lane)) continue;
+                ++numberOfHits;
+                // Rays that graze a plane hit it far away, where single precision can't match the reference
+                if ((reference.intersectionPoint - ray.getOrigin()).length() > 100) continue;
+                expectSamePoint(result.getIntersectionPoint(lane), reference.intersectionPoint, lane);
+                auto const alongRay = packet.getOrigin(lane) + result.distance[lane] * packet.getDirection(lane);
+                expectSamePoint(alongRay, reference.intersectionPoint, lane);
+            }
+        }
+        ASSERT_GT(numberOfHits, 0);
+    }
+}
+
+TEST(RayPacket, Lanes) {
+    std::vector<Ray> const rays{Ray{{0, 0, 0}, {1, 0, 0}}, Ray{{1, 2, 3}, {0, 0, 2}}, Ray{{0, 0, 0}, {0, 1, 0}}};
+    RayPacket<4> packet(rays);
+    ASSERT_EQ(packet.getActiveMask(), 0b0111);
+    ASSERT_FLOAT_EQ(packet.getOrigin(1).y, 2);
+    // Directions are normalized by rays
+    ASSERT_FLOAT_EQ(packet.getDirection(1).z, 1);
+
+    packet.setRay(3, {0, 0, -5}, {0, 0, 1});
+    ASSERT_EQ(packet.getActiveMask(), 0b1111);
+    ASSERT_THROW(packet.setRay(4, {}, {}), std::invalid_argument);
+    ASSERT_THROW(RayPacket<2>{rays}, std::invalid_argument);
+}
+
+TEST(RayPacket, InactiveLanesDoNotHit) {
+    // A single ray that hits the sphere, in a packet whose other lanes are unassigned
+    RayPacket<8> packet;
+    packet.setRay(5, {0, 0, -10}, {0, 0, 1});
+    Sphere const sphere({0, 0, 0}, 1);
+    auto const result = sphere.intersectWithRays(packet);
+    ASSERT_EQ(result.hitMask, 1u << 5);
+    ASSERT_FLOAT_EQ(result.distance[5], 9);
+    ASSERT_FLOAT_EQ(result.getIntersectionPoint(5).z, -1);
+}
+
+TEST(RayPacket, Sphere) {
+    Sphere sphere({0.5, -0.5, 1}, 4);
+    auto const intersect = [&sphere](auto const& packet) { return sphere.intersectWithRays(packet); };
+    auto const expected = [&sphere](Ray const& ray) { return sphere.intersectWithRay(ray); };
+    testPackets<4>(intersect, expected);
+    testPackets<8>(intersect, expected);
+    // Widths without a vector register use portable code
+    testPackets<3>(intersect, expected);
+
+    // Rays from inside the sphere hit it where they exit
+    RayPacket<4> packet;
+    packet.setRay(0, {0.5, -0.5, 1}, {0, 1, 0});
+    auto const result = sphere.intersectWithRays(packet);
+    ASSERT_EQ(result.hitMask, 1);
+    ASSERT_NEAR(result.distance[0], 4, 1e-5);
+}
+
+TEST(RayPacket, Plane) {
+    Plane plane({1, 2, 3}, {1, 1, 2});
+    auto const intersect = [&plane](auto const& packet) { return plane.intersectWithRays(packet); };
+    auto const expected = [&plane](Ray const& ray) { return plane.intersectWithRay(ray); };
+    testPackets<4>(intersect, expected);
+    testPackets<8>(intersect, expected);
+
+    // Parallel rays miss the plane unless they start on it
+    RayPacket<4> packet;
+    packet.setRay(0, {0, 0, 0}, {1, -1, 0});
+    packet.setRay(1, {1, 2, 3}, {1, -1, 0});
+    ASSERT_EQ(plane.intersectWithRays(packet).hitMask, 0b10);
+}
+
+TEST(RayPacket, Triangle) {
+    Triangle triangle({-3, -2, 0}, {3, -2, 1}, {0, 3, -1});
+    auto const intersect = [&triangle](auto const& packet) { return triangle.intersectWithRays(packet); };
+    auto const expected = [&triangle](Ray const& ray) { return triangle.intersectWithRay(ray); };
+    testPackets<4>(intersect, expected);
+    testPackets<8>(intersect, expected);
+
+    // Packets use the same scale independent parallel ray test as single rays, so a triangle with legs of 1e-4 is
+    // hit by unit and short rays through its interior and missed by rays parallel to it
+    Triangle const small({0, 0, 1}, {1e-4, 0, 1}, {0, 1e-4, 1});
+    std::array<Point3D, 4> const origins{{{2.5e-5, 2.5e-5, 0}, {2.5e-5, 2.5e-5, 0}, {2.5e-5, -1e-4, 1},
+                                          {1e-4, 1e-4, 0}}};
+    std::array<Vector3D, 4> const directions{{{0, 0, 1}, {0, 0, 1e-3}, {0, 1, 0}, {0, 0, 1}}};
+    RayPacket<4> packet;
+    for (unsigned lane = 0; lane < 4; ++lane) {
+        packet.setRay(lane, Utilities::asFloat(origins[lane]), Utilities::asFloat(directions[lane]));
+    }
+    auto const result = small.intersectWithRays(packet);
+    for (unsigned lane = 0; lane < 4; ++lane) {
+        ASSERT_EQ(result.intersects(lane), small.getRayHit(origins[lane], directions[lane]).has_value())
+            << "Lane " << lane;
+    }
+    ASSERT_EQ(result.hitMask, 0b0011);
+}
+
+TEST(RayPacket, Bounds) {
+    Bounds3D<float> const bounds{{-1, -2, 0}, {2, 1, 3}};
+    auto const intersect = [&bounds](auto const& packet) { return bounds.intersectWithRays(packet); };
+    // Slab test in double precision
+    auto const expected = [&bounds](Ray const& ray) {
+        double nearest = 0, farthest = std::numeric_limits<double>::infinity();
+        for (unsigned axis = 0; axis < 3; ++axis) {
+            auto const extent = bounds.extent(static_cast<Bounds3D<float>::Direction>(axis));
+            auto const t0 = (extent.min - ray.getOrigin()[axis]) / ray.getDirection()[axis];
+            auto const t1 = (extent.max - ray.getOrigin()[axis]) / ray.getDirection()[axis];
+            nearest = std::max(nearest, std::min(t0, t1));
+            farthest = std::min(farthest, std::max(t0, t1));
+        }
+        IntersectionResult result{IntersectionStatus::NoIntersection, {}};
+        if (nearest <= farthest) {
+            result = {IntersectionStatus::Intersects, ray.getOrigin() + nearest * ray.getDirection()};
+        }
+        return result;
+    };
+    testPackets<4>(intersect, expected);
+    testPackets<8>(intersect, expected);
+
+    // Rays from inside the bounds hit them at their origin
+    RayPacket<4> packet;
+    packet.setRay(2, {0, 0, 1}, {1, 0, 0});
+    auto const result = bounds.intersectWithRays(packet);
+    ASSERT_EQ(result.hitMask, 0b100);
+    ASSERT_FLOAT_EQ(result.distance[2], 0);
+}
@@ -124,4 +124,42 @@ TEST(RotationMatrix, Concatenation) {
     cout << r2 << endl;
     r1 *= r2;
     cout << r1 << endl;
-}
\ No newline at end of file
+}
+TEST(RotationMatrix, CompileTimeRotation) {
+    // Axis swaps are exact when evaluated at compile time
+    constexpr auto rotateAboutZBy90 = RotationMatrix<double>::rotateAboutZ(90);
+    static_assert(rotateAboutZBy90(0, 0) == 0 && rotateAboutZBy90(0, 1) == -1 && rotateAboutZBy90(1, 0) == 1);
+    constexpr Matrix<double, 4, 4> halfTurn = rotateAboutZBy90 * rotateAboutZBy90;
+    static_assert(halfTurn(0, 0) == -1 && halfTurn(1, 1) == -1 && halfTurn(2, 2) == 1);
+
+    // Other angles match their runtime counterparts
+    constexpr auto compileTime = RotationMatrix<double>({1, 1, 0}, 37.5);
+    auto runtime = RotationMatrix<double>({1, 1, 0}, 37.5);
+    for (auto row = 0u; row < 4; ++row) {
+        for (auto col = 0u; col < 4; ++col) {
+            ASSERT_NEAR(compileTime(row, col), runtime(row, col), 1e-14);
+        }
+    }
+}
+
+TEST(RotationMatrix, Inverse) {
+    // The rotation axis isn't normalized, so a rotation about a non-unit axis isn't orthogonal and its inverse isn't
+    // its transpose. inverse() must not assume it is
+    auto const rotation = RotationMatrix<double>({1, 1, 0}, 37.5);
+    Matrix<double, 4, 4> const product = rotation * rotation.inverse();
+    for (auto row = 0u; row < 4; ++row) {
+        for (auto col = 0u; col < 4; ++col) {
+            ASSERT_NEAR(product(row, col), row == col ? 1 : 0, 1e-12);
+        }
+    }
+
+    // Rotations about unit axes can opt into the cheaper transpose
+    auto const unitAxisRotation = RotationMatrix<double>(Vector3<double>{1, 1, 0}.normalize(), 37.5);
+    auto const rigidInverse = unitAxisRotation.rigidInverse();
+    auto const expected = unitAxisRotation.inverse();
+    for (auto row = 0u; row < 4; ++row) {
+        for (auto col = 0u; col < 4; ++col) {
+            ASSERT_NEAR(rigidInverse(row, col), expected(row, col), 1e-12);
+        }
+    }
+}
@@ -0,0 +1,70 @@
+#include "gtest/gtest.h"
+#include "3dmath/STLReader.h"
+#include "3dmath/STLWriter.h"
+#include "3dmath/primitives/Sphere.h"
+#include "TestSupport.h"
+#include <fstream>
+using namespace math3d;
+using namespace math3d::types;
+
+namespace {
+    // Triangles of two meshes are the same if their corners are at the same positions
+    void expectSameTriangles(Mesh const& actual, Vertices const& expectedVertices, Tris const& expectedTris) {
+        ASSERT_EQ(actual.tris.size(), expectedTris.size());
+        for (size_t i = 0; i < expectedTris.size(); ++i) {
+            for (unsigned corner = 0; corner < 3; ++corner) {
+                auto const& actualVertex = actual.vertices.at(actual.tris[i][corner]);
+                auto const& expectedVertex = expectedVertices.at(expectedTris[i][corner]);
+                for (unsigned axis = 0; axis < 3; ++axis) {
+                    ASSERT_EQ(actualVertex[axis], expectedVertex[axis]) << "Triangle " << i;
+                }
+            }
+        }
+    }
+}
+
+TEST(STLReader, Baseline) {
+    auto const baselinePath = std::filesystem::path(__FILE__).parent_path() / "baseline";
+    Sphere sphere({10, 10, 10}, 10, 16);
+    sphere.generateGeometry();
+
+    // Welding recovers the shared vertices of the sphere
+    auto const welded = readSTL(baselinePath / "Sphere.stl");
+    ASSERT_EQ(welded.vertices.size(), sphere.getVertices().size());
+    expectSameTriangles(welded, sphere.getVertices(), sphere.getTris());
+
+    auto const unwelded = readSTL(baselinePath / "Sphere.stl", VertexWelding::None);
+    ASSERT_EQ(unwelded.vertices.size(), 3 * sphere.getTris().size());
+    expectSameTriangles(unwelded, sphere.getVertices(), sphere.getTris());
+}
+
+TEST(STLReader, WeldsSignedZeros) {
+    Vertices const vertices{{0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {-0.f, -0.f, 0}};
+    test::TemporaryFile const file("STLReaderSignedZeros.stl");
+    {
+        STLWriter writer(file);
+        writer.write(vertices, Tris{{0, 1, 2}, {3, 2, 1}});
+    }
+    auto const mesh = readSTL(file);
+    ASSERT_EQ(mesh.vertices.size(), 3);
+    ASSERT_EQ(mesh.tris[1][0], 0);
+}
+
+TEST(STLReader, InvalidFiles) {
+    test::TemporaryFile const invalidFile("STLReaderInvalid.stl");
+    {
+        std::ofstream ofs(invalidFile.getPath());
+        ofs << "solid ascii\nendsolid ascii\n";
+    }
+    ASSERT_THROW(readSTL(invalidFile), std::runtime_error);
+
+    // Fewer triangles than the header lists
+    test::TemporaryFile const truncatedFile("STLReaderTruncated.stl");
+    {
+        STLWriter writer(truncatedFile);
+        writer.write(Vertices{{0, 0, 0}, {1, 0, 0}, {0, 1, 0}}, Tris{{0, 1, 2}, {0, 2, 1}});
+    }
+    std::filesystem::resize_file(truncatedFile, std::filesystem::file_size(truncatedFile) - 1);
+    ASSERT_THROW(readSTL(truncatedFile), std::runtime_error);
+    ASSERT_THROW(readSTL("NoSuchFile.stl"), std::runtime_error);
+}
@@ -0,0 +1,102 @@
+#include "gtest/gtest.h"
+#include "3dmath/STLWriter.h"
+#include "3dmath/primitives/Plane.h"
+#include "3dmath/primitives/Sphere.h"
+#include "TestSupport.h"
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+using namespace math3d;
+using namespace math3d::types;
+
+namespace {
+    std::vector<char> readFile(std::filesystem::path const& file) {
+        std::ifstream ifs(file, std::ios::binary);
+        return {std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>()};
+    }
+
+    uint32_t getNumberOfTriangles(std::vector<char> const& contents) {
+        uint32_t numberOfTriangles;
+        std::memcpy(&numberOfTriangles, contents.data() + STLWriter::headerLength, sizeof(numberOfTriangles));
+        return numberOfTriangles;
+    }
+
+    // Normal and vertices of a triangle record
+    std::array<Vertex, 4> getRecord(std::vector<char> const& contents, size_t const triangle) {
+        std::array<float, 12> record;
+        auto const offset = STLWriter::headerLength + sizeof(uint32_t) + triangle * STLWriter::recordLength;
+        std::memcpy(record.data(), contents.data() + offset, sizeof(record));
+        std::array<Vertex, 4> result;
+        for (unsigned i = 0; i < 4; ++i) {
+            result[i] = {record[3 * i], record[3 * i + 1], record[3 * i + 2]};
+        }
+        return result;
+    }
+
+    // Check every record of a file against the triangles of meshes written into it one after the other
+    void expectRecords(std::vector<char> const& contents, std::vector<std::pair<Vertices, Tris>> const& meshes) {
+        size_t triangle = 0;
+        for (auto const& [vertices, tris] : meshes) {
+            for (auto const& tri : tris) {
+                auto const record = getRecord(contents, triangle++);
+                auto const& a = vertices[tri[0]];
+                auto const& b = vertices[tri[1]];
+                auto const& c = vertices[tri[2]];
+                Vertex const normal = (b - a) * (c - a);
+                std::array<Vertex, 4> const expected{normal, a, b, c};
+                for (unsigned i = 0; i < 4; ++i) {
+                    for (unsigned axis = 0; axis < 3; ++axis) {
+                        ASSERT_FLOAT_EQ(record[i][axis], expected[i][axis]) << "Triangle " << triangle - 1;
+                    }
+                }
+            }
+        }
+        ASSERT_EQ(getNumberOfTriangles(contents), triangle);
+        ASSERT_EQ(contents.size(), STLWriter::headerLength + sizeof(uint32_t) + triangle * STLWriter::recordLength);
+    }
+}
+
+TEST(STLWriter, Mesh) {
+    // Not a multiple of the group size of normal computation
+    Vertices const vertices{{0, 0, 0}, {1, 0, 0}, {0, 1, 0}, {0, 0, 1}, {1, 1, 1}};
+    Tris tris;
+    for (unsigned i = 0; i < 11; ++i) {
+        tris.emplace_back(i % 5, (i + 1) % 5, (i + 3) % 5);
+    }
+    test::TemporaryFile const file("STLWriterMesh.stl");
+    {
+        STLWriter writer(file, "Test mesh");
+        writer.write(vertices, tris);
+        ASSERT_EQ(writer.getNumberOfTriangles(), tris.size());
+    }
+    auto const contents = readFile(file);
+    ASSERT_STREQ(contents.data(), "Test mesh");
+    expectRecords(contents, {{vertices, tris}});
+}
+
+TEST(STLWriter, Primitives) {
+    // Geometry is generated for primitives that don't have it yet
+    Sphere sphere({1, 2, 3}, 4, 33);
+    Plane plane({0, 0, 0}, {0, 1, 1});
+    test::TemporaryFile const file("STLWriterPrimitives.stl");
+    STLWriter writer(file);
+    writer.write(sphere);
+    writer.write(plane);
+    writer.close();
+
+    auto const contents = readFile(file);
+    expectRecords(contents, {{sphere.getVertices(), sphere.getTris()}, {plane.getVertices(), plane.getTris()}});
+}
+
+TEST(STLWriter, Errors) {
+    test::TemporaryFile const file("STLWriterErrors.stl");
+    STLWriter writer(file);
+    Vertices const vertices{{0, 0, 0}, {1, 0, 0}, {0, 1, 0}};
+    Tris const tris{{0, 1, 3}};
+    ASSERT_THROW(writer.write(vertices, tris), std::out_of_range);
+    writer.close();
+    ASSERT_NO_THROW(writer.close());
+    ASSERT_THROW(writer.write(vertices, Tris{{0, 1, 2}}), std::runtime_error);
+    ASSERT_THROW(STLWriter("NoSuchDirectory/Errors.stl"), std::runtime_error);
+}
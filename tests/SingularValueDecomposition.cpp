@@ -0,0 +1,154 @@
+#include "gtest/gtest.h"
+#include "3dmath/SingularValueDecomposition.h"
+#include "3dmath/MatrixOperations.h"
+#include "3dmath/RotationMatrix.h"
+#include "TestSupport.h"
+#include <random>
+#include <vector>
+using namespace math3d;
+
+namespace {
+    template<typename T>
+    Matrix<T, 3, 3> rotation(Vector3<T> const& axis, T const degrees) {
+        Matrix<T, 4, 4> rotationMatrix = RotationMatrix<T>(axis.normalize(), degrees);
+        return rotationMatrix.template extract<3, 3>();
+    }
+
+    // U has orthonormal columns, V is orthogonal, singular values are non-negative and decreasing, and A = U S V^T
+    template<typename T, unsigned numRows, unsigned numCols>
+    void testDecomposition(Matrix<T, numRows, numCols> const& a, T const tolerance) {
+        SingularValueDecomposition<T, numRows, numCols> const svd(a);
+        auto const u = svd.getU();
+        auto const v = svd.getV();
+        auto const& singularValues = svd.getSingularValues();
+
+        auto const uGram = u.transpose() * u;
+        auto const vGram = v.transpose() * v;
+        for (unsigned row = 0; row < numCols; ++row) {
+            for (unsigned col = 0; col < numCols; ++col) {
+                ASSERT_NEAR(uGram(row, col), row == col ? 1 : 0, tolerance) << a;
+                ASSERT_NEAR(vGram(row, col), row == col ? 1 : 0, tolerance) << a;
+            }
+            ASSERT_GE(singularValues[row], 0);
+            if (row > 0) {
+                ASSERT_LE(singularValues[row], singularValues[row - 1]);
+            }
+        }
+
+        Matrix<T, numCols, numCols> s;
+        for (unsigned i = 0; i < numCols; ++i) {
+            s(i, i) = singularValues[i];
+        }
+        auto const product = u * s * v.transpose();
+        T const scale = std::max(singularValues[0], T{1});
+        for (unsigned row = 0; row < numRows; ++row) {
+            for (unsigned col = 0; col < numCols; ++col) {
+                ASSERT_NEAR(product(row, col), a(row, col), tolerance * scale) << a;
+            }
+        }
+    }
+}
+
+TEST(SingularValueDecomposition, Random3x3) {
+    std::mt19937 generator(1);
+    for (unsigned i = 0; i < 1000; ++i) {
+        testDecomposition(test::TestSupport::randomMatrix<float, 3, 3>(generator), 1e-5f);
+        testDecomposition(test::TestSupport::randomMatrix<double, 3, 3>(generator), 1e-13);
+    }
+}
+
+TEST(SingularValueDecomposition, OtherSizes) {
+    std::mt19937 generator(2);
+    testDecomposition(test::TestSupport::randomMatrix<double, 4, 4>(generator), 1e-13);
+    testDecomposition(test::TestSupport::randomMatrix<double, 6, 3>(generator), 1e-13);
+    testDecomposition(test::TestSupport::randomMatrix<double, 8, 8>(generator), 1e-12);
+    testDecomposition(test::TestSupport::randomMatrix<float, 5, 2>(generator), 1e-5f);
+    testDecomposition(test::TestSupport::randomMatrix<double, 2, 1>(generator), 1e-15);
+}
+
+TEST(SingularValueDecomposition, KnownSingularValues) {
+    // A rotation times a diagonal matrix times a rotation has the diagonal elements as its singular values
+    Matrix<double, 3, 3> const diagonal{{2, 0, 0}, {0, 7, 0}, {0, 0, 0.5}};
+    Matrix<double, 3, 3> const a = rotation<double>({1, 2, 3}, 40) * diagonal * rotation<double>({-1, 0, 2}, 75);
+    auto const& singularValues = SingularValueDecomposition<double, 3, 3>(a).getSingularValues();
+    ASSERT_NEAR(singularValues[0], 7, 1e-13);
+    ASSERT_NEAR(singularValues[1], 2, 1e-13);
+    ASSERT_NEAR(singularValues[2], 0.5, 1e-13);
+
+    Matrix<double, 4, 4> const diagonal4{{1, 0, 0, 0}, {0, -3, 0, 0}, {0, 0, 0, 0}, {0, 0, 0, 2}};
+    auto const& singularValues4 = SingularValueDecomposition<double, 4, 4>(diagonal4).getSingularValues();
+    ASSERT_EQ(singularValues4[0], 3);
+    ASSERT_EQ(singularValues4[1], 2);
+    ASSERT_EQ(singularValues4[2], 1);
+    ASSERT_EQ(singularValues4[3], 0);
+}
+
+TEST(SingularValueDecomposition, Singular) {
+    // Rank 2, rank 1 and zero matrices still have orthogonal U and V
+    testDecomposition(Matrix<double, 3, 3>{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}}, 1e-13);
+    testDecomposition(Matrix<double, 3, 3>{{1, 2, 3}, {2, 4, 6}, {-1, -2, -3}}, 1e-13);
+    testDecomposition(Matrix<float, 3, 3>{}, 1e-6f);
+    testDecomposition(Matrix<double, 4, 3>{{1, 2, 3}, {2, 4, 6}, {0, 0, 0}, {1, 2, 3}}, 1e-13);
+    testDecomposition(Matrix<double, 4, 4>{}, 1e-15);
+
+    SingularValueDecomposition<double, 3, 3> const svd(Matrix<double, 3, 3>{{1, 2, 3}, {4, 5, 6}, {7, 8, 9}});
+    ASSERT_EQ(svd.getRank(), 2);
+    ASSERT_EQ((SingularValueDecomposition<double, 4, 3>(Matrix<double, 4, 3>{{1, 2, 3}, {2, 4, 6}, {0, 0, 0},
+                                                                             {1, 2, 3}}).getRank()), 1);
+}
+
+TEST(SingularValueDecomposition, MinimumNormSolution) {
+    // x + y = 2 has the minimum length solution (1, 1)
+    Matrix<double, 2, 2> const a{{1, 1}, {1, 1}};
+    auto const solution = SingularValueDecomposition<double, 2, 2>(a).solve(Vector<double, 2>{2, 2});
+    ASSERT_NEAR(solution[0], 1, 1e-14);
+    ASSERT_NEAR(solution[1], 1, 1e-14);
+}
+
+TEST(SingularValueDecomposition, ClosestRotation) {
+    // A rotation that has drifted is orthonormalized back to it
+    auto const original = rotation<double>({2, -1, 1}, 33);
+    Matrix<double, 3, 3> drifted = original;
+    drifted(0, 1) += 1e-4;
+    drifted(2, 0) -= 2e-4;
+    auto const orthonormalized = SingularValueDecomposition<double, 3, 3>(drifted).getClosestRotation();
+    ASSERT_NEAR(orthonormalized.determinant(), 1, 1e-14);
+    for (unsigned row = 0; row < 3; ++row) {
+        for (unsigned col = 0; col < 3; ++col) {
+            ASSERT_NEAR(orthonormalized(row, col), original(row, col), 2e-4);
+        }
+    }
+
+    // Kabsch: the rotation that aligns a point set with its rotated copy is the closest rotation to their
+    // cross-covariance matrix, even if the points are coplanar
+    std::mt19937 generator(3);
+    std::uniform_real_distribution<float> distribution(-1, 1);
+    auto const expected = rotation<float>({0, 1, 1}, -120);
+    for (bool const coplanar : {false, true}) {
+        Matrix<float, 3, 3> covariance;
+        for (unsigned i = 0; i < 20; ++i) {
+            Vector3<float> const p{distribution(generator), distribution(generator),
+                                   coplanar ? 0.f : distribution(generator)};
+            Vector3<float> const q = expected * p;
+            for (unsigned row = 0; row < 3; ++row) {
+                for (unsigned col = 0; col < 3; ++col) {
+                    covariance(row, col) += q[row] * p[col];
+                }
+            }
+        }
+        auto const aligned = SingularValueDecomposition<float, 3, 3>(covariance).getClosestRotation();
+        for (unsigned row = 0; row < 3; ++row) {
+            for (unsigned col = 0; col < 3; ++col) {
+                ASSERT_NEAR(aligned(row, col), expected(row, col), 1e-5f) << coplanar;
+            }
+        }
+    }
+
+    // A reflection's closest rotation flips the direction of least stretch
+    Matrix<double, 3, 3> const reflection{{1, 0, 0}, {0, 2, 0}, {0, 0, -3}};
+    auto const closest = SingularValueDecomposition<double, 3, 3>(reflection).getClosestRotation();
+    ASSERT_NEAR(closest.determinant(), 1, 1e-14);
+    ASSERT_NEAR(closest(0, 0), -1, 1e-14);
+    ASSERT_NEAR(closest(1, 1), 1, 1e-14);
+    ASSERT_NEAR(closest(2, 2), -1, 1e-14);
+}
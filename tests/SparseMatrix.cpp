@@ -0,0 +1,123 @@
+#include "gtest/gtest.h"
+#include "3dmath/SparseMatrix.h"
+#include "3dmath/TypeAliases.h"
+#include <random>
+#include <vector>
+using namespace math3d;
+
+namespace {
+    // Triangulated grid of gridSize x gridSize vertices, two triangles per cell
+    types::Tris gridTriangles(unsigned const gridSize) {
+        types::Tris tris;
+        for (unsigned row = 0; row + 1 < gridSize; ++row) {
+            for (unsigned col = 0; col + 1 < gridSize; ++col) {
+                auto const vertex = row * gridSize + col;
+                tris.emplace_back(vertex, vertex + 1, vertex + gridSize + 1);
+                tris.emplace_back(vertex, vertex + gridSize + 1, vertex + gridSize);
+            }
+        }
+        return tris;
+    }
+}
+
+TEST(SparseMatrix, Assembly) {
+    using Element = SparseMatrix<double>::Element;
+    // Elements in any order, with two contributions to [1, 2]
+    std::vector<Element> const elements{{2, 0, 7}, {1, 2, 1}, {0, 0, 1}, {1, 2, 2}, {1, 0, 4}, {0, 3, 5}};
+    SparseMatrix<double> const m(3, 4, elements);
+    ASSERT_EQ(m.getNumberOfRows(), 3);
+    ASSERT_EQ(m.getNumberOfColumns(), 4);
+    ASSERT_EQ(m.getNumberOfNonZeros(), 5);
+
+    std::vector<size_t> const offsets{0, 2, 4, 5};
+    std::vector<unsigned> const columns{0, 3, 0, 2, 0};
+    std::vector<double> const values{1, 5, 4, 3, 7};
+    ASSERT_TRUE(std::ranges::equal(m.getRowOffsets(), offsets));
+    ASSERT_TRUE(std::ranges::equal(m.getColumnIndices(), columns));
+    ASSERT_TRUE(std::ranges::equal(m.getValues(), values));
+
+    ASSERT_EQ(m.at(1, 2), 3);
+    ASSERT_EQ(m.at(2, 3), 0);
+    ASSERT_THROW(static_cast<void>(m.at(3, 0)), std::out_of_range);
+    ASSERT_THROW((SparseMatrix<double>(2, 2, std::vector<Element>{{0, 2, 1}})), std::out_of_range);
+
+    auto const diagonal = m.getDiagonal();
+    ASSERT_EQ(diagonal.size(), 3);
+    ASSERT_EQ(diagonal[0], 1);
+    ASSERT_EQ(diagonal[1], 0);
+}
+
+TEST(SparseMatrix, CompressedArrays) {
+    SparseMatrix<float> const m(2, 3, {0, 1, 3}, {2, 0, 1}, {1, 2, 3});
+    ASSERT_EQ(m.at(0, 2), 1);
+    ASSERT_EQ(m.at(1, 1), 3);
+
+    // Offsets that don't end at the number of values, decreasing offsets, unsorted and out of range columns
+    ASSERT_THROW((SparseMatrix<float>(2, 3, {0, 1, 2}, {2, 0, 1}, {1, 2, 3})), std::invalid_argument);
+    ASSERT_THROW((SparseMatrix<float>(2, 3, {0, 2, 1}, {2}, {1})), std::invalid_argument);
+    ASSERT_THROW((SparseMatrix<float>(2, 3, {0, 1, 3}, {2, 1, 0}, {1, 2, 3})), std::invalid_argument);
+    ASSERT_THROW((SparseMatrix<float>(2, 3, {0, 1, 3}, {2, 0, 3}, {1, 2, 3})), std::invalid_argument);
+}
+
+TEST(SparseMatrix, Transpose) {
+    using Element = SparseMatrix<double>::Element;
+    SparseMatrix<double> const m(3, 4, std::vector<Element>{{0, 3, 1}, {1, 0, 2}, {1, 3, 3}, {2, 1, 4}});
+    auto const transpose = m.transpose();
+    ASSERT_EQ(transpose.getNumberOfRows(), 4);
+    ASSERT_EQ(transpose.getNumberOfColumns(), 3);
+    ASSERT_EQ(transpose.getNumberOfNonZeros(), 4);
+    for (unsigned row = 0; row < 3; ++row) {
+        for (unsigned col = 0; col < 4; ++col) {
+            ASSERT_EQ(transpose.at(col, row), m.at(row, col));
+        }
+    }
+}
+
+TEST(SparseMatrix, Product) {
+    std::mt19937 generator(1);
+    std::uniform_int_distribution<unsigned> position(0, 999);
+    std::uniform_int_distribution<int> value(-8, 8);
+    std::vector<SparseMatrix<double>::Element> elements;
+    for (unsigned i = 0; i < 8000; ++i) {
+        elements.push_back({position(generator), position(generator), static_cast<double>(value(generator))});
+    }
+    SparseMatrix<double> const m(1000, 1000, elements);
+    std::vector<double> x(1000);
+    for (auto& element : x) {
+        element = value(generator);
+    }
+
+    // Products of small integers are exact
+    std::vector<double> expected(1000);
+    for (auto const& element : elements) {
+        expected[element.row] += element.value * x[element.column];
+    }
+    ASSERT_EQ(m * x, expected);
+    std::vector<double> result(1000);
+    m.multiply(x, result, Execution::Parallel);
+    ASSERT_EQ(result, expected);
+
+    ASSERT_THROW(m.multiply(std::vector<double>(999), result), std::invalid_argument);
+}
+
+TEST(SparseMatrix, GraphLaplacian) {
+    constexpr unsigned gridSize = 5;
+    auto const laplacian = buildGraphLaplacian<double>(gridSize * gridSize, gridTriangles(gridSize));
+    // Corner (0, 0) has neighbors (0, 1), (1, 0) and (1, 1), and an interior vertex has six neighbors
+    ASSERT_EQ(laplacian.at(0, 0), 3);
+    ASSERT_EQ(laplacian.at(0, 1), -1);
+    ASSERT_EQ(laplacian.at(0, gridSize + 1), -1);
+    ASSERT_EQ(laplacian.at(0, 2), 0);
+    ASSERT_EQ(laplacian.at(12, 12), 6);
+    ASSERT_EQ(laplacian.getNumberOfNonZeros(), gridSize * gridSize + 2 * (2 * 4 * 5 + 4 * 4));
+
+    // Constants are in the null space
+    std::vector<double> const ones(gridSize * gridSize, 1);
+    for (auto const element : laplacian * ones) {
+        ASSERT_EQ(element, 0);
+    }
+    ASSERT_EQ(laplacian.transpose().getValues().size(), laplacian.getValues().size());
+    ASSERT_TRUE(std::ranges::equal(laplacian.transpose().getValues(), laplacian.getValues()));
+
+    ASSERT_THROW(buildGraphLaplacian<double>(3, types::Tris{{0, 1, 3}}), std::out_of_range);
+}
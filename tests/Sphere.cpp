@@ -64,6 +64,40 @@ TEST(Sphere, GeometryGenerationConnectivity) {
     }
 }
 
+TEST(Sphere, GeometryGenerationWinding) {
+    for (unsigned resolution : {3u, 4u, 7u, 16u, 33u}) {
+        Sphere sphere({1.f, -2.f, 3.f}, 5.f, resolution);
+        sphere.generateGeometry();
+        auto const& vertices = sphere.getVertices();
+        for (auto const& tri : sphere.getTris()) {
+            auto const& a = vertices.at(tri[0]);
+            auto normal = (vertices.at(tri[1]) - a) * (vertices.at(tri[2]) - a);
+            ASSERT_GT(normal.dot(a - Utilities::asFloat(sphere.getCenter())), 0)
+                << "Triangle normal points into the sphere at resolution " << resolution;
+        }
+    }
+}
+
+TEST(Sphere, GeometryGenerationSharesUnitSphere) {
+    // Spheres with the same resolution have the same triangles, and vertices that differ by their radius and center
+    Sphere small({0.f, 0.f, 0.f}, 1.f, 12);
+    Sphere large({10.f, 20.f, 30.f}, 4.f, 12);
+    small.generateGeometry();
+    large.generateGeometry();
+    ASSERT_EQ(small.getTris(), large.getTris());
+    ASSERT_EQ(small.getVertices().size(), large.getVertices().size());
+    for (size_t i = 0; i < small.getVertices().size(); ++i) {
+        auto const expected = 4.f * small.getVertices()[i] + Vertex{10.f, 20.f, 30.f};
+        for (unsigned j = 0; j < 3; ++j) {
+            ASSERT_NEAR(large.getVertices()[i][j], expected[j], 1e-5);
+        }
+    }
+
+    // Geometry isn't generated twice
+    large.generateGeometry();
+    ASSERT_EQ(large.getVertices().size(), small.getVertices().size());
+}
+
 TEST(Sphere, STLOutput) {
     auto baselinePath = std::filesystem::path(__FILE__).parent_path() / "baseline";
     Sphere {{10, 10, 10}, 10, 16}.writeToFile("Sphere.stl");
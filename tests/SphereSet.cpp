@@ -0,0 +1,164 @@
+#include "gtest/gtest.h"
+#include "3dmath/primitives/SphereSet.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+using namespace math3d;
+using namespace math3d::types;
+
+namespace {
+    // Spheres of radius [0.1, 1] in a 20x20x20 box. The count isn't a multiple of the group size so that the last
+    // group is partially filled
+    std::vector<Sphere> randomSpheres(std::mt19937& generator, unsigned const count = 203) {
+        std::uniform_real_distribution<float> center(-10, 10);
+        std::uniform_real_distribution<float> radius(0.1f, 1.f);
+        std::vector<Sphere> spheres;
+        spheres.reserve(count);
+        for (unsigned i = 0; i < count; ++i) {
+            spheres.emplace_back(Point3D{center(generator), center(generator), center(generator)}, radius(generator));
+        }
+        return spheres;
+    }
+
+    std::vector<Point3D> randomPoints(std::mt19937& generator, unsigned const count) {
+        std::uniform_real_distribution<double> coordinate(-10, 10);
+        std::vector<Point3D> points(count);
+        for (auto& point : points) {
+            point = {coordinate(generator), coordinate(generator), coordinate(generator)};
+        }
+        return points;
+    }
+
+    std::vector<Ray> randomRays(std::mt19937& generator, unsigned const count) {
+        auto const origins = randomPoints(generator, count);
+        auto const targets = randomPoints(generator, count);
+        std::vector<Ray> rays;
+        rays.reserve(count);
+        for (unsigned i = 0; i < count; ++i) {
+            rays.emplace_back(origins[i], targets[i] - origins[i]);
+        }
+        return rays;
+    }
+}
+
+TEST(SphereSet, Add) {
+    SphereSet set;
+    ASSERT_EQ(set.size(), 0);
+    ASSERT_EQ(set.add({1, 2, 3}, 4), 0);
+    ASSERT_EQ(set.add(Sphere({5, 6, 7}, 8)), 1);
+    ASSERT_EQ(set.size(), 2);
+    ASSERT_FLOAT_EQ(set.getCenter(1).y, 6);
+    ASSERT_FLOAT_EQ(set.getRadius(0), 4);
+    ASSERT_THROW(static_cast<void>(set.getRadius(2)), std::out_of_range);
+    ASSERT_THROW(set.add({0, 0, 0}, -1), std::invalid_argument);
+}
+
+TEST(SphereSet, ClosestHit) {
+    std::mt19937 generator(1);
+    auto spheres = randomSpheres(generator);
+    SphereSet const set(spheres);
+    unsigned numberOfHits = 0;
+    for (auto const& ray : randomRays(generator, 500)) {
+        // Closest hit of the individual spheres
+        std::optional<SphereSet::RayHit> expected;
+        for (size_t i = 0; i < spheres.size(); ++i) {
+            auto const result = spheres[i].intersectWithRay(ray);
+            if (result.status != IntersectionStatus::Intersects) continue;
+            auto const distance = static_cast<float>((result.intersectionPoint - ray.getOrigin()).length());
+            if (!expected || distance < expected->distance) {
+                expected = SphereSet::RayHit{i, distance};
+            }
+        }
+
+        auto const actual = set.getClosestHit(ray);
+        ASSERT_EQ(actual.has_value(), expected.has_value()) << "Ray " << ray;
+        if (!actual) continue;
+        ++numberOfHits;
+        // Distances are computed in single precision, and rays that graze a sphere magnify their errors
+        auto const tolerance = 1e-3 * std::max(1.f, expected->distance);
+        ASSERT_NEAR(actual->distance, expected->distance, tolerance) << "Ray " << ray;
+        // Spheres can overlap, so another sphere may be hit at the same distance
+        if (actual->sphere != expected->sphere) {
+            auto const result = spheres[actual->sphere].intersectWithRay(ray);
+            ASSERT_NEAR((result.intersectionPoint - ray.getOrigin()).length(), expected->distance, tolerance);
+        }
+    }
+    ASSERT_GT(numberOfHits, 0);
+
+    // Rays from inside a sphere hit it where they exit
+    auto const hit = SphereSet(std::vector{Sphere({0, 0, 0}, 2)}).getClosestHit(Ray{{0, 0, 0}, {1, 0, 0}});
+    ASSERT_TRUE(hit.has_value());
+    ASSERT_FLOAT_EQ(hit->distance, 2);
+    // Sets without spheres are never hit
+    ASSERT_FALSE(SphereSet().getClosestHit(Ray{{0, 0, 0}, {1, 0, 0}}).has_value());
+}
+
+TEST(SphereSet, ClosestHits) {
+    std::mt19937 generator(2);
+    auto const spheres = randomSpheres(generator);
+    SphereSet const set(spheres);
+    auto const rays = randomRays(generator, 1000);
+
+    std::vector<std::optional<SphereSet::RayHit>> sequentialHits(rays.size());
+    std::vector<std::optional<SphereSet::RayHit>> parallelHits(rays.size());
+    set.getClosestHits(rays, sequentialHits);
+    set.getClosestHits(rays, parallelHits, Execution::Parallel);
+    for (size_t i = 0; i < rays.size(); ++i) {
+        auto const expected = set.getClosestHit(rays[i]);
+        ASSERT_EQ(sequentialHits[i].has_value(), expected.has_value());
+        ASSERT_EQ(parallelHits[i].has_value(), expected.has_value());
+        if (expected) {
+            ASSERT_EQ(sequentialHits[i]->sphere, expected->sphere);
+            ASSERT_EQ(parallelHits[i]->sphere, expected->sphere);
+        }
+    }
+    ASSERT_THROW(set.getClosestHits(rays, std::span(sequentialHits).first(10)), std::invalid_argument);
+}
+
+TEST(SphereSet, ContainsPoint) {
+    std::mt19937 generator(3);
+    auto const spheres = randomSpheres(generator, 1000);
+    SphereSet const set(spheres);
+    unsigned numberOfContainedPoints = 0;
+    for (auto const& point : randomPoints(generator, 200)) {
+        std::vector<size_t> expected;
+        for (size_t i = 0; i < spheres.size(); ++i) {
+            if ((point - spheres[i].getCenter()).length() <= spheres[i].getRadius()) {
+                expected.push_back(i);
+            }
+        }
+        ASSERT_EQ(set.getSpheresContainingPoint(point), expected);
+        numberOfContainedPoints += !expected.empty();
+    }
+    ASSERT_GT(numberOfContainedPoints, 0);
+
+    // Points on the surface are contained
+    ASSERT_EQ(set.getSpheresContainingPoint(set.getCenter(7) + Vector3<float>{set.getRadius(7), 0, 0}).front(), 7);
+}
+
+TEST(SphereSet, OverlapsBounds) {
+    std::mt19937 generator(4);
+    auto const spheres = randomSpheres(generator, 1000);
+    SphereSet const set(spheres);
+    Bounds3D<float> const bounds{{-2, -1, 0}, {3, 1, 4}};
+    std::vector<size_t> expected;
+    for (size_t i = 0; i < spheres.size(); ++i) {
+        // Distance from the center to its closest point in the box
+        auto const center = spheres[i].getCenter();
+        Point3D const closestPoint{std::clamp<double>(center.x, bounds.x.min, bounds.x.max),
+                                   std::clamp<double>(center.y, bounds.y.min, bounds.y.max),
+                                   std::clamp<double>(center.z, bounds.z.min, bounds.z.max)};
+        if ((center - closestPoint).length() <= spheres[i].getRadius()) {
+            expected.push_back(i);
+        }
+    }
+    ASSERT_FALSE(expected.empty());
+    ASSERT_EQ(set.getSpheresOverlappingBounds(bounds), expected);
+
+    // Spheres that contain the box or touch it overlap it
+    SphereSet touching;
+    touching.add({0, 0, 0}, 100);
+    touching.add({5, 0, 2}, 2);
+    touching.add({5, 0, 2}, 1.9f);
+    ASSERT_EQ(touching.getSpheresOverlappingBounds(bounds), (std::vector<size_t>{0, 1}));
+}
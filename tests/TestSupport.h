@@ -4,17 +4,90 @@
 #include <exception>
 #include <filesystem>
 #include <memory>
+#include <random>
+#include <string>
+#include <system_error>
+#include <type_traits>
 #include "3dmath/Constants.h"
 #include "3dmath/Matrix.h"
+#include "3dmath/Vector.h"
 
 // TODO: Move to support directory
 
 namespace math3d::test {
 
+    // A file in the system's temporary directory that is removed when it goes out of scope, so that tests which write
+    // files leave nothing behind, even when an assertion fails. Names should be unique across tests, since test
+    // executables can run concurrently
+    class TemporaryFile {
+    public:
+        explicit TemporaryFile(std::string const& name)
+        : path(std::filesystem::temp_directory_path() / ("3dmathTest" + name)) {
+        }
+
+        ~TemporaryFile() {
+            std::error_code error;
+            std::filesystem::remove(path, error);
+        }
+
+        TemporaryFile(TemporaryFile const&) = delete;
+        TemporaryFile& operator=(TemporaryFile const&) = delete;
+
+        [[nodiscard]] std::filesystem::path const& getPath() const {
+            return path;
+        }
+
+        operator std::filesystem::path const&() const { // NOLINT: Implicit conversion is intended
+            return path;
+        }
+
+    private:
+        std::filesystem::path path;
+    };
+
     class TestSupport {
     public:
         static constexpr unsigned numberOfSamplesForRobustnessTest = 100;
 
+        // Random values are drawn uniformly from [min, max] with a generator that the caller seeds, so that every run,
+        // and every failure, sees the same values. Integer bounds give integer values, which keep sums and products
+        // of small matrices exact even when the elements are floating point
+        template<typename T>
+        static T randomValue(std::mt19937& generator, T const min, T const max) {
+            if constexpr (std::is_integral_v<T>) {
+                return std::uniform_int_distribution<T>(min, max)(generator);
+            } else {
+                return std::uniform_real_distribution<T>(min, max)(generator);
+            }
+        }
+
+        // Fill any matrix that has getNumberOfRows(), getNumberOfColumns() and operator()(row, col), row by row
+        template<typename MatrixType, typename T>
+        static void randomize(MatrixType& matrix, std::mt19937& generator, T const min, T const max) {
+            using ElementType = std::remove_cvref_t<decltype(matrix(0, 0))>;
+            for (unsigned row = 0; row < matrix.getNumberOfRows(); ++row) {
+                for (unsigned col = 0; col < matrix.getNumberOfColumns(); ++col) {
+                    matrix(row, col) = static_cast<ElementType>(randomValue(generator, min, max));
+                }
+            }
+        }
+
+        template<typename T, unsigned numRows, unsigned numCols = numRows>
+        static Matrix<T, numRows, numCols> randomMatrix(std::mt19937& generator, T const min = -10, T const max = 10) {
+            Matrix<T, numRows, numCols> matrix;
+            randomize(matrix, generator, min, max);
+            return matrix;
+        }
+
+        template<typename T, unsigned size>
+        static Vector<T, size> randomVector(std::mt19937& generator, T const min = -10, T const max = 10) {
+            Vector<T, size> vector;
+            for (unsigned i = 0; i < size; ++i) {
+                vector[i] = randomValue(generator, min, max);
+            }
+            return vector;
+        }
+
         static bool areFilesEqual(std::filesystem::path const& file1,
                                   std::filesystem::path const& file2) {
 
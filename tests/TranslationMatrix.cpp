@@ -27,4 +27,10 @@ TEST(TranslationMatrix, ConstructionWithTranslation) {
     ASSERT_FLOAT_EQ(lastColumn[1], 200.f);
     ASSERT_FLOAT_EQ(lastColumn[2], 300.f);
     ASSERT_FLOAT_EQ(lastColumn[3], 1.f);
-}
\ No newline at end of file
+}
+TEST(TranslationMatrix, ConstantExpressions) {
+    constexpr TranslationMatrix<float> translation(Vector3<float>{1, 2, 3});
+    constexpr Vector4<float> translated = translation * Vector4<float>{1, 1, 1, 1};
+    static_assert(translated[0] == 2 && translated[1] == 3 && translated[2] == 4 && translated[3] == 1);
+    ASSERT_FLOAT_EQ(translated.x, 2);
+}
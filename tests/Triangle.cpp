@@ -7,6 +7,7 @@
 #include <ranges>
 
 using namespace math3d;
+using math3d::types::Point3D;
 
 TEST(Triangle, CrossProductBasedArea) {
     Triangle tri { Utilities::RandomPoint{}, Utilities::RandomPoint{}, Utilities::RandomPoint{} };
@@ -42,4 +43,85 @@ TEST(Triangle, BaryCentricCoordinates) {
             return fabs(component) < math3d::constants::tolerance;
         }));
     }
-}
\ No newline at end of file
+}
+
+TEST(Triangle, BarycentricCoordinatesOfVertices) {
+    Triangle tri {{1, 0, 0}, {0, 2, 0}, {0, 0, 3}};
+    auto [a, b, c] = tri.getPoints();
+    auto const expectCoordinates = [&tri](Point3D const& point, Point3D const& expected) {
+        auto const actual = tri.getBarycentricCoordinates(point);
+        for (unsigned i = 0; i < 3; ++i) {
+            ASSERT_NEAR(actual[i], expected[i], constants::tolerance);
+        }
+    };
+    // Weights are in vertex order
+    expectCoordinates(a, {1, 0, 0});
+    expectCoordinates(b, {0, 1, 0});
+    expectCoordinates(c, {0, 0, 1});
+    expectCoordinates((a + b + c) / 3., {1. / 3, 1. / 3, 1. / 3});
+    // Points outside the triangle have negative weights
+    expectCoordinates(2. * b - a, {-1, 2, 0});
+}
+
+TEST(Triangle, BarycentricCoordinatesMatchAreaRatios) {
+    for (int i = 0; i < 10; ++i) {
+        Triangle tri { Utilities::RandomPoint{}, Utilities::RandomPoint{}, Utilities::RandomPoint{} };
+        auto [a, b, c] = tri.getPoints();
+        Point3D const point = 0.2 * a + 0.3 * b + 0.5 * c;
+        auto const barycentricCoordinates = tri.getBarycentricCoordinates(point);
+        // The weight of a vertex is the area of the triangle formed by the point and the opposite edge
+        auto const area = tri.getArea();
+        ASSERT_NEAR(barycentricCoordinates.x, Triangle(point, b, c).getArea() / area, 1e-6);
+        ASSERT_NEAR(barycentricCoordinates.y, Triangle(a, point, c).getArea() / area, 1e-6);
+        ASSERT_NEAR(barycentricCoordinates.z, Triangle(a, b, point).getArea() / area, 1e-6);
+    }
+}
+
+TEST(Triangle, RayHit) {
+    Triangle tri {{-1, -1, 5}, {1, -1, 5}, {0, 1, 5}};
+
+    auto const hit = tri.getRayHit({0, 0, 0}, {0, 0, 1});
+    ASSERT_TRUE(hit.has_value());
+    ASSERT_NEAR(hit->distance, 5, constants::tolerance);
+    auto [a, b, c] = tri.getPoints();
+    auto const& weights = hit->barycentricCoordinates;
+    Point3D const pointFromWeights = weights.x * a + weights.y * b + weights.z * c;
+    ASSERT_NEAR((pointFromWeights - Point3D{0, 0, 5}).length(), 0, constants::tolerance);
+
+    // Distances are in units of the direction's length
+    ASSERT_NEAR(tri.getRayHit({0, 0, 0}, {0, 0, 2})->distance, 2.5, constants::tolerance);
+    // Hits beyond the maximum distance and behind the ray origin don't count
+    ASSERT_FALSE(tri.getRayHit({0, 0, 0}, {0, 0, 1}, 4).has_value());
+    ASSERT_FALSE(tri.getRayHit({0, 0, 10}, {0, 0, 1}).has_value());
+    // Rays that hit the plane of the triangle outside its edges miss it
+    ASSERT_FALSE(tri.getRayHit({5, 0, 0}, {0, 0, 1}).has_value());
+    // Rays parallel to the triangle miss it
+    ASSERT_FALSE(tri.getRayHit({0, 0, 5}, {1, 0, 0}).has_value());
+}
+
+TEST(Triangle, RayHitIsScaleIndependent) {
+    // The parallel ray test is relative to the lengths of the edges and of the direction, so tiny and huge triangles
+    // are hit like unit ones
+    for (double const scale : {1e-6, 1e-4, 1., 1e4}) {
+        Triangle const tri {{0, 0, 1}, {scale, 0, 1}, {0, scale, 1}};
+        Point3D const interior {scale / 4, scale / 4, 0};
+        auto const hit = tri.getRayHit(interior, {0, 0, 1});
+        ASSERT_TRUE(hit.has_value()) << scale;
+        ASSERT_NEAR(hit->distance, 1, constants::tolerance) << scale;
+        ASSERT_NEAR(hit->barycentricCoordinates.y, 0.25, constants::tolerance) << scale;
+        ASSERT_TRUE(tri.getRayHit(interior, {0, 0, 1e-6}).has_value()) << scale;
+        ASSERT_FALSE(tri.getRayHit({scale / 4, -scale, 1}, {0, 1, 0}).has_value()) << scale;
+    }
+}
+
+TEST(Triangle, IntersectWithRay) {
+    Triangle tri {{-1, -1, 5}, {1, -1, 5}, {0, 1, 5}};
+    auto const result = tri.intersectWithRay(Ray{{0, 0, 0}, {0, 0, 1}});
+    ASSERT_EQ(result.status, IntersectionStatus::Intersects);
+    ASSERT_NEAR(result.intersectionPoint.z, 5, constants::tolerance);
+
+    // The plane of the triangle is hit, but the triangle isn't
+    Ray const missesTriangle{{5, 0, 0}, {0, 0, 1}};
+    ASSERT_EQ(static_cast<Plane&>(tri).Plane::intersectWithRay(missesTriangle).status, IntersectionStatus::Intersects);
+    ASSERT_EQ(tri.intersectWithRay(missesTriangle).status, IntersectionStatus::NoIntersection);
+}
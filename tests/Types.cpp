@@ -1,7 +1,9 @@
 #include "gtest/gtest.h"
 #include "3dmath/Vector.h"
 #include "3dmath/SupportingTypes.h"
+#include "3dmath/BoundsKernels.h"
 #include <vector>
+#include <random>
 using namespace std;
 using namespace math3d;
 
@@ -161,4 +163,97 @@ TEST(Bounds, Remap) {
     Remapper const remapper {boundsA, boundsB};
     ASSERT_TRUE(Utilities::areEqual(remapper({-10, -10, -10}), {-1, -1, -1}));
     ASSERT_TRUE(Utilities::areEqual(remapper({10, 10, 10}), {1, 1, 1}));
-}
\ No newline at end of file
+}
+
+namespace {
+    template<typename T>
+    vector<Vector3<T>> randomPoints(size_t const count) {
+        mt19937 generator(count);
+        uniform_real_distribution<T> distribution(-1000, 1000);
+        vector<Vector3<T>> points(count);
+        for (auto& point : points) {
+            point = {distribution(generator), distribution(generator), distribution(generator)};
+        }
+        return points;
+    }
+
+    template<typename T>
+    void assertBoundsEqual(Bounds3D<T> const& expected, Bounds3D<T> const& actual) {
+        ASSERT_EQ(expected.x.min, actual.x.min);
+        ASSERT_EQ(expected.x.max, actual.x.max);
+        ASSERT_EQ(expected.y.min, actual.y.min);
+        ASSERT_EQ(expected.y.max, actual.y.max);
+        ASSERT_EQ(expected.z.min, actual.z.min);
+        ASSERT_EQ(expected.z.max, actual.z.max);
+    }
+
+    template<typename T>
+    void testFromPoints(size_t const count, Execution const execution) {
+        auto const points = randomPoints<T>(count);
+        Bounds3D<T> expected;
+        for (auto const& point : points) {
+            expected.merge(point);
+        }
+        assertBoundsEqual(expected, Bounds3D<T>::fromPoints(points, execution));
+
+        vector<T> x, y, z;
+        for (auto const& point : points) {
+            x.push_back(point.x);
+            y.push_back(point.y);
+            z.push_back(point.z);
+        }
+        assertBoundsEqual(expected, Bounds3D<T>::fromPoints(CoordinateSpans<T const>{x, y, z}, execution));
+    }
+}
+
+TEST(Bounds3D, FromPoints) {
+    // Sizes that aren't multiples of the vector width exercise the scalar tail
+    for (size_t count : {1, 2, 3, 4, 5, 7, 8, 9, 1001}) {
+        testFromPoints<float>(count, Execution::Sequential);
+        testFromPoints<double>(count, Execution::Sequential);
+    }
+    ASSERT_FALSE(Bounds3D<float>::fromPoints(vector<Vector3<float>>{}).isValid());
+
+    vector<float> x(3), y(3), z(2);
+    ASSERT_THROW(static_cast<void>(Bounds3D<float>::fromPoints(CoordinateSpans<float const>{x, y, z})),
+                 std::invalid_argument);
+}
+
+TEST(Bounds3D, FromPointsInParallel) {
+    testFromPoints<float>(batch::minimumElementsPerThread * 3 + 5, Execution::Parallel);
+    testFromPoints<double>(batch::minimumElementsPerThread * 2 + 1, Execution::Parallel);
+}
+
+TEST(Bounds3D, Accumulator) {
+    auto const points = randomPoints<float>(100);
+    BoundsAccumulator<float> accumulator;
+    ASSERT_TRUE(accumulator.isEmpty());
+    ASSERT_FALSE(accumulator.getBounds().isValid());
+
+    // A single point or coplanar points are added but don't span a volume
+    accumulator.add(Vector3<float>{1, 2, 3});
+    ASSERT_FALSE(accumulator.isEmpty());
+    ASSERT_FALSE(accumulator.getBounds().isValid());
+    accumulator.add(Vector3<float>{4, 5, 3});
+    ASSERT_EQ(accumulator.getNumberOfPoints(), 2);
+    ASSERT_FALSE(accumulator.getBounds().isValid());
+    accumulator.reset();
+
+    // Add points one at a time and in blocks as a loader would
+    span<Vector3<float> const> const allPoints(points);
+    accumulator.add(allPoints.subspan(0, 10));
+    for (size_t i = 10; i < 20; ++i) {
+        accumulator.add(points[i]);
+    }
+    BoundsAccumulator<float> another;
+    another.add(allPoints.subspan(20));
+    accumulator.merge(another);
+
+    ASSERT_EQ(accumulator.getNumberOfPoints(), 100);
+    assertBoundsEqual(Bounds3D<float>::fromPoints(points), accumulator.getBounds());
+
+    accumulator.reset();
+    ASSERT_EQ(accumulator.getNumberOfPoints(), 0);
+    ASSERT_TRUE(accumulator.isEmpty());
+    ASSERT_FALSE(accumulator.getBounds().isValid());
+}
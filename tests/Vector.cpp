@@ -261,4 +261,85 @@ TEST(Vector, AddressOfProxies) {
     ASSERT_TRUE(v1.y == 20);
     ASSERT_TRUE(v1.z == 30);
 
-}
\ No newline at end of file
+}
+TEST(Vector, ExpressionEvaluation) {
+    Vector3<float> a{1, 2, 3}, b{4, 5, 6}, c{7, 8, 9};
+    Vector3<float> result = a + 2.f * b - c / 2 + -a;
+    ASSERT_FLOAT_EQ(result.x, 1 + 8 - 3.5f - 1);
+    ASSERT_FLOAT_EQ(result.y, 2 + 10 - 4 - 2);
+    ASSERT_FLOAT_EQ(result.z, 3 + 12 - 4.5f - 3);
+
+    // Assigning an expression to a vector that is one of its operands reads each element before it is written
+    a = a + b;
+    ASSERT_FLOAT_EQ(a.x, 5);
+    ASSERT_FLOAT_EQ(a.z, 9);
+}
+
+TEST(Vector, ExpressionIsLazy) {
+    Vector3<double> a{1, 1, 1}, b{2, 2, 2};
+    auto sum = a + b;
+    static_assert(!std::is_same_v<decltype(sum), Vector3<double>>);
+    a.x = 10;
+    ASSERT_DOUBLE_EQ(sum.eval().x, 12);
+    ASSERT_DOUBLE_EQ(sum[1], 3);
+}
+
+TEST(Vector, ExpressionHoldsTemporaries) {
+    Vector3<double> a{1, 2, 3};
+    auto expression = (a + Vector3<double>{1, 1, 1}) * 2 - Vector3<double>{0, 0, 1};
+    Vector3<double> result = expression;
+    ASSERT_DOUBLE_EQ(result.x, 4);
+    ASSERT_DOUBLE_EQ(result.y, 6);
+    ASSERT_DOUBLE_EQ(result.z, 7);
+}
+
+TEST(Vector, ExpressionDotAndLength) {
+    Vector3<double> a{1, 0, 0}, b{0, 3, 4};
+    ASSERT_DOUBLE_EQ(a.dot(a + b), 1);
+    ASSERT_DOUBLE_EQ((a + b).dot(a - b), 1 - 25);
+    ASSERT_DOUBLE_EQ((b - a).length(), sqrt(26));
+    ASSERT_DOUBLE_EQ((2.0 * b).normalize().z, 0.8);
+    Vector3<double> cross = (a + b) * (a - b);
+    ASSERT_DOUBLE_EQ(cross.dot(a + b), 0);
+}
+
+TEST(Vector, ExpressionConversion) {
+    Vector3<double> a{1.5, 2.5, 3.5};
+    Vector3<float> halved = a * 0.5;
+    ASSERT_FLOAT_EQ(halved.x, 0.75f);
+    ASSERT_FLOAT_EQ(halved.z, 1.75f);
+}
+
+TEST(Vector, CheckedAccess) {
+    Vector3<float> v{1, 2, 3};
+    v.at(1) = 20;
+    ASSERT_FLOAT_EQ(v.at(1), 20);
+    ASSERT_FLOAT_EQ(v[1], 20);
+    std::string errorMessage;
+    ASSERT_THROW({
+        try {
+            v.at(3) = 10;
+        } catch (std::invalid_argument& ex) {
+            errorMessage = ex.what();
+            throw;
+        }
+    }, std::invalid_argument);
+    ASSERT_EQ(errorMessage, "3 is out of bounds. Vector dimension is 3");
+#ifdef MATH3D_BOUNDS_CHECKS
+    ASSERT_THROW(v[3], std::invalid_argument);
+#endif
+}
+
+TEST(Vector, ConstantExpressions) {
+    constexpr Vector3<double> xAxis{1, 0, 0};
+    constexpr Vector3<double> yAxis{0, 1, 0};
+    constexpr Vector3<double> zAxis = xAxis * yAxis;
+    static_assert(zAxis[0] == 0 && zAxis[1] == 0 && zAxis[2] == 1);
+    constexpr Vector3<double> combination = xAxis + 2.0 * yAxis - zAxis / 2;
+    static_assert(combination[1] == 2 && combination[2] == -0.5);
+    static_assert(xAxis.dot(yAxis) == 0);
+    static_assert((xAxis + yAxis).lengthSquared() == 2);
+    constexpr Vector4<float> homogeneous(Vector3<float>{1, 2, 3}, 1);
+    static_assert(homogeneous[3] == 1);
+    ASSERT_DOUBLE_EQ(zAxis.z, 1);
+}
@@ -1,6 +1,7 @@
 #include "gtest/gtest.h"
 #include "3dmath/Vector.h"
 #include <vector>
+#include <cstring>
 using namespace std;
 using namespace math3d;
 
@@ -38,16 +39,10 @@ TEST(VectorConvenienceMembers, MoveConstruction) {
     ASSERT_FLOAT_EQ(v1.x, 10);
     ASSERT_FLOAT_EQ(v1.y, 20);
     ASSERT_FLOAT_EQ(v1.z, 30);
-    std::string exceptionMessage;
-    ASSERT_THROW({
-                     try {
-                         v.x = 100.f;
-                     } catch(std::runtime_error& ex) {
-                         exceptionMessage = ex.what();
-                         throw ex;
-                     }
-                 }, std::runtime_error) << "Expected an invalid access exception";
-    ASSERT_EQ(exceptionMessage, "Invalid access!");
+    // Vectors are trivially copyable, so the moved-from vector remains usable and independent of v1
+    v.x = 100.f;
+    ASSERT_FLOAT_EQ(v.x, 100);
+    ASSERT_FLOAT_EQ(v1.x, 10);
 }
 
 TEST(VectorConvenienceMembers, MoveAssignment) {
@@ -57,16 +52,10 @@ TEST(VectorConvenienceMembers, MoveAssignment) {
     ASSERT_FLOAT_EQ(v1.x, 10);
     ASSERT_FLOAT_EQ(v1.y, 20);
     ASSERT_FLOAT_EQ(v1.z, 30);
-    std::string exceptionMessage;
-    ASSERT_THROW({
-                     try {
-                         v.x = 100.f;
-                     } catch(std::runtime_error& ex) {
-                         exceptionMessage = ex.what();
-                         throw ex;
-                     }
-                 }, std::runtime_error) << "Expected an invalid access exception";
-    ASSERT_EQ(exceptionMessage, "Invalid access!");
+    // Vectors are trivially copyable, so the moved-from vector remains usable and independent of v1
+    v.x = 100.f;
+    ASSERT_FLOAT_EQ(v.x, 100);
+    ASSERT_FLOAT_EQ(v1.x, 10);
 }
 
 TEST(VectorConvenienceMembers, AddAssignmentOperator) {
@@ -103,4 +92,35 @@ TEST(VectorConvenienceMembers, DivideAssignmentOperator) {
     Vector3<float> v1;
     v1.x /= v.x;
     ASSERT_FLOAT_EQ(v1.x, 0);
-}
\ No newline at end of file
+}
+
+TEST(VectorConvenienceMembers, ColorMembers) {
+    Vector4<float> color{0.1f, 0.2f, 0.3f, 1.f};
+    ASSERT_FLOAT_EQ(color.r, 0.1f);
+    ASSERT_FLOAT_EQ(color.g, 0.2f);
+    ASSERT_FLOAT_EQ(color.b, 0.3f);
+    ASSERT_FLOAT_EQ(color.a, 1.f);
+    color.g = 0.5f;
+    ASSERT_FLOAT_EQ(color.y, 0.5f);
+    ASSERT_EQ(&color.r, &color.x);
+    ASSERT_EQ(&color.a, &color[3]);
+}
+
+TEST(VectorConvenienceMembers, Layout) {
+    static_assert(sizeof(Vector2<float>) == 2 * sizeof(float));
+    static_assert(sizeof(Vector3<float>) == 12);
+    static_assert(sizeof(Vector4<double>) == 4 * sizeof(double));
+    static_assert(sizeof(Vector<float, 10>) == 10 * sizeof(float));
+    static_assert(std::is_trivially_copyable_v<Vector4<double>>);
+    static_assert(std::is_standard_layout_v<Vector4<double>>);
+
+    // Contiguous arrays of vectors can be copied and reinterpreted as flat arrays of elements
+    std::vector<Vector3<float>> points {{1, 2, 3}, {4, 5, 6}};
+    std::vector<Vector3<float>> copies(points.size());
+    memcpy(copies.data(), points.data(), points.size() * sizeof(Vector3<float>));
+    auto const* elements = reinterpret_cast<float const*>(copies.data());
+    for (auto i = 0u; i < 6; ++i) {
+        ASSERT_FLOAT_EQ(elements[i], static_cast<float>(i + 1));
+    }
+    ASSERT_FLOAT_EQ(copies[1].y, 5);
+}